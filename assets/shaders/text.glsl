@@ -17,7 +17,9 @@ layout(location = 0) in vec2 v_position;
 layout(location = 1) in float v_depth;
 layout(location = 2) in float v_opacity;
 layout(location = 3) in vec2 v_uv;
+layout(location = 8) in vec4 v_color;
 layout(location = 0) out vec2 f_uv;
+layout(location = 1) out vec4 f_color;
 
 void main() {
     mat3 mvp = object.transform * camera.view_projection;
@@ -25,6 +27,7 @@ void main() {
     float depth = (object.depth - object.depth_min) / (object.depth_max - object.depth_min);
     gl_Position = vec4(screen_pos.xy, 1.0f - depth, 1.0);
     f_uv = v_uv;
+    f_color = v_color;
 }
 
 //@ END
@@ -46,9 +49,11 @@ layout(set = 5, binding = 0) uniform FragmentUserBuffer {
 layout(set = 6, binding = 0) uniform sampler2D mainTexture;
 
 layout(location = 0) in vec2 f_uv;
+layout(location = 1) in vec4 f_color;
 layout(location = 0) out vec4 FragColor;
 
 void main() {
+    vec4 color = color_buffer.color * f_color;
     float distance = texture(mainTexture, f_uv).r;
     float width = fwidth(distance);
     float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
@@ -56,12 +61,12 @@ void main() {
         vec4 outline_color = text_buffer.outline_color;
         float outline_threshold = 0.5 - text_buffer.outline_width;
         float outline_alpha = smoothstep(outline_threshold - width, outline_threshold + width, distance);
-        vec3 final_color = mix(outline_color.rgb, color_buffer.color.rgb, alpha);
-        float final_alpha = max(outline_alpha * outline_color.a, alpha * color_buffer.color.a);
+        vec3 final_color = mix(outline_color.rgb, color.rgb, alpha);
+        float final_alpha = max(outline_alpha * outline_color.a, alpha * color.a);
         FragColor = vec4(final_color * final_alpha, final_alpha);
     } else {
-        float final_alpha = alpha * color_buffer.color.a;
-        FragColor = vec4(color_buffer.color.rgb * final_alpha, final_alpha);
+        float final_alpha = alpha * color.a;
+        FragColor = vec4(color.rgb * final_alpha, final_alpha);
     }
 }
 
@@ -19,14 +19,27 @@ layout(location = 1) in float v_depth;
 layout(location = 2) in float v_opacity;
 layout(location = 3) in vec2 v_uv;
 
+// Per instance data
+layout(location = 9) in vec3 i_transform0;
+layout(location = 10) in vec3 i_transform1;
+layout(location = 11) in vec3 i_transform2;
+layout(location = 12) in vec3 i_params;
+layout(location = 13) in vec4 i_color;
+layout(location = 14) in vec4 i_emission;
+
 layout(location = 0) out vec2 f_uv;
+layout(location = 1) out vec4 f_color;
+layout(location = 2) out vec4 f_emission;
 
 void main() {
-    mat3 mvp = object.transform * camera.view_projection;
+    mat3 transform = transpose(mat3(i_transform0, i_transform1, i_transform2));
+    mat3 mvp = transform * camera.view_projection;
     vec3 screen_pos = vec3(v_position, 1.0) * mvp;
-    float depth = (object.depth + (v_depth * object.depth_scale) - object.depth_min) / (object.depth_max - object.depth_min);
+    float depth = (i_params.x + (v_depth * object.depth_scale) - object.depth_min) / (object.depth_max - object.depth_min);
     gl_Position = vec4(screen_pos.xy, 1.0f - depth, 1.0);
-    f_uv = v_uv;
+    f_uv = v_uv + i_params.yz;
+    f_color = i_color;
+    f_emission = i_emission;
 }
 
 //@ END
@@ -34,21 +47,15 @@ void main() {
 //@ FRAGMENT
 
 layout(location = 0) in vec2 f_uv;
+layout(location = 1) in vec4 f_color;
+layout(location = 2) in vec4 f_emission;
 layout(location = 0) out vec4 outColor;
 
-layout(set = 4, binding = 0) uniform ColorBuffer {
-    vec4 color;
-    vec4 emission;
-    vec2 uv_offset;
-    vec2 padding;
-} color_buffer;
-
 layout(set = 6, binding = 0) uniform sampler2D mainTexture;
 
 void main() {
-    vec4 diffuse = texture(mainTexture, f_uv + color_buffer.uv_offset) * color_buffer.color;
-    outColor = vec4(mix(diffuse.rgb, color_buffer.emission.rgb, color_buffer.emission.a), diffuse.a);
+    vec4 diffuse = texture(mainTexture, f_uv) * f_color;
+    outColor = vec4(mix(diffuse.rgb, f_emission.rgb, f_emission.a), diffuse.a);
 }
 
 //@ END
-
@@ -358,16 +358,132 @@ static AnimationData* LoadAnimationData(const std::filesystem::path& path) {
     return n;
 }
 
-static void SerializeTransform(Stream* stream, const Transform& transform) {
-    BoneTransform bone_transform = {
+static BoneTransform ToBoneTransform(const Transform& transform) {
+    return {
         .position = transform.position,
         .scale = transform.scale,
         .rotation = transform.rotation,
     };
-    WriteStruct(stream, bone_transform);
 }
 
-void Serialize(AnimationData* n, Stream* stream, SkeletonData* s) {
+struct AnimationTrackData {
+    float min;
+    float scale;
+    int key_offset;
+    int key_count;
+};
+
+// Quantize a channel to 16 bits over its range and keep only the keys that linear
+// interpolation between their neighbours cannot rebuild within the tolerance.  Keys are
+// checked against their quantized values so the error bound holds for what the runtime sees.
+static AnimationTrackData CompressTrack(const float* values, int stride, int count, float tolerance, std::vector<u8>& key_frames, std::vector<u16>& key_values) {
+    float min_value = values[0];
+    float max_value = values[0];
+    for (int i=1; i<count; i++) {
+        min_value = Min(min_value, values[i * stride]);
+        max_value = Max(max_value, values[i * stride]);
+    }
+
+    AnimationTrackData track = {};
+    if (max_value - min_value <= tolerance) {
+        track.min = (min_value + max_value) * 0.5f;
+        return track;
+    }
+
+    track.min = min_value;
+    track.scale = (max_value - min_value) / static_cast<float>(U16_MAX);
+    track.key_offset = static_cast<int>(key_frames.size());
+
+    std::vector<u16> quantized(count);
+    for (int i=0; i<count; i++)
+        quantized[i] = static_cast<u16>(Clamp(std::round((values[i * stride] - min_value) / track.scale), 0.0f, static_cast<float>(U16_MAX)));
+
+    auto fits = [&](int key0, int key1) {
+        for (int i=key0 + 1; i<key1; i++) {
+            float t = static_cast<float>(i - key0) / static_cast<float>(key1 - key0);
+            float q = quantized[key0] + (static_cast<float>(quantized[key1]) - quantized[key0]) * t;
+            if (Abs(track.min + q * track.scale - values[i * stride]) > tolerance)
+                return false;
+        }
+        return true;
+    };
+
+    int key = 0;
+    key_frames.push_back(0);
+    key_values.push_back(quantized[0]);
+    while (key < count - 1) {
+        int next = key + 1;
+        while (next + 1 < count && fits(key, next + 1))
+            next++;
+
+        key_frames.push_back(static_cast<u8>(next));
+        key_values.push_back(quantized[next]);
+        key = next;
+    }
+
+    track.key_count = static_cast<int>(key_frames.size()) - track.key_offset;
+    return track;
+}
+
+// 16 bit quantization alone rounds each key by up to half a step of the channel range, so
+// channels whose range is too wide for the tolerance cannot be compressed at all
+static bool CanQuantizeTrack(const float* values, int stride, int count, float tolerance) {
+    float min_value = values[0];
+    float max_value = values[0];
+    for (int i=1; i<count; i++) {
+        min_value = Min(min_value, values[i * stride]);
+        max_value = Max(max_value, values[i * stride]);
+    }
+
+    return (max_value - min_value) / static_cast<float>(U16_MAX) * 0.5f <= tolerance;
+}
+
+static bool CanQuantizeTracks(const BoneTransform* transforms, int transform_count, int bone_count, float tolerance) {
+    int stride = bone_count * (sizeof(BoneTransform) / sizeof(float));
+    for (int bone_index=0; bone_index<bone_count; bone_index++) {
+        const BoneTransform& bt = transforms[bone_index];
+        if (!CanQuantizeTrack(&bt.position.x, stride, transform_count, tolerance) ||
+            !CanQuantizeTrack(&bt.position.y, stride, transform_count, tolerance) ||
+            !CanQuantizeTrack(&bt.scale.x, stride, transform_count, tolerance) ||
+            !CanQuantizeTrack(&bt.scale.y, stride, transform_count, tolerance) ||
+            !CanQuantizeTrack(&bt.rotation, stride, transform_count, tolerance * noz::RAD_TO_DEG))
+            return false;
+    }
+
+    return true;
+}
+
+static void WriteTracks(Stream* stream, const BoneTransform* transforms, int transform_count, int bone_count, float tolerance) {
+    std::vector<AnimationTrackData> tracks;
+    std::vector<u8> key_frames;
+    std::vector<u16> key_values;
+    int stride = bone_count * (sizeof(BoneTransform) / sizeof(float));
+    for (int bone_index=0; bone_index<bone_count; bone_index++) {
+        const BoneTransform& bt = transforms[bone_index];
+        tracks.push_back(CompressTrack(&bt.position.x, stride, transform_count, tolerance, key_frames, key_values));
+        tracks.push_back(CompressTrack(&bt.position.y, stride, transform_count, tolerance, key_frames, key_values));
+        tracks.push_back(CompressTrack(&bt.scale.x, stride, transform_count, tolerance, key_frames, key_values));
+        tracks.push_back(CompressTrack(&bt.scale.y, stride, transform_count, tolerance, key_frames, key_values));
+
+        // Rotation is in degrees, treat the tolerance as radians so it means the same arc
+        tracks.push_back(CompressTrack(&bt.rotation, stride, transform_count, tolerance * noz::RAD_TO_DEG, key_frames, key_values));
+    }
+
+    WriteU32(stream, static_cast<u32>(key_frames.size()));
+    for (const AnimationTrackData& track : tracks) {
+        WriteU8(stream, static_cast<u8>(track.key_count));
+        WriteFloat(stream, track.min);
+        if (track.key_count == 0)
+            continue;
+
+        WriteFloat(stream, track.scale);
+        WriteBytes(stream, key_frames.data() + track.key_offset, track.key_count);
+        for (int key_index=0; key_index<track.key_count; key_index++)
+            WriteU16(stream, key_values[track.key_offset + key_index]);
+    }
+}
+
+void Serialize(AnimationData* n, Stream* stream, SkeletonData* s, bool compress, float tolerance) {
     assert(s);
     AnimationDataImpl* impl = n->impl;
     SkeletonDataImpl* skelimpl = s->impl;
@@ -381,17 +497,9 @@ void Serialize(AnimationData* n, Stream* stream, SkeletonData* s) {
     bool looping = (impl->flags & ANIMATION_FLAG_LOOPING) != 0;
     int real_frame_count = GetFrameCountWithHolds(n);
 
-    WriteU8(stream, (u8)skelimpl->bone_count);
-    WriteU8(stream, (u8)impl->frame_count);
-    WriteU8(stream, (u8)real_frame_count);
-    WriteU8(stream, (u8)g_config->GetInt("animation", "frame_rate", ANIMATION_FRAME_RATE));
-    WriteU8(stream, (u8)impl->flags);
-
-    // todo: do we need this?
-    for (int i=0; i<skelimpl->bone_count; i++)
-        WriteU8(stream, (u8)impl->bones[i].index);
-
     // frame transforms (write absolute: bind pose + frame delta)
+    std::vector<BoneTransform> transforms;
+    transforms.reserve(impl->frame_count * skelimpl->bone_count);
     for (int frame_index=0; frame_index<impl->frame_count; frame_index++) {
         AnimationFrameData& f = impl->frames[frame_index];
 
@@ -399,17 +507,37 @@ void Serialize(AnimationData* n, Stream* stream, SkeletonData* s) {
         Transform transform = f.transforms[0];
         transform.position = VEC2_ZERO;
         transform.rotation += skelimpl->bones[0].transform.rotation;
-        SerializeTransform(stream, transform);
+        transforms.push_back(ToBoneTransform(transform));
 
         for (int bone_index=1; bone_index<skelimpl->bone_count; bone_index++) {
             BoneTransform& bind = skelimpl->bones[bone_index].transform;
             Transform abs_transform = f.transforms[bone_index];
             abs_transform.position = bind.position + abs_transform.position;
             abs_transform.rotation = bind.rotation + abs_transform.rotation;
-            SerializeTransform(stream, abs_transform);
+            transforms.push_back(ToBoneTransform(abs_transform));
         }
     }
 
+    if (compress && !CanQuantizeTracks(transforms.data(), impl->frame_count, skelimpl->bone_count, tolerance)) {
+        LogWarning("animation '%s' exceeds the compression tolerance at 16 bits, writing raw transforms", n->name->value);
+        compress = false;
+    }
+
+    WriteU8(stream, (u8)skelimpl->bone_count);
+    WriteU8(stream, (u8)impl->frame_count);
+    WriteU8(stream, (u8)real_frame_count);
+    WriteU8(stream, (u8)g_config->GetInt("animation", "frame_rate", ANIMATION_FRAME_RATE));
+    WriteU8(stream, (u8)(impl->flags | (compress ? ANIMATION_FLAG_COMPRESSED : ANIMATION_FLAG_NONE)));
+
+    // todo: do we need this?
+    for (int i=0; i<skelimpl->bone_count; i++)
+        WriteU8(stream, (u8)impl->bones[i].index);
+
+    if (compress)
+        WriteTracks(stream, transforms.data(), impl->frame_count, skelimpl->bone_count, tolerance);
+    else
+        WriteBytes(stream, transforms.data(), static_cast<u32>(sizeof(BoneTransform) * transforms.size()));
+
     float base_root_motion = impl->frames[0].transforms[0].position.x;
 
     // frames
@@ -46,7 +46,9 @@ extern void InitAnimationData(AssetData* a);
 extern AssetData* NewAnimationData(const std::filesystem::path& path);
 extern void PostLoadEditorAssets(AnimationData* n);
 extern void UpdateBounds(AnimationData* n);
-extern void Serialize(AnimationData* n, Stream* stream, SkeletonData* s);
+constexpr float ANIMATION_COMPRESS_TOLERANCE = 0.001f;
+
+extern void Serialize(AnimationData* n, Stream* stream, SkeletonData* s, bool compress=false, float tolerance=ANIMATION_COMPRESS_TOLERANCE);
 extern Animation* ToAnimation(Allocator* allocator, AnimationData* n);
 extern int InsertFrame(AnimationData* n, int insert_at);
 extern int DeleteFrame(AnimationData* n, int frame_index);
@@ -51,40 +51,301 @@ static bool CollectBuildAsset(u32, void* item_data, void* user_data) {
     return true;
 }
 
-static void WriteBuildAsset(FILE* file, AssetData* a, const char* extension, const char* suffix) {
-    std::string type_upper = ToString(a->type);
-    Upper(type_upper.data(), (u32)type_upper.size());
-
-    std::string name_upper = a->name->value;
-    Upper(name_upper.data(), (u32)name_upper.size());
+struct BuildPackEntry {
+    AssetPackEntry entry;
+    AssetData* asset;
+    std::vector<u8> data;
+};
 
-    std::string suffix_upper;
-    if (suffix) {
-        suffix_upper = suffix;
-        Upper(suffix_upper.data(), (u32)suffix_upper.size());
+// Compression is opt in per asset through [build] compress in its meta file, with the project
+// config as the default, and only kept when it actually shrinks the payload.  Compressed assets
+// lose the in place loading of the embedded pack so it suits large, rarely loaded assets best.
+static bool IsCompressedInPack(AssetData* a) {
+    bool compress = g_config->GetBool("build", "compress", false);
+    if (Props* meta = LoadProps(fs::path(std::string(a->path) + ".meta"))) {
+        compress = meta->GetBool("build", "compress", compress);
+        delete meta;
     }
 
-    fprintf(file, "static u8 %s_%s%s_DATA[] = {", type_upper.c_str(), name_upper.c_str(), suffix_upper.c_str());
+    return compress;
+}
 
+static void AddPackAsset(std::vector<BuildPackEntry>& entries, AssetData* a, const char* extension, bool compress) {
     fs::path asset_path = GetTargetPath(a);
     if (extension)
         asset_path += extension;
 
-    FILE* asset_file = fopen(asset_path.string().c_str(), "rb");
-    if (asset_file) {
-        char buffer[1024];
-        size_t bytes_read;
-        bool first = true;
-        while ((bytes_read = fread(buffer, 1, sizeof(buffer), asset_file)) > 0) {
-            for (size_t i = 0; i < bytes_read; i++) {
-                fprintf(file, first ? "%u" : ",%u", static_cast<unsigned char>(buffer[i]));
-                first = false;
-            }
+    std::error_code ec;
+    if (!fs::is_regular_file(asset_path, ec))
+        return;
+
+    Stream* stream = LoadStream(ALLOCATOR_DEFAULT, asset_path);
+    if (!stream)
+        return;
+
+    BuildPackEntry& pack_entry = entries.emplace_back();
+    pack_entry.entry.name_hash = GetAssetPackHash(a->name->value, extension);
+    pack_entry.entry.type = static_cast<u32>(a->type);
+    pack_entry.asset = a;
+
+    const u8* data = GetData(stream);
+    u32 size = GetSize(stream);
+    pack_entry.data.assign(data, data + size);
+
+    if (compress) {
+        std::vector<u8> compressed(GetMaxCompressedSize(size));
+        u32 compressed_size = Compress(data, size, compressed.data(), static_cast<u32>(compressed.size()));
+        if (compressed_size != COMPRESS_FAILED && compressed_size < size) {
+            compressed.resize(compressed_size);
+            pack_entry.data = std::move(compressed);
+            pack_entry.entry.raw_size = size;
         }
-        fclose(asset_file);
     }
 
-    fprintf(file, "};\n\n");
+    Free(stream);
+}
+
+// Every built asset in one file the runtime can map, see AssetPackHeader for the layout
+static u32 WriteAssetPack(std::vector<BuildPackEntry>& entries, const fs::path& path) {
+    std::sort(entries.begin(), entries.end(), [](const BuildPackEntry& a, const BuildPackEntry& b) {
+        return a.entry < b.entry;
+    });
+
+    u32 offset = sizeof(AssetPackHeader) + static_cast<u32>(entries.size() * sizeof(AssetPackEntry));
+    for (BuildPackEntry& pack_entry : entries) {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) & ~(ASSET_PACK_ALIGNMENT - 1);
+        pack_entry.entry.offset = offset;
+        pack_entry.entry.size = static_cast<u32>(pack_entry.data.size());
+        offset += pack_entry.entry.size;
+    }
+
+    Stream* stream = CreateStream(ALLOCATOR_DEFAULT, offset);
+    AssetPackHeader header = {
+        .signature = ASSET_PACK_SIGNATURE,
+        .version = ASSET_PACK_VERSION,
+        .entry_count = static_cast<u32>(entries.size()),
+    };
+    WriteStruct(stream, header);
+    for (const BuildPackEntry& pack_entry : entries)
+        WriteStruct(stream, pack_entry.entry);
+
+    for (const BuildPackEntry& pack_entry : entries) {
+        while (GetPosition(stream) < pack_entry.entry.offset)
+            WriteU8(stream, 0);
+
+        WriteBytes(stream, pack_entry.data.data(), pack_entry.entry.size);
+    }
+
+    SaveStream(stream, path);
+    Free(stream);
+
+    return offset;
+}
+
+constexpr const char* ASSET_PACK_SYMBOL = "noz_asset_pack_data";
+
+struct CoffMachine {
+    const char* name;
+    const char* define;
+    u16 machine;
+};
+
+// Windows targets that get a linked pack, anything else falls back to the word array
+static const CoffMachine COFF_MACHINES[] = {
+    { "x64", "_M_X64", 0x8664 },
+    { "arm64", "_M_ARM64", 0xaa64 },
+};
+
+static void WriteU32BE(Stream* stream, u32 value) {
+    u8 bytes[] = { static_cast<u8>(value >> 24), static_cast<u8>(value >> 16), static_cast<u8>(value >> 8), static_cast<u8>(value) };
+    WriteBytes(stream, bytes, sizeof(bytes));
+}
+
+static void WriteArchiveMemberHeader(Stream* stream, const char* name, u32 size) {
+    WriteCSTR(stream, "%-16s%-12s%-6s%-6s%-8s%-10u`\n", name, "0", "", "", "644", size);
+}
+
+// One section object defining ASSET_PACK_SYMBOL over the whole pack
+static void WriteCoffObject(Stream* stream, u16 machine, const u8* data, u32 size) {
+    constexpr u32 IMAGE_SCN_CNT_INITIALIZED_DATA = 0x00000040;
+    constexpr u32 IMAGE_SCN_ALIGN_16BYTES = 0x00500000;
+    constexpr u32 IMAGE_SCN_MEM_READ = 0x40000000;
+    constexpr u32 HEADERS_SIZE = 20 + 40;
+    u32 symbol_size = static_cast<u32>(strlen(ASSET_PACK_SYMBOL)) + 1;
+
+    // File header
+    WriteU16(stream, machine);
+    WriteU16(stream, 1);
+    WriteU32(stream, 0);
+    WriteU32(stream, HEADERS_SIZE + size);
+    WriteU32(stream, 1);
+    WriteU16(stream, 0);
+    WriteU16(stream, 0);
+
+    // Section header
+    WriteBytes(stream, ".rdata\0\0", 8);
+    WriteU32(stream, 0);
+    WriteU32(stream, 0);
+    WriteU32(stream, size);
+    WriteU32(stream, HEADERS_SIZE);
+    WriteU32(stream, 0);
+    WriteU32(stream, 0);
+    WriteU16(stream, 0);
+    WriteU16(stream, 0);
+    WriteU32(stream, IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_ALIGN_16BYTES | IMAGE_SCN_MEM_READ);
+
+    WriteBytes(stream, data, size);
+
+    // External symbol at the start of section 1, its name lives in the string table
+    WriteU32(stream, 0);
+    WriteU32(stream, 4);
+    WriteU32(stream, 0);
+    WriteI16(stream, 1);
+    WriteU16(stream, 0);
+    WriteU8(stream, 2);
+    WriteU8(stream, 0);
+
+    WriteU32(stream, 4 + symbol_size);
+    WriteBytes(stream, ASSET_PACK_SYMBOL, symbol_size);
+}
+
+// The object is wrapped in a library so the generated source can pull it in with
+// #pragma comment(lib), both linker members index the one symbol it defines.
+static void WriteCoffArchive(const fs::path& path, u16 machine, const u8* data, u32 size) {
+    Stream* object = CreateStream(ALLOCATOR_DEFAULT, size + 128);
+    WriteCoffObject(object, machine, data, size);
+
+    u32 symbol_size = static_cast<u32>(strlen(ASSET_PACK_SYMBOL)) + 1;
+    u32 first_size = 4 + 4 + symbol_size;
+    u32 second_size = 4 + 4 + 4 + 2 + symbol_size;
+    u32 object_offset = 8 + 60 + ((first_size + 1) & ~1u) + 60 + ((second_size + 1) & ~1u);
+
+    Stream* stream = CreateStream(ALLOCATOR_DEFAULT, object_offset + 60 + GetSize(object) + 1);
+    WriteBytes(stream, "!<arch>\n", 8);
+
+    WriteArchiveMemberHeader(stream, "/", first_size);
+    WriteU32BE(stream, 1);
+    WriteU32BE(stream, object_offset);
+    WriteBytes(stream, ASSET_PACK_SYMBOL, symbol_size);
+    if (first_size & 1) WriteU8(stream, '\n');
+
+    WriteArchiveMemberHeader(stream, "/", second_size);
+    WriteU32(stream, 1);
+    WriteU32(stream, object_offset);
+    WriteU32(stream, 1);
+    WriteU16(stream, 1);
+    WriteBytes(stream, ASSET_PACK_SYMBOL, symbol_size);
+    if (second_size & 1) WriteU8(stream, '\n');
+
+    assert(GetPosition(stream) == object_offset);
+    WriteArchiveMemberHeader(stream, "assets.obj/", GetSize(object));
+    WriteBytes(stream, GetData(object), GetSize(object));
+    if (GetSize(object) & 1) WriteU8(stream, '\n');
+
+    SaveStream(stream, path);
+    Free(stream);
+    Free(object);
+}
+
+// Web builds assemble this next to the build source, emcc has no other way to link a file in whole
+static void WriteWasmAssembly(const fs::path& path, const fs::path& pack_path, u32 pack_size) {
+    FILE* file = fopen(path.string().c_str(), "wt");
+    if (!file) {
+        LogError("failed to write '%s'", path.string().c_str());
+        return;
+    }
+
+    fprintf(file, "#if defined(__EMSCRIPTEN__) && !defined(DEBUG)\n\n");
+    fprintf(file, "    .section .rodata.%s,\"\",@\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "    .p2align 4\n");
+    fprintf(file, "    .globl %s\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "    .type %s,@object\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "%s:\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "    .incbin \"%s\"\n", fs::absolute(pack_path).generic_string().c_str());
+    fprintf(file, "    .size %s, %u\n\n", ASSET_PACK_SYMBOL, pack_size);
+    fprintf(file, "#endif\n");
+    fclose(file);
+}
+
+// The pack is linked in whole rather than compiled.  MSVC links a library written here through
+// #pragma comment(lib), web builds assemble the generated .S and everything else uses .incbin in
+// place.  Other Windows toolchains still get the pack as 64 bit words.
+static void WriteAssetPackData(FILE* file, const fs::path& pack_path, const fs::path& assembly_path, u32 pack_size) {
+    Stream* stream = LoadStream(ALLOCATOR_DEFAULT, pack_path);
+    const u8* data = stream ? GetData(stream) : nullptr;
+    u32 size = stream ? GetSize(stream) : 0;
+
+    fprintf(file, "// @pack\n");
+    fprintf(file, "constexpr u32 ASSET_PACK_DATA_SIZE = %u;\n\n", pack_size);
+
+    for (const CoffMachine& machine : COFF_MACHINES) {
+        fs::path library_path = pack_path;
+        library_path.replace_extension(std::string(".") + machine.name + ".lib");
+        WriteCoffArchive(library_path, machine.machine, data, size);
+
+        fprintf(file, "#%s defined(_MSC_VER) && defined(%s)\n\n", &machine == COFF_MACHINES ? "if" : "elif", machine.define);
+        fprintf(file, "#pragma comment(lib, \"%s\")\n", fs::absolute(library_path).generic_string().c_str());
+        fprintf(file, "extern \"C\" const u8 %s[];\n", ASSET_PACK_SYMBOL);
+        fprintf(file, "static const u8* const ASSET_PACK_DATA = %s;\n\n", ASSET_PACK_SYMBOL);
+    }
+
+    WriteWasmAssembly(assembly_path, pack_path, pack_size);
+
+    fprintf(file, "#elif defined(__EMSCRIPTEN__)\n\n");
+    fprintf(file, "// Defined by %s, add it to the web target sources\n", assembly_path.filename().string().c_str());
+    fprintf(file, "extern \"C\" const u8 %s[];\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "static const u8* const ASSET_PACK_DATA = %s;\n\n", ASSET_PACK_SYMBOL);
+
+    fprintf(file, "#elif defined(_WIN32)\n\n");
+    fprintf(file, "alignas(16) static const u64 ASSET_PACK_WORDS[] = {");
+    u32 word_count = (size + 7) / 8;
+    for (u32 i = 0; i < word_count; i++) {
+        u64 word = 0;
+        memcpy(&word, data + i * 8, Min(8u, size - i * 8));
+        fprintf(file, i % 8 == 0 ? "\n    0x%016llx," : " 0x%016llx,", static_cast<unsigned long long>(word));
+    }
+    Free(stream);
+
+    fprintf(file, "\n};\n");
+    fprintf(file, "static const u8* const ASSET_PACK_DATA = reinterpret_cast<const u8*>(ASSET_PACK_WORDS);\n\n");
+    fprintf(file, "#else\n\n");
+    fprintf(file, "extern \"C\" const u8 %s[] __asm__(\"%s\");\n", ASSET_PACK_SYMBOL, ASSET_PACK_SYMBOL);
+    fprintf(file, "__asm__(\n");
+    fprintf(file, "#if defined(__APPLE__)\n");
+    fprintf(file, "    \".pushsection __DATA,__const\\n\"\n");
+    fprintf(file, "#else\n");
+    fprintf(file, "    \".pushsection .rodata\\n\"\n");
+    fprintf(file, "#endif\n");
+    fprintf(file, "    \".balign 16\\n\"\n");
+    fprintf(file, "    \"%s:\\n\"\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "    \".incbin \\\"%s\\\"\\n\"\n", fs::absolute(pack_path).generic_string().c_str());
+    fprintf(file, "    \".popsection\\n\");\n");
+    fprintf(file, "static const u8* const ASSET_PACK_DATA = %s;\n\n", ASSET_PACK_SYMBOL);
+    fprintf(file, "#endif\n\n");
+}
+
+// Each asset gets a symbol into the embedded pack, compressed ones resolve through the
+// mounted pack at load time instead
+static void WriteBuildAsset(FILE* file, const std::vector<BuildPackEntry>& entries, AssetData* a, const char* extension) {
+    std::string type_upper = ToString(a->type);
+    Upper(type_upper.data(), (u32)type_upper.size());
+
+    std::string name_upper = a->name->value;
+    Upper(name_upper.data(), (u32)name_upper.size());
+
+    u64 name_hash = GetAssetPackHash(a->name->value, extension);
+    auto it = std::find_if(entries.begin(), entries.end(), [a, name_hash](const BuildPackEntry& pack_entry) {
+        return pack_entry.asset == a && pack_entry.entry.name_hash == name_hash;
+    });
+
+    if (it == entries.end() || it->entry.raw_size > 0) {
+        fprintf(file, "static const u8* const %s_%s_DATA = nullptr;\n", type_upper.c_str(), name_upper.c_str());
+        fprintf(file, "constexpr u32 %s_%s_DATA_SIZE = 0;\n\n", type_upper.c_str(), name_upper.c_str());
+        return;
+    }
+
+    fprintf(file, "static const u8* const %s_%s_DATA = ASSET_PACK_DATA + %u;\n", type_upper.c_str(), name_upper.c_str(), it->entry.offset);
+    fprintf(file, "constexpr u32 %s_%s_DATA_SIZE = %u;\n\n", type_upper.c_str(), name_upper.c_str(), it->entry.size);
 }
 
 void Build() {
@@ -96,11 +357,6 @@ void Build() {
     fs::path header_path = manifest_path.filename();
     header_path.replace_extension(".h");
 
-    FILE* file = fopen(build_path.string().c_str(), "wt");
-
-    fprintf(file, "#include \"%s\"\n\n", header_path.string().c_str());
-    fprintf(file, "#if !defined(DEBUG)\n\n");
-
     try
     {
         std::filesystem::create_directory(manifest_path.parent_path());
@@ -109,31 +365,56 @@ void Build() {
     {
     }
 
-    // Iterate over all asset types
+    // Collect unique assets for every type
+    BuildCollector collectors[ASSET_TYPE_COUNT];
+    std::vector<BuildPackEntry> pack_entries;
     for (int type = 0; type < ASSET_TYPE_COUNT; type++) {
-        AssetType asset_type = static_cast<AssetType>(type);
-
-        // Collect unique assets for this type
-        BuildCollector collector = { .type = asset_type };
+        BuildCollector& collector = collectors[type];
+        collector.type = static_cast<AssetType>(type);
         Enumerate(g_editor.asset_allocator, CollectBuildAsset, &collector);
 
-        if (asset_type == ASSET_TYPE_SHADER) {
+        for (auto& entry : collector.assets) {
+            bool compress = IsCompressedInPack(entry.asset);
+            AddPackAsset(pack_entries, entry.asset, nullptr, compress);
+            if (collector.type == ASSET_TYPE_SHADER) {
+                AddPackAsset(pack_entries, entry.asset, ".gles", compress);
+                AddPackAsset(pack_entries, entry.asset, ".glsl", compress);
+            }
+        }
+    }
+
+    fs::path pack_path = fs::path(g_editor.output_path) / ASSET_PACK_NAME;
+    u32 pack_size = WriteAssetPack(pack_entries, pack_path);
+
+    fs::path assembly_path = manifest_path;
+    assembly_path.replace_extension("");
+    assembly_path = assembly_path.string() + "_pack.S";
+
+    FILE* file = fopen(build_path.string().c_str(), "wt");
+
+    fprintf(file, "#include \"%s\"\n\n", header_path.string().c_str());
+    fprintf(file, "#if !defined(DEBUG)\n\n");
+
+    WriteAssetPackData(file, pack_path, assembly_path, pack_size);
+
+    for (BuildCollector& collector : collectors) {
+        if (collector.type == ASSET_TYPE_SHADER) {
             fprintf(file, "#ifdef NOZ_PLATFORM_GLES\n\n");
             for (auto& entry : collector.assets)
-                WriteBuildAsset(file, entry.asset, ".gles", nullptr);
+                WriteBuildAsset(file, pack_entries, entry.asset, ".gles");
 
             fprintf(file, "#elif NOZ_PLATFORM_GL\n\n");
             for (auto& entry : collector.assets)
-                WriteBuildAsset(file, entry.asset, ".glsl", nullptr);
+                WriteBuildAsset(file, pack_entries, entry.asset, ".glsl");
 
             fprintf(file, "#else\n\n");
             for (auto& entry : collector.assets)
-                WriteBuildAsset(file, entry.asset, nullptr, nullptr);
+                WriteBuildAsset(file, pack_entries, entry.asset, nullptr);
             fprintf(file, "#endif\n\n");
 
         } else {
             for (auto& entry : collector.assets)
-                WriteBuildAsset(file, entry.asset, nullptr, nullptr);
+                WriteBuildAsset(file, pack_entries, entry.asset, nullptr);
         }
     }
 
@@ -387,6 +387,7 @@ void Main() {
     ResolveAssetPaths();
 
     traits.asset_paths = g_editor.asset_paths;
+    traits.asset_pack = nullptr;    // Imported files change under the editor, always read them loose
     traits.load_assets = LoadAssets;
     traits.unload_assets = UnloadAssets;
     traits.hotload_asset = EditorHotLoad;
@@ -6,7 +6,6 @@ namespace fs = std::filesystem;
 
 static void ImportAnimation(AssetData* ea, const std::filesystem::path& path, Props* config, Props* meta) {
     (void)config;
-    (void)meta;
 
     assert(ea);
     assert(ea->type == ASSET_TYPE_ANIMATION);
@@ -16,8 +15,12 @@ static void ImportAnimation(AssetData* ea, const std::filesystem::path& path, Pr
     if (!es)
         ThrowError("invalid skeleton");
 
+    // Tolerance is in world units for position and scale and radians for rotation
+    bool compress = meta->GetBool("animation", "compress", false);
+    float tolerance = meta->GetFloat("animation", "compress_tolerance", ANIMATION_COMPRESS_TOLERANCE);
+
     Stream* stream = CreateStream(nullptr, 4096);
-    Serialize(en, stream, es);
+    Serialize(en, stream, es, compress, tolerance);
     SaveStream(stream, path);
     Free(stream);
 }
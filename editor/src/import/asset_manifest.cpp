@@ -279,7 +279,11 @@ static void GenerateCppSource(ManifestGenerator& generator) {
         "\n"
         "// @load\n"
         "bool LoadAssets(Allocator* allocator)\n"
-        "{\n");
+        "{\n"
+        "#if defined(NOZ_BUILTIN_ASSETS)\n"
+        "    MountAssetPack(ASSET_PACK_DATA, ASSET_PACK_DATA_SIZE);\n"
+        "#endif\n"
+        "\n");
 
     WriteCSTR(stream, "    // @name\n");
     for (auto& kv : sorted_names)
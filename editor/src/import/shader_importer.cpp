@@ -325,6 +325,9 @@ static void ImportShader(AssetData* a, const std::filesystem::path& path, Props*
     if (meta->GetBool("shader", "premultiplied", false))
         flags |= SHADER_FLAGS_PREMULTIPLIED_ALPHA;
 
+    if (meta->GetBool("shader", "instanced", false))
+        flags |= SHADER_FLAGS_INSTANCED;
+
 
     try {
         WriteSPIRV(path, vertex_shader, fragment_shader, include_dir, a->path.value, flags);
@@ -3,6 +3,7 @@
 //
 
 #include "asset_importer.h"
+#include "../utils/adpcm_encode.h"
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -71,9 +72,30 @@ bool ValidateWavDataChunk(const WavDataChunk* data)
     );
 }
 
+// Widen 8 or 16 bit PCM to the interleaved 16 bit samples that ADPCM and streaming expect
+static std::vector<i16> ConvertTo16(const std::vector<char>& data, u32 channels, u32 bits_per_sample) {
+    u32 sample_size = bits_per_sample / 8;
+    u32 frame_count = static_cast<u32>(data.size()) / (channels * sample_size);
+    std::vector<i16> samples(frame_count * channels);
+    for (u32 i = 0; i < frame_count * channels; i++) {
+        const u8* src = reinterpret_cast<const u8*>(data.data()) + i * sample_size;
+        if (bits_per_sample == 8)
+            samples[i] = static_cast<i16>((static_cast<i32>(src[0]) - 128) << 8);
+        else
+            samples[i] = static_cast<i16>(src[0] | (src[1] << 8));
+    }
+
+    return samples;
+}
+
 static void ImportSound(AssetData* ea, const fs::path& path, Props* config, Props* meta) {
     (void)config;
-    (void)meta;
+
+    std::string format = meta->GetString("sound", "format", "pcm");
+    bool adpcm = format == "adpcm";
+    bool streamed = meta->GetBool("sound", "stream", false);
+    if (!adpcm && format != "pcm")
+        throw std::runtime_error("Unknown sound format '" + format + "' (pcm or adpcm)");
     
     Stream* stream = CreateStream(nullptr,  4096);  
 
@@ -154,21 +176,6 @@ static void ImportSound(AssetData* ea, const fs::path& path, Props* config, Prop
         throw std::runtime_error("Unsupported bit depth (only 8-bit and 16-bit supported)");
     }
     
-    // Write NoZ sound asset header
-    AssetHeader asset_header = {};
-    asset_header.signature = ASSET_SIGNATURE;
-    asset_header.type = ASSET_TYPE_SOUND;
-    asset_header.version = 1;
-    asset_header.flags = 0;
-    
-    WriteAssetHeader(stream, &asset_header);
-    
-    // Write sound header
-    WriteU32(stream, fmt_chunk.sample_rate);
-    WriteU32(stream, fmt_chunk.num_channels);
-    WriteU32(stream, fmt_chunk.bits_per_sample);
-    WriteU32(stream, data_chunk.sub_chunk2_size);
-    
     // Copy audio data
     std::vector<char> audio_data(data_chunk.sub_chunk2_size);
     input_file.read(audio_data.data(), data_chunk.sub_chunk2_size);
@@ -177,9 +184,51 @@ static void ImportSound(AssetData* ea, const fs::path& path, Props* config, Prop
     {
         throw std::runtime_error("Failed to read complete audio data");
     }
+
+    // Write NoZ sound asset header
+    AssetHeader asset_header = {};
+    asset_header.signature = ASSET_SIGNATURE;
+    asset_header.type = ASSET_TYPE_SOUND;
+    asset_header.version = 1;
+    asset_header.flags = (adpcm ? SOUND_FLAG_ADPCM : 0) | (streamed ? SOUND_FLAG_STREAM : 0);
     
-    WriteBytes(stream, audio_data.data(), data_chunk.sub_chunk2_size);
-    
+    WriteAssetHeader(stream, &asset_header);
+
+    // Streamed and ADPCM sounds are stored as 16 bit, everything else as the source PCM
+    if (adpcm || streamed)
+    {
+        u32 channels = fmt_chunk.num_channels;
+        std::vector<i16> samples = ConvertTo16(audio_data, channels, fmt_chunk.bits_per_sample);
+        u32 frame_count = static_cast<u32>(samples.size()) / channels;
+
+        WriteU32(stream, fmt_chunk.sample_rate);
+        WriteU32(stream, channels);
+        WriteU32(stream, 16);
+
+        if (adpcm)
+        {
+            std::vector<u8> encoded(GetAdpcmEncodedSize(frame_count, channels));
+            EncodeAdpcm(samples.data(), frame_count, encoded.data(), channels);
+            WriteU32(stream, static_cast<u32>(encoded.size()));
+            WriteU32(stream, frame_count);
+            WriteBytes(stream, encoded.data(), static_cast<u32>(encoded.size()));
+        }
+        else
+        {
+            u32 data_size = static_cast<u32>(samples.size() * sizeof(i16));
+            WriteU32(stream, data_size);
+            WriteBytes(stream, samples.data(), data_size);
+        }
+    }
+    else
+    {
+        WriteU32(stream, fmt_chunk.sample_rate);
+        WriteU32(stream, fmt_chunk.num_channels);
+        WriteU32(stream, fmt_chunk.bits_per_sample);
+        WriteU32(stream, data_chunk.sub_chunk2_size);
+        WriteBytes(stream, audio_data.data(), data_chunk.sub_chunk2_size);
+    }
+
     SaveStream(stream, path);
     Free(stream);
 }
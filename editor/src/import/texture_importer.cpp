@@ -4,6 +4,7 @@
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../libs/stb_image.h"
+#include "../utils/texture_encode.h"
 
 extern void InitTextureEditor(TextureData*);
 
@@ -33,7 +34,7 @@ static void WriteTextureData(
     const uint8_t* data,
     int width,
     int height,
-    int channels,
+    TextureFormat format,
     const std::string& filter,
     const std::string& clamp) {
 
@@ -52,13 +53,12 @@ static void WriteTextureData(
         TEXTURE_CLAMP_REPEAT :
         TEXTURE_CLAMP_CLAMP;
     
-    TextureFormat format = TEXTURE_FORMAT_RGBA8;
     WriteU8(stream, (u8)format);
     WriteU8(stream, (u8)filter_value);
     WriteU8(stream, (u8)clamp_value);
     WriteU32(stream, width);
     WriteU32(stream, height);
-    WriteBytes(stream, data, width * height * channels);
+    WriteBytes(stream, data, GetTextureDataSize(format, width, height));
 }
 
 static void ImportTexture(AssetData* a, const std::filesystem::path& path, Props* config, Props* meta) {
@@ -76,6 +76,7 @@ static void ImportTexture(AssetData* a, const std::filesystem::path& path, Props
 
     std::string filter = meta->GetString("texture", "filter", "linear");
     std::string clamp = meta->GetString("texture", "clamp", "clamp");
+    std::string compression = meta->GetString("texture", "compression", "none");
     //bool convert_from_srgb = meta->GetBool("texture", "srgb", false);
 
     std::vector<uint8_t> rgba_data;
@@ -96,13 +97,28 @@ static void ImportTexture(AssetData* a, const std::filesystem::path& path, Props
     // if (convert_from_srgb)
     //     ConvertSRGBToLinear(rgba_data.data(), width, height, channels);
 
+    TextureFormat format = TEXTURE_FORMAT_RGBA8;
+    const u8* texture_data = rgba_data.data();
+    std::vector<uint8_t> block_data;
+    if (ParseTextureCompression(compression, &format)) {
+        if (width % 4 != 0 || height % 4 != 0) {
+            // WebGL rejects compressed uploads that are not whole blocks
+            LogWarning("%s: compression requires a multiple of 4 size (%dx%d), using rgba8", a->name->value, width, height);
+            format = TEXTURE_FORMAT_RGBA8;
+        } else {
+            block_data.resize(GetTextureDataSize(format, width, height));
+            EncodeTexture(format, rgba_data.data(), width, height, block_data.data());
+            texture_data = block_data.data();
+        }
+    }
+
     Stream* stream = CreateStream(ALLOCATOR_DEFAULT, 4096);
     WriteTextureData(
         stream,
-        rgba_data.data(),
+        texture_data,
         width,
         height,
-        channels,
+        format,
         filter,
         clamp
     );
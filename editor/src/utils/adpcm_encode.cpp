@@ -0,0 +1,63 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+// IMA ADPCM encoder for the sound importer.  Codes are chosen by stepping the runtime decoder
+// so the encoder tracks exactly what playback will reconstruct, and the step index carries
+// over between blocks to avoid a ramp at every block start.
+
+#include "adpcm_encode.h"
+
+u32 GetAdpcmEncodedSize(u32 frame_count, u32 channels) {
+    return (frame_count + SOUND_ADPCM_BLOCK_FRAMES - 1) / SOUND_ADPCM_BLOCK_FRAMES * SOUND_ADPCM_BLOCK_SIZE * channels;
+}
+
+static u8 EncodeAdpcmCode(AdpcmState* state, i32 sample) {
+    i32 step = GetAdpcmStep(*state);
+    i32 diff = sample - state->predictor;
+    u8 code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    if (diff >= step) { code |= 4; diff -= step; }
+    if (diff >= step >> 1) { code |= 2; diff -= step >> 1; }
+    if (diff >= step >> 2) { code |= 1; }
+
+    DecodeAdpcm(state, code);
+    return code;
+}
+
+static void EncodeAdpcmChannel(const i16* samples, u32 frame_count, u32 channel, u32 channels, u8* out) {
+    // Open on a step that already fits the first delta, the decoder would otherwise ramp up
+    // from the smallest step at the start of a loud sound
+    AdpcmState state = {};
+    if (frame_count > 1) {
+        i32 delta = Abs(static_cast<i32>(samples[channels + channel]) - static_cast<i32>(samples[channel]));
+        while (state.step_index < 88 && GetAdpcmStep(state) < delta)
+            state.step_index++;
+    }
+    for (u32 first = 0; first < frame_count; first += SOUND_ADPCM_BLOCK_FRAMES) {
+        u8* block = out + (first / SOUND_ADPCM_BLOCK_FRAMES * channels + channel) * SOUND_ADPCM_BLOCK_SIZE;
+        u32 count = Min(SOUND_ADPCM_BLOCK_FRAMES, frame_count - first);
+
+        state.predictor = samples[first * channels + channel];
+        block[0] = static_cast<u8>(state.predictor & 0xFF);
+        block[1] = static_cast<u8>((state.predictor >> 8) & 0xFF);
+        block[2] = static_cast<u8>(state.step_index);
+        block[3] = 0;
+
+        u8* codes = block + 4;
+        memset(codes, 0, SOUND_ADPCM_BLOCK_SIZE - 4);
+        for (u32 i = 1; i < count; i++) {
+            u8 code = EncodeAdpcmCode(&state, samples[(first + i) * channels + channel]);
+            codes[(i - 1) >> 1] |= (i - 1) & 1 ? code << 4 : code;
+        }
+    }
+}
+
+void EncodeAdpcm(const i16* samples, u32 frame_count, u8* out, u32 channels) {
+    for (u32 channel = 0; channel < channels; channel++)
+        EncodeAdpcmChannel(samples, frame_count, channel, channels, out);
+}
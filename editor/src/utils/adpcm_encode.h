@@ -0,0 +1,13 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#pragma once
+
+// Number of bytes EncodeAdpcm writes for frame_count frames, always whole blocks per channel
+extern u32 GetAdpcmEncodedSize(u32 frame_count, u32 channels = 1);
+
+// Encode interleaved 16 bit frames into SOUND_ADPCM_BLOCK_SIZE byte IMA ADPCM blocks, one block
+// per channel for each run of SOUND_ADPCM_BLOCK_FRAMES frames.  The tail of the last blocks is
+// padded with silence codes.
+extern void EncodeAdpcm(const i16* samples, u32 frame_count, u8* out, u32 channels = 1);
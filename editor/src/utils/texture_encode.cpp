@@ -0,0 +1,458 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+// Block compression encoders for the texture importer.  These favor simple and predictable
+// fits (principal axis endpoints for BC, per sub block averages for ETC) over exhaustive
+// searches, the matching decoders live in the runtime for backends without native support.
+
+#include "texture_encode.h"
+
+static const int g_etc1_modifiers[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+};
+
+static const int g_eac_modifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}
+};
+
+static int ClampByte(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static int ColorDistance(const u8* a, const u8* b) {
+    int dr = a[0] - b[0];
+    int dg = a[1] - b[1];
+    int db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+static void WriteBigEndian64(u64 value, u8* out) {
+    for (int i = 7; i >= 0; i--, value >>= 8)
+        out[i] = (u8)(value & 0xFF);
+}
+
+static u16 QuantizeColor565(const float* rgb) {
+    int r = ClampByte((int)(rgb[0] + 0.5f));
+    int g = ClampByte((int)(rgb[1] + 0.5f));
+    int b = ClampByte((int)(rgb[2] + 0.5f));
+    return (u16)((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+}
+
+static void DecodeColor565(u16 value, u8* rgb) {
+    u8 r = (value >> 11) & 0x1F;
+    u8 g = (value >> 5) & 0x3F;
+    u8 b = value & 0x1F;
+    rgb[0] = (u8)((r << 3) | (r >> 2));
+    rgb[1] = (u8)((g << 2) | (g >> 4));
+    rgb[2] = (u8)((b << 3) | (b >> 2));
+}
+
+// Endpoints along the principal axis of the colors that will be encoded
+static void FitColorEndpoints(const u8 pixels[16][4], const bool* used, float* e0, float* e1) {
+    float mean[3] = {};
+    int count = 0;
+    for (int i = 0; i < 16; i++) {
+        if (!used[i])
+            continue;
+        for (int c = 0; c < 3; c++)
+            mean[c] += pixels[i][c];
+        count++;
+    }
+
+    for (int c = 0; c < 3; c++)
+        mean[c] /= (float)count;
+
+    float cov[6] = {};
+    for (int i = 0; i < 16; i++) {
+        if (!used[i])
+            continue;
+        float r = pixels[i][0] - mean[0];
+        float g = pixels[i][1] - mean[1];
+        float b = pixels[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = Max(Abs(x), Max(Abs(y), Abs(z)));
+        if (length < 1e-6f)
+            break;
+        axis[0] = x / length;
+        axis[1] = y / length;
+        axis[2] = z / length;
+    }
+
+    float length_sqr = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float t_min = 0.0f;
+    float t_max = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        if (!used[i])
+            continue;
+        float t =
+            (pixels[i][0] - mean[0]) * axis[0] +
+            (pixels[i][1] - mean[1]) * axis[1] +
+            (pixels[i][2] - mean[2]) * axis[2];
+        t_min = Min(t_min, t);
+        t_max = Max(t_max, t);
+    }
+
+    for (int c = 0; c < 3; c++) {
+        e0[c] = mean[c] + axis[c] * t_max / length_sqr;
+        e1[c] = mean[c] + axis[c] * t_min / length_sqr;
+    }
+}
+
+static void EncodeBC1Block(const u8 pixels[16][4], bool allow_transparent, u8* out) {
+    bool used[16];
+    int used_count = 0;
+    for (int i = 0; i < 16; i++) {
+        used[i] = !allow_transparent || pixels[i][3] >= 128;
+        used_count += used[i] ? 1 : 0;
+    }
+
+    // Fully transparent, three color mode with every pixel on the transparent index
+    if (used_count == 0) {
+        memset(out, 0, 4);
+        memset(out + 4, 0xFF, 4);
+        return;
+    }
+
+    float e0[3];
+    float e1[3];
+    FitColorEndpoints(pixels, used, e0, e1);
+    u16 c0 = QuantizeColor565(e0);
+    u16 c1 = QuantizeColor565(e1);
+
+    // Four color mode needs c0 > c1, three color mode (transparent pixels) needs c0 <= c1
+    bool three_color = used_count < 16;
+    if (three_color ? c0 > c1 : c0 < c1) {
+        u16 t = c0;
+        c0 = c1;
+        c1 = t;
+    }
+
+    u8 palette[4][3];
+    DecodeColor565(c0, palette[0]);
+    DecodeColor565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        if (three_color) {
+            palette[2][c] = (u8)((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        } else {
+            palette[2][c] = (u8)((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = (u8)((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+    }
+
+    u32 indices = 0;
+    int palette_count = three_color ? 3 : 4;
+    for (int i = 0; i < 16; i++) {
+        u32 best = 3;
+        if (used[i]) {
+            int best_error = INT_MAX;
+            for (int p = 0; p < palette_count; p++) {
+                int error = ColorDistance(pixels[i], palette[p]);
+                if (error < best_error) {
+                    best_error = error;
+                    best = (u32)p;
+                }
+            }
+        }
+        indices |= best << (i * 2);
+    }
+
+    out[0] = (u8)(c0 & 0xFF);
+    out[1] = (u8)(c0 >> 8);
+    out[2] = (u8)(c1 & 0xFF);
+    out[3] = (u8)(c1 >> 8);
+    out[4] = (u8)(indices & 0xFF);
+    out[5] = (u8)((indices >> 8) & 0xFF);
+    out[6] = (u8)((indices >> 16) & 0xFF);
+    out[7] = (u8)(indices >> 24);
+}
+
+static void EncodeBC3AlphaBlock(const u8 pixels[16][4], u8* out) {
+    u8 a_min = 255;
+    u8 a_max = 0;
+    for (int i = 0; i < 16; i++) {
+        a_min = Min(a_min, pixels[i][3]);
+        a_max = Max(a_max, pixels[i][3]);
+    }
+
+    // a0 > a1 selects the eight value palette, equal endpoints collapse to index zero
+    u8 palette[8];
+    palette[0] = a_max;
+    palette[1] = a_min;
+    for (int i = 1; i < 7; i++)
+        palette[i + 1] = (u8)(((7 - i) * a_max + i * a_min) / 7);
+
+    u64 indices = 0;
+    if (a_max != a_min) {
+        for (int i = 0; i < 16; i++) {
+            u64 best = 0;
+            int best_error = INT_MAX;
+            for (int p = 0; p < 8; p++) {
+                int error = Abs(pixels[i][3] - palette[p]);
+                if (error < best_error) {
+                    best_error = error;
+                    best = (u64)p;
+                }
+            }
+            indices |= best << (i * 3);
+        }
+    }
+
+    out[0] = a_max;
+    out[1] = a_min;
+    for (int i = 0; i < 6; i++)
+        out[2 + i] = (u8)((indices >> (i * 8)) & 0xFF);
+}
+
+// Best modifier table and per pixel modifiers for one ETC sub block around a base color
+static int FitETCSubBlock(const u8 pixels[16][4], const int* sub_pixels, const int* base, int* table, int* modifiers) {
+    int best_error = INT_MAX;
+    for (int t = 0; t < 8; t++) {
+        int error = 0;
+        int candidate[8];
+        for (int i = 0; i < 8; i++) {
+            const u8* pixel = pixels[sub_pixels[i]];
+            int pixel_error = INT_MAX;
+            for (int m = 0; m < 4; m++) {
+                int delta = (m & 2) ? -g_etc1_modifiers[t][m & 1] : g_etc1_modifiers[t][m & 1];
+                u8 color[3] = {
+                    (u8)ClampByte(base[0] + delta),
+                    (u8)ClampByte(base[1] + delta),
+                    (u8)ClampByte(base[2] + delta)
+                };
+                int e = ColorDistance(pixel, color);
+                if (e < pixel_error) {
+                    pixel_error = e;
+                    candidate[i] = m;
+                }
+            }
+            error += pixel_error;
+        }
+
+        if (error < best_error) {
+            best_error = error;
+            *table = t;
+            memcpy(modifiers, candidate, sizeof(candidate));
+        }
+    }
+
+    return best_error;
+}
+
+// Individual and differential modes only, which ETC2 decoders read the same as ETC1
+static void EncodeETC2ColorBlock(const u8 pixels[16][4], u8* out) {
+    u64 best_block = 0;
+    int best_error = INT_MAX;
+
+    for (int flip = 0; flip < 2; flip++) {
+        // Pixel indices within the 4x4 block (y * 4 + x) for each sub block
+        int sub_pixels[2][8];
+        int sub_count[2] = {};
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                int sub = flip ? (y >= 2) : (x >= 2);
+                sub_pixels[sub][sub_count[sub]++] = y * 4 + x;
+            }
+        }
+
+        float average[2][3] = {};
+        for (int sub = 0; sub < 2; sub++) {
+            for (int i = 0; i < 8; i++)
+                for (int c = 0; c < 3; c++)
+                    average[sub][c] += pixels[sub_pixels[sub][i]][c];
+            for (int c = 0; c < 3; c++)
+                average[sub][c] /= 8.0f;
+        }
+
+        int q5[2][3];
+        bool diff = true;
+        for (int c = 0; c < 3; c++) {
+            q5[0][c] = (int)(average[0][c] * 31.0f / 255.0f + 0.5f);
+            q5[1][c] = (int)(average[1][c] * 31.0f / 255.0f + 0.5f);
+            int delta = q5[1][c] - q5[0][c];
+            diff = diff && delta >= -4 && delta <= 3;
+        }
+
+        u64 block = (u64)(diff ? 1 : 0) << 33 | (u64)flip << 32;
+        int base[2][3];
+        if (diff) {
+            for (int c = 0; c < 3; c++) {
+                base[0][c] = (q5[0][c] << 3) | (q5[0][c] >> 2);
+                base[1][c] = (q5[1][c] << 3) | (q5[1][c] >> 2);
+                int shift = 59 - c * 8;
+                block |= (u64)q5[0][c] << shift;
+                block |= (u64)((q5[1][c] - q5[0][c]) & 7) << (shift - 3);
+            }
+        } else {
+            for (int c = 0; c < 3; c++) {
+                int q0 = (int)(average[0][c] * 15.0f / 255.0f + 0.5f);
+                int q1 = (int)(average[1][c] * 15.0f / 255.0f + 0.5f);
+                base[0][c] = q0 * 17;
+                base[1][c] = q1 * 17;
+                int shift = 60 - c * 8;
+                block |= (u64)q0 << shift;
+                block |= (u64)q1 << (shift - 4);
+            }
+        }
+
+        int error = 0;
+        for (int sub = 0; sub < 2; sub++) {
+            int table = 0;
+            int modifiers[8];
+            error += FitETCSubBlock(pixels, sub_pixels[sub], base[sub], &table, modifiers);
+            block |= (u64)table << (sub == 0 ? 37 : 34);
+
+            for (int i = 0; i < 8; i++) {
+                int x = sub_pixels[sub][i] % 4;
+                int y = sub_pixels[sub][i] / 4;
+                int bit = x * 4 + y;
+                block |= (u64)(modifiers[i] >> 1) << (16 + bit);
+                block |= (u64)(modifiers[i] & 1) << bit;
+            }
+        }
+
+        if (error < best_error) {
+            best_error = error;
+            best_block = block;
+        }
+    }
+
+    WriteBigEndian64(best_block, out);
+}
+
+static int FitEACAlpha(const u8 pixels[16][4], int table, int multiplier, int base, u64* indices) {
+    const int* modifiers = g_eac_modifiers[table];
+    int error = 0;
+    u64 result = 0;
+    for (int i = 0; i < 16; i++) {
+        // Indices are stored column major from the most significant bits down
+        int x = i / 4;
+        int y = i % 4;
+        int alpha = pixels[y * 4 + x][3];
+        int best = 0;
+        int best_error = INT_MAX;
+        for (int m = 0; m < 8; m++) {
+            int e = Abs(alpha - ClampByte(base + modifiers[m] * multiplier));
+            if (e < best_error) {
+                best_error = e;
+                best = m;
+            }
+        }
+        error += best_error * best_error;
+        result |= (u64)best << (45 - i * 3);
+    }
+
+    *indices = result;
+    return error;
+}
+
+static void EncodeEACAlphaBlock(const u8 pixels[16][4], u8* out) {
+    int a_min = 255;
+    int a_max = 0;
+    for (int i = 0; i < 16; i++) {
+        a_min = Min(a_min, (int)pixels[i][3]);
+        a_max = Max(a_max, (int)pixels[i][3]);
+    }
+
+    u64 best_block = 0;
+    int best_error = INT_MAX;
+    for (int table = 0; table < 16 && best_error > 0; table++) {
+        int t_min = g_eac_modifiers[table][3];
+        int t_max = g_eac_modifiers[table][7];
+        int fit = (int)((float)(a_max - a_min) / (float)(t_max - t_min) + 0.5f);
+
+        for (int multiplier = Max(1, fit - 1); multiplier <= Min(15, fit + 1); multiplier++) {
+            int base = ClampByte((int)((a_max + a_min) * 0.5f - multiplier * (t_max + t_min) * 0.5f + 0.5f));
+            u64 indices = 0;
+            int error = FitEACAlpha(pixels, table, multiplier, base, &indices);
+            if (error < best_error) {
+                best_error = error;
+                best_block = (u64)base << 56 | (u64)multiplier << 52 | (u64)table << 48 | indices;
+            }
+        }
+    }
+
+    WriteBigEndian64(best_block, out);
+}
+
+void EncodeTexture(TextureFormat format, const u8* rgba, int width, int height, u8* out) {
+    assert(IsBlockCompressed(format));
+    assert(rgba);
+    assert(out);
+
+    const int block_size = format == TEXTURE_FORMAT_BC1 ? 8 : 16;
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+
+    u8 pixels[16][4];
+    for (int by = 0; by < blocks_y; by++) {
+        for (int bx = 0; bx < blocks_x; bx++, out += block_size) {
+            for (int y = 0; y < 4; y++) {
+                int sy = Min(by * 4 + y, height - 1);
+                for (int x = 0; x < 4; x++) {
+                    int sx = Min(bx * 4 + x, width - 1);
+                    memcpy(pixels[y * 4 + x], rgba + (sy * width + sx) * 4, 4);
+                }
+            }
+
+            switch (format) {
+            case TEXTURE_FORMAT_BC1:
+                EncodeBC1Block(pixels, true, out);
+                break;
+            case TEXTURE_FORMAT_BC3:
+                EncodeBC3AlphaBlock(pixels, out);
+                EncodeBC1Block(pixels, false, out + 8);
+                break;
+            case TEXTURE_FORMAT_ETC2:
+                EncodeEACAlphaBlock(pixels, out);
+                EncodeETC2ColorBlock(pixels, out + 8);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+bool ParseTextureCompression(const std::string& value, TextureFormat* format) {
+    if (value == "bc1" || value == "dxt1") {
+        *format = TEXTURE_FORMAT_BC1;
+        return true;
+    }
+
+    if (value == "bc3" || value == "dxt5") {
+        *format = TEXTURE_FORMAT_BC3;
+        return true;
+    }
+
+    if (value == "etc2") {
+        *format = TEXTURE_FORMAT_ETC2;
+        return true;
+    }
+
+    return false;
+}
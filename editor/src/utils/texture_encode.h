@@ -0,0 +1,12 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#pragma once
+
+// Encode an RGBA8 image into one of the block compressed texture formats.  The output must
+// hold GetTextureDataSize(format, width, height) bytes, edge blocks repeat the last row/column.
+extern void EncodeTexture(TextureFormat format, const u8* rgba, int width, int height, u8* out);
+
+// Parse a .meta compression name (bc1, bc3, etc2), returns false for none or unknown names
+extern bool ParseTextureCompression(const std::string& value, TextureFormat* format);
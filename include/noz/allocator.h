@@ -21,6 +21,7 @@ struct Allocator
     void (*pop)(Allocator*);
     void (*clear)(Allocator*);
     AllocatorStats (*stats)(Allocator*);
+    void (*destroy)(Allocator*);
     const char* name;
 };
 
@@ -48,12 +49,14 @@ Allocator* CreateArenaAllocator(u32 size, const char* name);
 // @pool
 struct PoolAllocator : Allocator { };
 
-extern PoolAllocator* CreatePoolAllocator(u32 item_size, u32 capacity);
+// With grow set the pool chains another block of capacity items instead of failing when full
+extern PoolAllocator* CreatePoolAllocator(u32 item_size, u32 capacity, bool grow = false);
 extern void* GetAt(PoolAllocator* allocator, u32 index);
 extern u32 GetIndex(PoolAllocator* allocator, const void* ptr);
 extern bool IsFull(PoolAllocator* allocator);
 extern bool IsEmpty(PoolAllocator* allocator);
 extern u32 GetCount(PoolAllocator* allocator);
+extern u32 GetCapacity(PoolAllocator* allocator);
 extern bool IsValid(PoolAllocator* allocator, u32 index);
 extern void Enumerate(PoolAllocator* allocator, bool (*func)(u32 index, void* item, void* user_data), void* user_data=nullptr);
 
@@ -15,6 +15,7 @@ typedef u32 AnimationFlags;
 constexpr AnimationFlags ANIMATION_FLAG_NONE = 0;
 constexpr AnimationFlags ANIMATION_FLAG_LOOPING = 1 << 0;
 constexpr AnimationFlags ANIMATION_FLAG_ROOT_MOTION = 1 << 1;
+constexpr AnimationFlags ANIMATION_FLAG_COMPRESSED = 1 << 2;
 
 struct BoneTransform {
     Vec2 position;
@@ -141,6 +142,12 @@ inline float GetTime(Animator& animator, int layer_index=0) {
 extern void BindSkeleton(Skeleton* skeleton);
 extern void BindSkeleton(Animator& animator);
 
+// Registered animators are advanced and evaluated together by UpdateAnimators, split across
+// the task workers.  The animator must stay at the same address until it is removed.
+extern void AddAnimator(Animator& animator);
+extern void RemoveAnimator(Animator& animator);
+extern void UpdateAnimators(float time_scale=1.0f);
+
 // @blend_tree
 constexpr int MAX_BLEND_TREE_BLENDS = 3;
 
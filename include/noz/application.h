@@ -29,6 +29,8 @@ struct ApplicationTraits {
     const char* name;
     const char* title;
     const char** asset_paths;       // Null-terminated list of asset search paths (resolved to full paths)
+    const char* asset_pack;         // Pack file searched for in asset_paths before loose files, null disables
+    float asset_upload_budget;      // Milliseconds per frame spent finishing async asset loads
     int x;
     int y;
     int width;
@@ -36,7 +38,7 @@ struct ApplicationTraits {
     Orientation orientation;        // Preferred screen orientation
     u32 asset_memory_size;
     u32 scratch_memory_size;
-    u32 max_names;
+    u32 max_names;                  // Names interned lock free, more still work but take a mutex
     u32 name_memory_size;
     u32 max_events;
     u32 max_event_listeners;
@@ -45,10 +47,20 @@ struct ApplicationTraits {
     u32 max_tasks;
     u32 max_frame_tasks;
     u32 max_task_worker_count;
+    u32 max_animators;
     struct {
         u32 max_requests;
         u32 max_concurrent_requests;
     } http;
+    struct {
+        u32 max_particles;
+        u32 max_emitters;
+        u32 max_instances;
+        u32 particle_budget;        // Live particles at which emission is fully thinned, 0 disables
+    } vfx;
+    struct {
+        u32 max_voices;             // Concurrent sounds before the quietest oldest voice is stolen
+    } audio;
     float ui_depth;
     RendererTraits renderer;
     bool (*load_assets)(Allocator* allocator);
@@ -48,6 +48,8 @@ struct Asset {
 
 typedef Asset* (*AssetLoaderFunc)(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
 typedef void (*AssetReloadFunc)(Asset* asset, Stream* stream, const AssetHeader& header, const Name** name_table);
+typedef bool (*AssetUploadFunc)(Asset* asset);
+typedef void (*AssetLoadCallback)(Asset* asset, void* user_data);
 
 // @asset_registry
 constexpr int MAX_ASSET_TYPES = 128;
@@ -59,6 +61,8 @@ struct AssetTypeInfo {
     const char* extension;           // ".mesh", ".hrskel"
     AssetLoaderFunc loader;          // runtime loader function
     AssetReloadFunc reload;          // hot-reload function (optional)
+    AssetUploadFunc upload;          // main thread GPU work after a worker side async load, false drops the asset (optional)
+    bool main_thread;                // loader can't run off the main thread, async loads parse in the upload phase
 };
 
 extern void RegisterAssetType(const AssetTypeInfo& info);
@@ -66,6 +70,7 @@ extern const AssetTypeInfo* GetAssetTypeInfo(int type_id);
 extern const AssetTypeInfo* FindAssetTypeByExtension(const char* ext);
 extern int GetRegisteredAssetTypeCount();
 extern void InitAssets();
+extern void ShutdownAssets();
 
 extern bool ReadAssetHeader(Stream* stream, AssetHeader* header);
 extern bool WriteAssetHeader(Stream* stream, AssetHeader* header, const Name** name_table = nullptr);
@@ -74,8 +79,16 @@ extern const char* GetExtensionFromAssetType(AssetType asset_type);
 extern const char* ToString(AssetType asset_type);
 extern const char* ToShortString(AssetType asset_type);
 extern const char* ToTypeString(AssetType asset_type);
+// Builtin data is parsed in place and may be referenced by the asset, it must outlive it
 extern Asset* LoadAsset(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoaderFunc loader, const u8* data=nullptr, u32 data_size=0);
 extern const Name** ReadNameTable(const AssetHeader& header, Stream* stream);
+
+// Reads and, where the type and allocator allow it, parses the asset on a task worker.  The
+// rest runs on the main thread in a per frame upload phase bounded by asset_upload_budget and
+// the callback fires from there, with null if the asset failed to load.  The allocator is only
+// used off the main thread when it is ALLOCATOR_DEFAULT.
+extern bool LoadAssetAsync(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoadCallback callback, void* user_data=nullptr);
+extern int GetPendingAssetLoadCount();
 extern bool IsValidAssetType(AssetType asset_type);
 extern Asset* LoadAssetInternal(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoaderFunc loader, Stream* stream);
 extern Asset* LoadAssetInternal(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoaderFunc loader, const u8* data=nullptr, u32 data_size=0);
@@ -84,6 +97,41 @@ inline AssetType GetType(Asset* asset) { return asset->type; }
 inline bool IsCustomType(Asset* asset) { return asset->type == ASSET_TYPE_CUSTOM; }
 inline int GetCustomTypeId(Asset* asset) { return asset->custom_type_id; }
 
+// @asset_pack
+// Single file holding every asset, written by the editor build and mapped once at startup.
+// The table of contents follows the header, sorted by name hash then type, and each payload
+// is a complete asset file starting on an ASSET_PACK_ALIGNMENT boundary.  Payloads with a
+// raw_size are compressed and are expanded into their own stream when loaded.
+constexpr u32 ASSET_PACK_SIGNATURE = FourCC('N', 'O', 'Z', 'P');
+constexpr u32 ASSET_PACK_VERSION = 2;
+constexpr u32 ASSET_PACK_ALIGNMENT = 16;
+constexpr const char* ASSET_PACK_NAME = "assets.pack";
+
+struct AssetPackHeader {
+    u32 signature;
+    u32 version;
+    u32 entry_count;
+    u32 reserved;
+};
+
+struct AssetPackEntry {
+    u64 name_hash;
+    u32 type;
+    u32 offset;
+    u32 size;
+    u32 raw_size;
+};
+
+// Hash of the lower case asset name plus an optional variant suffix such as ".glsl"
+extern u64 GetAssetPackHash(const char* name, const char* suffix=nullptr);
+
+// Mounts a pack that stays resident for the life of the application, such as the one a
+// release build embeds.  Replaces any pack mounted from the asset paths.
+extern bool MountAssetPack(const u8* data, u32 size);
+inline bool operator<(const AssetPackEntry& a, const AssetPackEntry& b) {
+    return a.name_hash != b.name_hash ? a.name_hash < b.name_hash : a.type < b.type;
+}
+
 // @loaders
 Asset* LoadTexture(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
 Asset* LoadAtlas(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
@@ -96,13 +144,22 @@ Asset* LoadSkeleton(Allocator* allocator, Stream* stream, AssetHeader* header, c
 Asset* LoadAnimation(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
 Asset* LoadBin(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
 
+// @uploads
+// Loaders called off the main thread keep what the GPU needs and create it in these instead
+bool UploadTexture(Asset* asset);
+bool UploadShader(Asset* asset);
+bool UploadFont(Asset* asset);
+bool UploadVfx(Asset* asset);
+
 #if defined(NOZ_LUA)
 Asset* LoadLuaScript(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table);
 #endif
 
+// Builtin symbols point into the embedded asset pack, compressed assets have no symbol and
+// are expanded through the mounted pack instead
 #ifdef NOZ_BUILTIN_ASSETS
 #define NOZ_ASSET_DATA(name) name ## _DATA
-#define NOZ_ASSET_DATA_SIZE(name) (u32)(sizeof(NOZ_ASSET_DATA(name)))
+#define NOZ_ASSET_DATA_SIZE(name) name ## _DATA_SIZE
 #else
 #define NOZ_ASSET_DATA(name) nullptr
 #define NOZ_ASSET_DATA_SIZE(name) 0
@@ -6,13 +6,39 @@
 
 struct Sound : Asset {};
 
+constexpr u32 SOUND_FLAG_ADPCM = 1 << 0;     // Samples are IMA ADPCM blocks instead of PCM
+constexpr u32 SOUND_FLAG_STREAM = 1 << 1;    // Kept encoded and decoded a block at a time as music
+
+// @adpcm
+// IMA ADPCM over 16 bit samples in blocks of SOUND_ADPCM_BLOCK_SIZE bytes.  Each block opens
+// with its first sample as an i16 and the step index as a u8 plus a pad byte, then holds two
+// four bit codes per byte, low nibble first.  Stereo sounds store a left and a right block for
+// every SOUND_ADPCM_BLOCK_FRAMES frames, one after the other.
+constexpr u32 SOUND_ADPCM_BLOCK_SIZE = 256;
+constexpr u32 SOUND_ADPCM_BLOCK_FRAMES = 1 + (SOUND_ADPCM_BLOCK_SIZE - 4) * 2;
+
+struct AdpcmState {
+    i32 predictor;
+    i32 step_index;
+};
+
+extern i32 GetAdpcmStep(const AdpcmState& state);
+extern i16 DecodeAdpcm(AdpcmState* state, u8 code);
+extern void DecodeAdpcmBlock(const u8* block, u32 frame_count, i16* out, u32 stride = 1);
+
 struct SoundHandle {
     u64 value;
 };
 
+struct AudioStats {
+    int voice_count;        // Voices still playing after the last mix
+    int stolen_count;       // Voices taken over by a new sound because every voice was busy
+    u64 mixed_frames;
+};
+
 extern SoundHandle Play(Sound** sounds, int count, float volume = 1.0f, float pitch = 1.0f, bool loop=false);
 extern SoundHandle Play(Sound* sound, float volume = 1.0f, float pitch = 1.0f, bool loop=false);
-extern void PlayMusic(Sound* sound);
+extern void PlayMusic(Sound* sound, bool loop = true);
 extern void StopMusic();
 extern bool IsMusicPlaying();
 extern void SetVolume(const SoundHandle& handle, float volume);
@@ -30,5 +56,7 @@ extern float GetMasterVolume();
 extern float GetSoundVolume();
 extern float GetMusicVolume();
 
+extern const AudioStats& GetAudioStats();
+
 extern Sound** SOUND;
 extern int SOUND_COUNT;
\ No newline at end of file
@@ -47,29 +47,34 @@ inline bool IsFull(RingBuffer* rb) { return rb->count == rb->capacity; }
 inline u32 GetCount(RingBuffer* rb) { return rb->count; }
 
 // @map
+// Fixed capacity hash map over caller provided storage.  capacity must be a power of two,
+// keys and values hold capacity entries and ctrl holds GetMapCtrlSize(capacity) bytes.
+// Removed keys leave tombstones that are reclaimed by rehashing in place once empty slots
+// run low, so remove and insert churn never degrades lookups.
+constexpr size_t MAP_GROUP_SIZE = 16;
+
 struct Map
 {
     size_t capacity;
     size_t count;
+    size_t deleted;
     u64* keys;
     void* values;
+    u8* ctrl;
     size_t value_stride;
 };
 
-inline void Init(Map& map, u64* keys, void* values, size_t capacity, size_t value_stride, size_t initial_count=0)
-{
-    map.capacity = capacity;
-    map.keys = keys;
-    map.values = values;
-    map.value_stride = value_stride;
-    map.count = initial_count;
-}
+constexpr size_t GetMapCtrlSize(size_t capacity) { return capacity + MAP_GROUP_SIZE; }
 
+void Init(Map& map, u64* keys, void* values, u8* ctrl, size_t capacity, size_t value_stride);
+void Clear(Map& map);
 bool HasKey(const Map& map, u64 key);
 void* GetValue(const Map& map, const char* key);
 void* GetValue(const Map& map, u64 key);
 void* SetValue(Map& map, const char* key, void* value = nullptr);
 void* SetValue(Map& map, u64 key, void* value = nullptr);
+bool RemoveKey(Map& map, const char* key);
+bool RemoveKey(Map& map, u64 key);
 
 struct LinkedList
 {
@@ -34,6 +34,9 @@ bool color32_is_transparent(Color32* color);
 bool color32_is_opaque(Color32* color);
 bool color32_equals(Color32* a, Color32* b);
 
+inline bool operator==(const Color& a, const Color& b) { return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a; }
+inline bool operator!=(const Color& a, const Color& b) { return !(a == b); }
+
 inline Color ToLinear(Color color) {
     return color;
 }
@@ -0,0 +1,15 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#pragma once
+
+// @compress
+// Byte oriented LZ77 in the style of LZ4 blocks, cheap enough to decode at load time.  Returns
+// the compressed size or COMPRESS_FAILED when the output does not fit in dst_capacity.  Empty
+// input compresses to zero bytes, which Decompress turns back into zero bytes.
+constexpr u32 COMPRESS_FAILED = U32_MAX;
+
+extern u32 Compress(const u8* src, u32 src_size, u8* dst, u32 dst_capacity);
+extern bool Decompress(const u8* src, u32 src_size, u8* dst, u32 dst_size);
+inline u32 GetMaxCompressedSize(u32 size) { return size + size / 255 + 16; }
@@ -21,6 +21,7 @@
 #include "name.h"
 #include "color.h"
 #include "hash.h"
+#include "compress.h"
 #include "stream.h"
 #include "asset.h"
 #include "renderer.h"
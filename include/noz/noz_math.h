@@ -405,6 +405,7 @@ extern bool Intersects(const Bounds2& bounds, const Bounds2& other);
 extern bool Intersects(const Bounds2& bounds, const Vec2& line_start, const Vec2& line_end);
 extern bool Intersects(const Bounds2& bounds, const Vec2& tri_pt0, const Vec2& tri_pt1, const Vec2& tri_pt2);
 extern Bounds2 Union(const Bounds2& a, const Bounds2& b);
+extern Bounds2 TransformBounds(const Mat3& m, const Bounds2& bounds);
 inline Bounds2 Union(const Bounds2& a, const Vec2& b) { return Bounds2{ Min(a.min, b), Max(a.max, b) }; }
 inline Vec2 GetCenter(const Bounds2& b) { return Vec2{ (b.min.x + b.max.x) * 0.5f, (b.min.y + b.max.y) * 0.5f }; }
 inline Vec2 GetSize(const Bounds2& b) { return Vec2{ b.max.x - b.min.x, b.max.y - b.min.y }; }
@@ -25,6 +25,10 @@ struct Animator;
 // @renderer_traits
 struct RendererTraits {
     int max_frame_commands;
+    int max_frame_instances;  // Capacity of the per frame instance buffer shared by all instanced draws
+    int max_frame_glyphs;  // Capacity in quads of the per frame glyph stream shared by all text draws
+    u32 frame_data_memory_size;  // Per frame storage for user uniforms and bone palettes
+    u32 frame_uniform_memory_size;  // Per frame slice of the GPU uniform ring (GL)
     i32 vsync;
     int msaa_samples;  // 0=off, 2=2x, 4=4x MSAA
     float min_depth;
@@ -46,13 +50,19 @@ enum TextureClamp {
 enum TextureFormat {
     TEXTURE_FORMAT_RGBA8,
     TEXTURE_FORMAT_RGBA16F,
-    TEXTURE_FORMAT_R8
+    TEXTURE_FORMAT_R8,
+    TEXTURE_FORMAT_BC1,     // 4x4 blocks, 8 bytes, RGB with 1 bit alpha
+    TEXTURE_FORMAT_BC3,     // 4x4 blocks, 16 bytes, RGBA
+    TEXTURE_FORMAT_ETC2,    // 4x4 blocks, 16 bytes, RGBA8 ETC2 + EAC alpha
+    TEXTURE_FORMAT_COUNT
 };
 
-Texture* CreateTexture(Allocator* allocator, void* data, size_t width, size_t height, TextureFormat format, const Name* name, TextureFilter filter = TEXTURE_FILTER_LINEAR);
+Texture* CreateTexture(Allocator* allocator, const void* data, size_t width, size_t height, TextureFormat format, const Name* name, TextureFilter filter = TEXTURE_FILTER_LINEAR);
 Texture* CreateTexture(Allocator* allocator, int width, int height, TextureFormat format, const Name* name, TextureFilter filter = TEXTURE_FILTER_LINEAR);
 void UpdateTexture(Texture* texture, void* data);  // Update entire texture with new data
 int GetBytesPerPixel(TextureFormat format);
+bool IsBlockCompressed(TextureFormat format);
+u32 GetTextureDataSize(TextureFormat format, int width, int height);
 Vec2Int GetSize(Texture* texture);
 
 // Texture arrays (for atlas binding)
@@ -156,6 +166,15 @@ extern void AddCircle(MeshBuilder* builder, const Vec2& center, f32 radius, int
 extern void AddCircleStroke(MeshBuilder* builder, const Vec2& center, f32 radius, f32 thickness, int segments, const Vec2& uv_color);
 extern void AddArc(MeshBuilder* builder, const Vec2& center, f32 radius, f32 start, f32 end, int segments, const Vec2& uv_color);
 
+// @render_stats
+struct RenderStats {
+    int command_count;
+    int draw_count;
+    int culled_count;  // Draws rejected against the camera bounds before being recorded
+};
+
+extern const RenderStats& GetRenderStats();  // Counters from the last executed frame
+
 // @render_buffer
 extern void BindSkeleton(const Mat3* bones, int bone_count, int stride=0);
 extern void BindSkeleton(const Mat3* bind_poses, int bind_pose_stride, Mat3* bones, int bone_stride, int bone_count);
@@ -166,6 +185,7 @@ extern void BindColor(Color color, Color emission);
 extern void BindColor(Color color, const Vec2Int& color_offset);
 extern void BindColor(Color color, const Vec2Int& color_offset, Color emission);
 extern void BindCamera(Camera* camera);
+extern bool IsVisible(const Bounds2& world_bounds);  // Against the bound camera, always true before one is bound
 extern void BindVertexUserData(const void* data, size_t size);
 extern void BindFragmentUserData(const void* data, size_t size);
 extern void BindDepth(float depth, float depth_scale=1.0f);
@@ -190,6 +210,43 @@ extern void DrawMesh(Mesh* mesh, const Mat3& transform, int frame_index);  // fr
 extern void DrawMesh(Mesh* mesh, const Mat3& transform, float time, bool loop=false);  // time/loop ignored (UV animation)
 extern void DrawMesh(Mesh* mesh, const Mat3& transform, Animator& animator, int bone_index, float time);
 
+// Per instance state for DrawMeshInstanced, replaces the bound transform, depth and color
+struct InstanceData {
+    Mat3 transform;
+    Color color;
+    Color emission;
+    Vec2Int color_offset;
+    float depth;
+};
+
+// Draws the mesh once per instance using the bound material, shader, texture and depth
+// scale.  Shaders marked instanced draw every instance in one call, others fall back to
+// a draw per instance.
+extern void DrawMeshInstanced(Mesh* mesh, const InstanceData* instances, int count);
+
+// Reorders draws between clip, camera and uniform binds by depth and then by state so
+// redundant binds can be skipped.  Draws that share a depth may change order.  Adjacent
+// draws of the same mesh and material with an instanced shader are merged either way.
+extern void EnableRenderSort(bool enabled);
+extern bool IsRenderSortEnabled();
+
+// @glyphs
+// Compact vertex for screen aligned text quads, four per glyph in top left, top right,
+// bottom right, bottom left order.
+struct GlyphVertex {
+    Vec2 position;
+    Vec2 uv;
+    Color32 color;  // Linear
+};
+
+// Returns room for quad_count glyph quads in the stream of the given font material, already
+// placed in world space.  Each stream is drawn in one call when flushed, which happens at the
+// next mesh draw, clip or camera change, on FlushGlyphs and before the frame's commands
+// execute.  Text keeps its place in painter's order and runs of labels between meshes share
+// one draw per font.
+extern GlyphVertex* AddGlyphs(Material* material, int quad_count);
+extern void FlushGlyphs();
+
 // @clipping
 extern void BeginClip();      // Start writing clip mask to stencil
 extern void EndClipWrite();   // Switch from writing to testing stencil
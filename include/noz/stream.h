@@ -19,6 +19,11 @@ struct Stream {};
 extern Stream* CreateStream(Allocator* allocator, u32 capacity, u32 initial_size = 0);
 extern Stream* CreateStream(Allocator* allocator, u8* data, u32 size);
 extern Stream* LoadStream(Allocator* allocator, const u8* data, u32 size);
+
+// View over memory that outlives the stream, such as builtin asset data or a mapped asset pack.
+// Nothing is copied and writes are rejected, loaders may keep pointers from ReadInPlace.
+extern Stream* CreateReadOnlyStream(Allocator* allocator, const u8* data, u32 size);
+extern bool IsReadOnly(Stream* stream);
 extern Stream* LoadStream(Allocator* allocator, const std::filesystem::path& path);
 
 // @endian
@@ -60,6 +65,7 @@ extern Vec3 ReadVec3(Stream* stream);
 extern Vec2 ReadVec2(Stream* stream);
 extern Mat3 ReadMat3(Stream* stream);
 extern int ReadBytes(Stream* stream, void* dest, u32 count);
+extern const u8* ReadInPlace(Stream* stream, u32 count);
 extern void AlignStream(Stream* stream, int alignment);
 
 extern int ReadString(Stream* stream, char* buffer, int buffer_size);
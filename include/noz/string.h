@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdarg.h>
+
 extern int Copy(char* dst, int dst_size, const char* src);
 extern int Copy(char* dst, int dst_size, const char* src, int length);
 extern bool Equals(const char* s1, const char* s2, bool ignore_case = false);
@@ -39,6 +39,7 @@ namespace noz {
     using TaskRunFunc = std::function<void*(Task task)>;
     using TaskCompleteFunc = std::function<void(Task task, void* result)>;
     using TaskDestroyFunc = std::function<void(void* result)>;
+    using ParallelForFunc = std::function<void(int begin, int end)>;
 
     struct TaskConfig {
         TaskRunFunc run = nullptr;
@@ -80,4 +81,39 @@ namespace noz {
     extern void Cancel(Task task);
     extern void AddDependency(Task task, Task dependency);
 
+    // Splits [begin, end) into chunks of grain items and runs them across the task workers.
+    // The calling thread works on chunks too and returns once every chunk has finished.
+    extern void ParallelFor(int begin, int end, int grain, const ParallelForFunc& func);
+
+    constexpr int PARALLEL_REDUCE_MAX_CHUNKS = 64;
+
+    // Maps each chunk to a partial result with map(begin, end) and folds the partials in
+    // range order with reduce(a, b), so the result does not depend on thread timing.
+    template <typename T, typename TMapFunc, typename TReduceFunc>
+    T ParallelReduce(int begin, int end, int grain, const T& identity, const TMapFunc& map, const TReduceFunc& reduce) {
+        if (end <= begin)
+            return identity;
+
+        int count = end - begin;
+        grain = grain < 1 ? 1 : grain;
+        if ((count + grain - 1) / grain > PARALLEL_REDUCE_MAX_CHUNKS)
+            grain = (count + PARALLEL_REDUCE_MAX_CHUNKS - 1) / PARALLEL_REDUCE_MAX_CHUNKS;
+
+        int chunk_count = (count + grain - 1) / grain;
+        T partials[PARALLEL_REDUCE_MAX_CHUNKS];
+        ParallelFor(0, chunk_count, 1, [&](int chunk_begin, int chunk_end) {
+            for (int chunk = chunk_begin; chunk < chunk_end; chunk++) {
+                int range_begin = begin + chunk * grain;
+                int range_end = range_begin + grain < end ? range_begin + grain : end;
+                partials[chunk] = map(range_begin, range_end);
+            }
+        });
+
+        T result = identity;
+        for (int chunk = 0; chunk < chunk_count; chunk++)
+            result = reduce(result, partials[chunk]);
+
+        return result;
+    }
+
 } // namespace noz
@@ -197,6 +197,11 @@ struct ScrollableStyle {
     ElementId id = ELEMENT_ID_NONE;
 };
 
+struct UIStats {
+    int element_count;
+    int measured_count;     // Element measures run by the last EndUI, the rest were restored from the frame before
+};
+
 // @common
 extern void BeginUI(u32 ref_width, u32 ref_height);
 extern void DrawUI();
@@ -206,6 +211,7 @@ extern bool CheckElementFlags(ElementFlags flags);
 extern ElementId GetElementId();
 extern Vec2 ScreenToElement(const Vec2& screen);
 extern Vec2 GetUISize();
+extern const UIStats& GetUIStats();
 
 // @layout
 extern void BeginCanvas(const CanvasStyle& style={});
@@ -296,6 +302,7 @@ struct TextRequest {
 };
 
 extern TextMesh* CreateTextMesh(Allocator* allocator, const TextRequest& request);
+extern int BuildTextGlyphs(const TextRequest& request, GlyphVertex* vertices, Vec2* size);  // Text space quads, room for four vertices per character, returns the quad count
 extern Vec2 MeasureText(const Text& text, Font* font, float font_size);
 extern Bounds2 MeasureText(const Text& text, Font* font, float font_size, int start, int end);
 extern Mesh* GetMesh(TextMesh* tm);
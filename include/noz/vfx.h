@@ -16,14 +16,31 @@ struct VfxHandle
     u32 version;
 };
 
+// Decides which instances lose emission first once the particle budget fills up
+enum VfxPriority {
+    VFX_PRIORITY_LOW,
+    VFX_PRIORITY_NORMAL,
+    VFX_PRIORITY_HIGH
+};
+
+struct VfxStats {
+    int particle_count;
+    int emitter_count;
+    int instance_count;
+    int emitted_count;
+    int dropped_count;  // Emissions lost because the particle capacity was exhausted
+    int thinned_count;  // Emissions skipped by the distance and budget scaling
+};
+
 // @vfx
-VfxHandle Play(Vfx* vfx, const Vec2& position, float depth=0.0f);
-VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth=0.0f);
+VfxHandle Play(Vfx* vfx, const Vec2& position, float depth=0.0f, VfxPriority priority=VFX_PRIORITY_NORMAL);
+VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth=0.0f, VfxPriority priority=VFX_PRIORITY_NORMAL);
 void Stop(const VfxHandle& handle);
 bool IsPlaying(const VfxHandle& handle);
 void ClearVfx();
 void DrawVfx();
 Bounds2 GetBounds(Vfx* vfx);
+const VfxStats& GetVfxStats();  // Counters from the last DrawVfx
 
 constexpr VfxHandle INVALID_VFX_HANDLE = { 0xFFFFFFFF, 0xFFFFFFFF };
 
@@ -13,14 +13,16 @@ extern void InitRandom();
 extern void InitUI(const ApplicationTraits* traits);
 extern void InitEvent(ApplicationTraits* traits);
 extern void InitName(ApplicationTraits* traits);
-extern void InitVfx();
+extern void InitVfx(const ApplicationTraits* traits);
 extern void InitTime();
 extern void InitRenderer(const RendererTraits* traits);
 extern void InitAllocator(ApplicationTraits* traits);
-extern void InitAudio();
+extern void InitAudio(const ApplicationTraits& traits);
 extern void InitPrefs(const ApplicationTraits& traits);
 extern void InitDebug();
 extern void UpdateTime();
+extern void UpdateAssetLoads();
+extern void UpdateAudio();
 extern void ShutdownRenderer();
 extern void ShutdownEvent();
 extern void ShutdownUI();
@@ -51,6 +53,8 @@ static ApplicationTraits g_default_traits = {
     .name = "noz",
     .title = "noz",
     .asset_paths = g_default_asset_paths,
+    .asset_pack = ASSET_PACK_NAME,
+    .asset_upload_budget = 4.0f,
     .x = -1,
     .y = -1,
     .width = 800,
@@ -66,13 +70,27 @@ static ApplicationTraits g_default_traits = {
     .max_tasks = 1024,
     .max_frame_tasks = 64,
     .max_task_worker_count = 4,
+    .max_animators = 1024,
     .http = {
         .max_requests = 128,
         .max_concurrent_requests = 4,
     },
+    .vfx = {
+        .max_particles = 65536,
+        .max_emitters = 2048,
+        .max_instances = 512,
+        .particle_budget = 49152,
+    },
+    .audio = {
+        .max_voices = 64,
+    },
     .ui_depth = F32_MAX,
     .renderer = {
         .max_frame_commands = 8192 * 2,
+        .max_frame_instances = 8192 * 2,
+        .max_frame_glyphs = 8192 * 2,
+        .frame_data_memory_size = 1 * noz::MB,
+        .frame_uniform_memory_size = 2 * noz::MB,
         .vsync = true,
         .msaa_samples = 4,
         .min_depth = -10.0f,
@@ -212,7 +230,8 @@ void InitApplication(ApplicationTraits* traits) {
     InitTime();
     noz::InitTasks(g_app.traits);
     InitTween();
-    InitAudio();
+    InitAnimators(traits);
+    InitAudio(g_app.traits);
     noz::InitHttp(g_app.traits);
 
     g_app.traits.x = GetIntPref(PREF_WINDOW_X, g_app.traits.x);
@@ -247,7 +266,7 @@ void InitWindow() {
 
     LoadRendererAssets(g_app.asset_allocator);
 
-    InitVfx();
+    InitVfx(&g_app.traits);
     InitUI(&g_app.traits);
     InitDebug();
 }
@@ -310,6 +329,7 @@ void ShutdownApplication() {
         ShutdownWindow();
 
     noz::ShutdownHttp();
+    ShutdownAnimators();
     ShutdownTween();
     noz::ShutdownTasks();
     ShutdownTime();
@@ -319,6 +339,7 @@ void ShutdownApplication() {
     ShutdownEvent();
     ShutdownName();
     ShutdownPrefs();
+    ShutdownAssets();
     ShutdownAllocator();
 }
 
@@ -364,6 +385,8 @@ bool UpdateApplication() {
     UpdateInput();
     noz::UpdateHttp();
     noz::UpdateTasks();
+    UpdateAssetLoads();
+    UpdateAudio();
 
     UpdateFPS();
 
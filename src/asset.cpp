@@ -6,6 +6,9 @@
 
 #include <filesystem>
 #include <cstring>
+#include "platform.h"
+
+extern void UploadMesh(Mesh* mesh);
 
 // @asset_registry
 static AssetTypeInfo g_asset_types[MAX_ASSET_TYPES] = {};
@@ -123,20 +126,99 @@ const char* GetExtensionFromAssetType(AssetType asset_type) {
     return nullptr;
 }
 
-static Stream* LoadAssetStream(Allocator* allocator, const Name* asset_name, AssetType asset_type) {
-    assert(asset_name);
+// @asset_pack
+struct AssetPack {
+    const u8* data;
+    u32 size;
+    const AssetPackEntry* entries;
+    u32 entry_count;
+    bool mapped;
+};
+
+static AssetPack g_asset_pack = {};
+
+u64 GetAssetPackHash(const char* name, const char* suffix) {
+    char value[MAX_NAME_LENGTH + 16];
+    int length = Format(value, sizeof(value), "%s%s", name, suffix ? suffix : "");
+    Lower(value, static_cast<u32>(length));
+    return Hash(value);
+}
 
-    std::filesystem::path asset_name_path = std::filesystem::path(ToString(asset_type)) / asset_name->value;
+static void UnmountAssetPack() {
+    if (g_asset_pack.mapped)
+        PlatformUnmapFile(g_asset_pack.data, g_asset_pack.size);
 
-#ifdef NOZ_PLATFORM_GLES
-    if (asset_type == ASSET_TYPE_SHADER) {
-        asset_name_path += ".gles";
+    g_asset_pack = {};
+}
+
+bool MountAssetPack(const u8* data, u32 size) {
+    assert(data);
+
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (size < sizeof(AssetPackHeader) ||
+        header->signature != ASSET_PACK_SIGNATURE ||
+        header->version != ASSET_PACK_VERSION ||
+        sizeof(AssetPackHeader) + static_cast<u64>(header->entry_count) * sizeof(AssetPackEntry) > size)
+        return false;
+
+    UnmountAssetPack();
+    g_asset_pack.data = data;
+    g_asset_pack.size = size;
+    g_asset_pack.entries = reinterpret_cast<const AssetPackEntry*>(data + sizeof(AssetPackHeader));
+    g_asset_pack.entry_count = header->entry_count;
+    return true;
+}
+
+static bool MountAssetPack(const std::filesystem::path& path) {
+    u32 size = 0;
+    const u8* data = PlatformMapFile(path, &size);
+    if (!data)
+        return false;
+
+    if (!MountAssetPack(data, size)) {
+        LogWarning("invalid asset pack '%s'", path.string().c_str());
+        PlatformUnmapFile(data, size);
+        return false;
     }
+
+    g_asset_pack.mapped = true;
+    return true;
+}
+
+static const AssetPackEntry* FindAssetPackEntry(const Name* asset_name, AssetType asset_type, const char* suffix) {
+    AssetPackEntry key = {};
+    key.name_hash = GetAssetPackHash(asset_name->value, suffix);
+    key.type = static_cast<u32>(asset_type);
+
+    const AssetPackEntry* end = g_asset_pack.entries + g_asset_pack.entry_count;
+    const AssetPackEntry* entry = std::lower_bound(g_asset_pack.entries, end, key);
+    if (entry == end || entry->name_hash != key.name_hash || entry->type != key.type)
+        return nullptr;
+
+    if (static_cast<u64>(entry->offset) + entry->size > g_asset_pack.size)
+        return nullptr;
+
+    return entry;
+}
+
+static const char* GetAssetVariantSuffix(AssetType asset_type) {
+#ifdef NOZ_PLATFORM_GLES
+    if (asset_type == ASSET_TYPE_SHADER)
+        return ".gles";
 #elif NOZ_PLATFORM_GL
-    if (asset_type == ASSET_TYPE_SHADER) {
-        asset_name_path += ".glsl";
-    }
+    if (asset_type == ASSET_TYPE_SHADER)
+        return ".glsl";
 #endif
+    (void)asset_type;
+    return nullptr;
+}
+
+static Stream* LoadAssetFileStream(Allocator* allocator, const Name* asset_name, AssetType asset_type) {
+    assert(asset_name);
+
+    std::filesystem::path asset_name_path = std::filesystem::path(ToString(asset_type)) / asset_name->value;
+    if (const char* suffix = GetAssetVariantSuffix(asset_type))
+        asset_name_path += suffix;
 
     std::string lower_asset_name_path = asset_name_path.string();
     Lower(lower_asset_name_path.data(), (u32)lower_asset_name_path.size());
@@ -155,6 +237,30 @@ static Stream* LoadAssetStream(Allocator* allocator, const Name* asset_name, Ass
     return nullptr;
 }
 
+// Packed assets are read in place from the mapping, anything missing from the pack falls
+// back to the loose files so a partial pack still works during development.
+static Stream* LoadAssetStream(Allocator* allocator, const Name* asset_name, AssetType asset_type) {
+    assert(asset_name);
+
+    if (g_asset_pack.data) {
+        const AssetPackEntry* entry = FindAssetPackEntry(asset_name, asset_type, GetAssetVariantSuffix(asset_type));
+        if (entry && entry->size > 0 && entry->raw_size > 0) {
+            Stream* stream = CreateStream(allocator, entry->raw_size, entry->raw_size);
+            if (stream && Decompress(g_asset_pack.data + entry->offset, entry->size, GetData(stream), entry->raw_size))
+                return stream;
+
+            LogWarning("failed to decompress packed asset '%s'", asset_name->value);
+            Free(stream);
+            return nullptr;
+        }
+
+        if (entry && entry->size > 0)
+            return CreateReadOnlyStream(allocator, g_asset_pack.data + entry->offset, entry->size);
+    }
+
+    return LoadAssetFileStream(allocator, asset_name, asset_type);
+}
+
 const Name** ReadNameTable(const AssetHeader& header, Stream* stream) {
     const Name** name_table = nullptr;
     if (header.names > 0)
@@ -167,18 +273,19 @@ const Name** ReadNameTable(const AssetHeader& header, Stream* stream) {
     return name_table;
 }
 
+// The stream stays owned by the caller, including when the header is rejected
 Asset* LoadAssetInternal(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoaderFunc loader, Stream* stream) {
     AssetHeader header = {};
-    if (!ReadAssetHeader(stream, &header) || !ValidateAssetHeader(&header, asset_type)) {
-        Free(stream);
+    if (!ReadAssetHeader(stream, &header) || !ValidateAssetHeader(&header, asset_type))
         return nullptr;
-    }
 
     const Name** name_table = ReadNameTable(header, stream);
 
     Asset* asset = loader(allocator, stream, &header, asset_name, name_table);
-    asset->flags = header.flags;
-    asset->type = header.type;
+    if (asset) {
+        asset->flags = header.flags;
+        asset->type = header.type;
+    }
 
     Free(name_table);
 
@@ -187,7 +294,7 @@ Asset* LoadAssetInternal(Allocator* allocator, const Name* asset_name, AssetType
 
 Asset* LoadAssetInternal(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoaderFunc loader, const u8* data, u32 data_size) {
     Stream* stream = data != nullptr
-        ? LoadStream(ALLOCATOR_DEFAULT, data, data_size)
+        ? CreateReadOnlyStream(ALLOCATOR_DEFAULT, data, data_size)
         : LoadAssetStream(ALLOCATOR_DEFAULT, asset_name, asset_type);
 
     if (!stream)
@@ -211,6 +318,125 @@ Asset* LoadAsset(Allocator* allocator, const Name* asset_name, AssetType asset_t
     return asset;
 }
 
+// @async
+struct AssetLoadRequest {
+    Allocator* allocator;
+    const Name* name;
+    AssetType type;
+    const AssetTypeInfo* info;
+    AssetLoadCallback callback;
+    void* user_data;
+    Stream* stream;
+    Asset* asset;
+    bool parsed;
+    AssetLoadRequest* next;
+};
+
+struct AssetLoadQueue {
+    AssetLoadRequest* first;
+    AssetLoadRequest* last;
+    int pending_count;
+};
+
+static AssetLoadQueue g_asset_loads = {};
+
+static void* RunAssetLoad(AssetLoadRequest* request) {
+    request->stream = LoadAssetStream(ALLOCATOR_DEFAULT, request->name, request->type);
+    if (!request->stream)
+        return noz::TASK_NO_RESULT;
+
+    bool worker_allocator = request->allocator == nullptr || request->allocator == ALLOCATOR_DEFAULT;
+    if (request->info->main_thread || !worker_allocator)
+        return noz::TASK_NO_RESULT;
+
+    request->asset = LoadAssetInternal(request->allocator, request->name, request->type, request->info->loader, request->stream);
+    request->parsed = true;
+    Free(request->stream);
+    request->stream = nullptr;
+    return noz::TASK_NO_RESULT;
+}
+
+static void QueueAssetUpload(AssetLoadRequest* request) {
+    if (g_asset_loads.last)
+        g_asset_loads.last->next = request;
+    else
+        g_asset_loads.first = request;
+
+    g_asset_loads.last = request;
+}
+
+bool LoadAssetAsync(Allocator* allocator, const Name* asset_name, AssetType asset_type, AssetLoadCallback callback, void* user_data) {
+    const AssetTypeInfo* info = GetAssetTypeInfo(asset_type);
+    if (!asset_name || !info || !info->loader)
+        return false;
+
+    AssetLoadRequest* request = static_cast<AssetLoadRequest*>(Alloc(ALLOCATOR_DEFAULT, sizeof(AssetLoadRequest)));
+    request->allocator = allocator;
+    request->name = asset_name;
+    request->type = asset_type;
+    request->info = info;
+    request->callback = callback;
+    request->user_data = user_data;
+
+    noz::Task task = noz::CreateTask({
+        .run = [request](noz::Task) -> void* { return RunAssetLoad(request); },
+        .complete = [request](noz::Task, void*) { QueueAssetUpload(request); },
+        .name = "load_asset",
+    });
+
+    if (!task) {
+        Free(request);
+        return false;
+    }
+
+    g_asset_loads.pending_count++;
+    return true;
+}
+
+int GetPendingAssetLoadCount() {
+    return g_asset_loads.pending_count;
+}
+
+static void FinishAssetLoad(AssetLoadRequest* request) {
+    if (!request->parsed && request->stream) {
+        PushScratch();
+        request->asset = LoadAssetInternal(request->allocator, request->name, request->type, request->info->loader, request->stream);
+        PopScratch();
+    }
+
+    Free(request->stream);
+
+    if (request->asset && request->info->upload && !request->info->upload(request->asset)) {
+        LogWarning("failed to upload asset '%s'", request->name->value);
+        Free(request->asset);
+        request->asset = nullptr;
+    }
+
+    g_asset_loads.pending_count--;
+    if (request->callback)
+        request->callback(request->asset, request->user_data);
+
+    Free(request);
+}
+
+// Finish queued loads until the frame budget is spent, always at least one so a long
+// upload cannot stall the queue
+void UpdateAssetLoads() {
+    if (!g_asset_loads.first)
+        return;
+
+    u64 start = PlatformGetTimeCounter();
+    u64 budget = static_cast<u64>(GetApplicationTraits()->asset_upload_budget * 0.001 * static_cast<double>(PlatformGetTimeFrequency()));
+    do {
+        AssetLoadRequest* request = g_asset_loads.first;
+        g_asset_loads.first = request->next;
+        if (!g_asset_loads.first)
+            g_asset_loads.last = nullptr;
+
+        FinishAssetLoad(request);
+    } while (g_asset_loads.first && PlatformGetTimeCounter() - start < budget);
+}
+
 #if !defined(NOZ_BUILTIN_ASSETS)
 
 void ReloadAsset(const Name* name, AssetType asset_type, Asset* asset, void (*reload)(Asset*, Stream*, const AssetHeader& header, const Name** name_table)) {
@@ -219,7 +445,8 @@ void ReloadAsset(const Name* name, AssetType asset_type, Asset* asset, void (*re
 
     assert(name);
 
-    Stream* stream = LoadAssetStream(ALLOCATOR_DEFAULT, name, asset_type);
+    // Always reload from the loose file, the pack holds whatever was built last
+    Stream* stream = LoadAssetFileStream(ALLOCATOR_DEFAULT, name, asset_type);
     if (!stream)
         return;
 
@@ -238,43 +465,52 @@ void ReloadAsset(const Name* name, AssetType asset_type, Asset* asset, void (*re
 
 #endif
 
+static bool UploadMeshAsset(Asset* asset) {
+    UploadMesh(static_cast<Mesh*>(asset));
+    return true;
+}
+
 void InitAssets() {
     // Register all built-in asset types with the registry
     RegisterAssetType({ASSET_TYPE_MESH, "Mesh", "Mesh", ".mesh", LoadMesh,
 #if !defined(NOZ_BUILTIN_ASSETS)
-        ReloadMesh
+        ReloadMesh,
 #else
-        nullptr
+        nullptr,
 #endif
+        UploadMeshAsset
     });
     RegisterAssetType({ASSET_TYPE_VFX, "Vfx", "Vfx", ".vfx", LoadVfx,
 #if !defined(NOZ_BUILTIN_ASSETS)
-        ReloadVfx
+        ReloadVfx,
 #else
-        nullptr
+        nullptr,
 #endif
+        UploadVfx
     });
     RegisterAssetType({ASSET_TYPE_SKELETON, "Skeleton", "Skeleton", ".skeleton", LoadSkeleton, nullptr});
     RegisterAssetType({ASSET_TYPE_ANIMATION, "Animation", "Animation", ".animation", LoadAnimation, nullptr});
     RegisterAssetType({ASSET_TYPE_SOUND, "Sound", "Sound", ".sound", LoadSound, nullptr});
     RegisterAssetType({ASSET_TYPE_TEXTURE, "Texture", "Texture", ".texture", LoadTexture,
 #if !defined(NOZ_BUILTIN_ASSETS)
-        ReloadTexture
+        ReloadTexture,
 #else
-        nullptr
+        nullptr,
 #endif
+        UploadTexture
     });
-    RegisterAssetType({ASSET_TYPE_FONT, "Font", "Font", ".font", LoadFont, nullptr});
+    RegisterAssetType({ASSET_TYPE_FONT, "Font", "Font", ".font", LoadFont, nullptr, UploadFont});
     RegisterAssetType({ASSET_TYPE_SHADER, "Shader", "Shader", ".shader", LoadShader,
 #if !defined(NOZ_BUILTIN_ASSETS)
-        ReloadShader
+        ReloadShader,
 #else
-        nullptr
+        nullptr,
 #endif
+        UploadShader
     });
     RegisterAssetType({ASSET_TYPE_EVENT, "Event", "Event", ".event", nullptr, nullptr});
     RegisterAssetType({ASSET_TYPE_BIN, "Bin", "Bin", ".bin", LoadBin, nullptr});
-    RegisterAssetType({ASSET_TYPE_ATLAS, "Atlas", "Atlas", ".atlas", LoadTexture, nullptr});
+    RegisterAssetType({ASSET_TYPE_ATLAS, "Atlas", "Atlas", ".atlas", LoadTexture, nullptr, UploadTexture});
 
 #if defined(NOZ_LUA)
     RegisterAssetType({ASSET_TYPE_LUA, "Script", "Lua", ".lua", LoadLuaScript,
@@ -285,4 +521,24 @@ void InitAssets() {
 #endif
     });
 #endif
+
+    const ApplicationTraits* traits = GetApplicationTraits();
+    if (traits->asset_pack && traits->asset_paths) {
+        for (int i = 0; traits->asset_paths[i] != nullptr; i++)
+            if (MountAssetPack(std::filesystem::path(traits->asset_paths[i]) / traits->asset_pack))
+                break;
+    }
+}
+
+void ShutdownAssets() {
+    // Tasks are shut down by now, anything still queued is dropped without its callback
+    while (AssetLoadRequest* request = g_asset_loads.first) {
+        g_asset_loads.first = request->next;
+        Free(request->stream);
+        Free(request);
+    }
+
+    g_asset_loads = {};
+
+    UnmountAssetPack();
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+static const i8 g_adpcm_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const i16 g_adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+i32 GetAdpcmStep(const AdpcmState& state) {
+    return g_adpcm_step_table[state.step_index];
+}
+
+i16 DecodeAdpcm(AdpcmState* state, u8 code) {
+    i32 step = g_adpcm_step_table[state->step_index];
+    i32 diff = step >> 3;
+    if (code & 4) diff += step;
+    if (code & 2) diff += step >> 1;
+    if (code & 1) diff += step >> 2;
+
+    state->predictor = Clamp(state->predictor + ((code & 8) ? -diff : diff), -32768, 32767);
+    state->step_index = Clamp(state->step_index + g_adpcm_index_table[code & 15], 0, 88);
+    return static_cast<i16>(state->predictor);
+}
+
+// Writes every stride samples so a channel block decodes straight into interleaved frames
+void DecodeAdpcmBlock(const u8* block, u32 frame_count, i16* out, u32 stride) {
+    if (frame_count == 0)
+        return;
+
+    AdpcmState state = {
+        .predictor = static_cast<i16>(block[0] | (block[1] << 8)),
+        .step_index = Clamp(static_cast<i32>(block[2]), 0, 88)
+    };
+
+    out[0] = static_cast<i16>(state.predictor);
+
+    const u8* codes = block + 4;
+    for (u32 i = 1; i < frame_count; i++) {
+        u8 code = codes[(i - 1) >> 1];
+        out[i * stride] = DecodeAdpcm(&state, (i - 1) & 1 ? code >> 4 : code & 15);
+    }
+}
@@ -4,60 +4,42 @@
 
 #include "noz/noz.h"
 #include "../platform.h"
+#include "../internal.h"
 
-extern void PlayMusicInternal(Sound* sound);
+extern void PlayMusicInternal(Sound* sound, bool loop);
 
-void SetMasterVolume(float volume) {
-    PlatformSetMasterVolume(volume);
-}
-
-float GetMasterVolume() {
-    return PlatformGetMasterVolume();
-}
-
-void SetSoundVolume(float volume) {
-    PlatformSetSoundVolume(volume);
-}
-
-float GetSoundVolume() {
-    return PlatformGetSoundVolume();
-}
-
-void SetMusicVolume(float volume) {
-    PlatformSetMusicVolume(volume);
-}
-
-float GetMusicVolume() {
-    return PlatformGetMusicVolume();
-}
-
-void PlayMusic(Sound* sound) {
+void PlayMusic(Sound* sound, bool loop) {
     if (IsMusicPlaying())
         StopMusic();
 
-    PlayMusicInternal(sound);
+    PlayMusicInternal(sound, loop);
 }
 
 void StopMusic() {
-    if (!IsMusicPlaying())
-        return;
-
-    PlatformStopMusic();
+    StopMixerMusic();
+    StopMusicStream();
 }
 
 bool IsMusicPlaying() {
-    return PlatformIsMusicPlaying();
+    return IsMixerMusicPlaying();
 }
 
 void Stop(const SoundHandle& handle) {
-    PlatformStopSound({handle.value});
+    StopMixerSound(handle);
 }
 
-void InitAudio() {
+void InitAudio(const ApplicationTraits& traits) {
+    InitMixer(traits);
     PlatformInitAudio();
 }
 
+void UpdateAudio() {
+    UpdateMusicStream();
+    PlatformUpdateAudio();
+}
+
 void ShutdownAudio() {
     StopMusic();
     PlatformShutdownAudio();
+    ShutdownMixer();
 }
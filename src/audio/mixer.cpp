@@ -0,0 +1,478 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Software mixer shared by every platform.  Sounds stay 16 bit and voices are converted and
+//  resampled for pitch into a per voice float scratch block, scaled by their voice and bus
+//  volumes into planar left and right buffers, then clamped and interleaved into the float
+//  stereo buffer the platform sink asked for.
+//
+
+#include "noz/noz.h"
+#include "../platform.h"
+#include "../internal.h"
+#include "../math/simd.h"
+#include <mutex>
+
+constexpr u32 MIXER_BLOCK_FRAMES = 256;
+constexpr u32 MIXER_STREAM_FRAMES = MIXER_BLOCK_FRAMES * 2 + 8;   // Window for a stream at up to twice the output rate
+constexpr float MIXER_MIN_PITCH = 0.5f;
+constexpr float MIXER_MAX_PITCH = 2.0f;
+
+struct MixerSound {
+    u32 sample_rate;
+    u32 channels;
+    u32 frame_count;
+    i16* samples[2];        // Planar
+};
+
+struct MixerVoice {
+    MixerSound* sound;
+    double position;        // In source frames
+    float volume;
+    float pitch;
+    float gain;             // Gain applied at the end of the last block, ramped toward the target
+    bool loop;
+    u32 generation;
+    u64 sequence;           // Start order, the oldest of the quietest voices is stolen first
+};
+
+struct MixerMusic {
+    MixerVoice voice;
+    bool streaming;
+    u32 stream_rate;
+    u32 stream_channels;
+    float stream_position;  // In frames from the start of the stream window
+    u32 stream_count;       // Frames held in the stream window
+    i16 stream_window[2][MIXER_STREAM_FRAMES];
+};
+
+struct Mixer {
+    std::mutex mutex;
+    MixerVoice* voices;
+    u32 voice_count;
+    u64 sequence;
+    MixerMusic music;
+    float master_volume;
+    float sound_volume;
+    float music_volume;
+    AudioStats stats;
+    float left[MIXER_BLOCK_FRAMES];
+    float right[MIXER_BLOCK_FRAMES];
+    float scratch[2][MIXER_BLOCK_FRAMES];
+};
+
+static Mixer g_mixer;
+
+static u32 GetVoiceIndex(const SoundHandle& handle) {
+    return static_cast<u32>(handle.value & 0xFFFFFFFF);
+}
+
+static u32 GetVoiceGeneration(const SoundHandle& handle) {
+    return static_cast<u32>(handle.value >> 32);
+}
+
+static MixerVoice* GetVoice(const SoundHandle& handle) {
+    u32 index = GetVoiceIndex(handle);
+    if (index >= g_mixer.voice_count)
+        return nullptr;
+
+    MixerVoice& voice = g_mixer.voices[index];
+    if (!voice.sound || voice.generation != GetVoiceGeneration(handle))
+        return nullptr;
+
+    return &voice;
+}
+
+constexpr float MIXER_SAMPLE_SCALE = 1.0f / 32768.0f;
+
+static float GetSample(const i16* src, u32 index, u32 available, i16 tail) {
+    return static_cast<float>(index < available ? src[index] : tail);
+}
+
+// Converts count 16 bit samples to float, still in 16 bit units until MixSamples scales them
+static void Convert(const i16* src, float* out, u32 count) {
+    for (u32 i = 0; i < count; i++)
+        out[i] = static_cast<float>(src[i]);
+}
+
+// Linear interpolation of count float frames starting frac into the 16 bit src, stepping step
+// source frames each.  Frames past the available ones read as tail, a looping voice passes its
+// first frame so the seam blends into the start rather than into silence.
+static void Resample(const i16* src, u32 available, i16 tail, float frac, float step, float* out, u32 count) {
+    u32 i = 0;
+    f32x4 offsets = Set4(frac, frac + step, frac + step * 2.0f, frac + step * 3.0f);
+    f32x4 advance = Set4(step * 4.0f);
+
+    // Only the last frames before the end of src can read past it, with a frame of slack for
+    // the rounding of the stepped positions
+    float inside = (static_cast<float>(available) - 2.0f - frac) / step;
+    u32 unchecked = inside > 0.0f ? Min(static_cast<u32>(inside), count) : 0;
+    for (; i + 4 <= count; i += 4) {
+        float positions[4];
+        Store4(positions, offsets);
+
+        float a[4];
+        float b[4];
+        float t[4];
+        if (i + 4 <= unchecked) {
+            for (int k = 0; k < 4; k++) {
+                u32 index = static_cast<u32>(positions[k]);
+                a[k] = src[index];
+                b[k] = src[index + 1];
+                t[k] = positions[k] - static_cast<float>(index);
+            }
+        } else {
+            for (int k = 0; k < 4; k++) {
+                u32 index = static_cast<u32>(positions[k]);
+                a[k] = GetSample(src, index, available, tail);
+                b[k] = GetSample(src, index + 1, available, tail);
+                t[k] = positions[k] - static_cast<float>(index);
+            }
+        }
+
+        Store4(out + i, Mix4(Load4(a), Load4(b), Load4(t)));
+        offsets = Add4(offsets, advance);
+    }
+
+    for (; i < count; i++) {
+        float position = frac + step * static_cast<float>(i);
+        u32 index = static_cast<u32>(position);
+        float t = position - static_cast<float>(index);
+        float a = GetSample(src, index, available, tail);
+        float b = GetSample(src, index + 1, available, tail);
+        out[i] = a + (b - a) * t;
+    }
+}
+
+// Adds src scaled by a gain ramping linearly from gain to gain + delta * count
+static void Accumulate(const float* src, float gain, float delta, float* out, u32 count) {
+    u32 i = 0;
+    f32x4 gains = Set4(gain, gain + delta, gain + delta * 2.0f, gain + delta * 3.0f);
+    f32x4 advance = Set4(delta * 4.0f);
+    for (; i + 4 <= count; i += 4) {
+        Store4(out + i, Add4(Load4(out + i), Mul4(Load4(src + i), gains)));
+        gains = Add4(gains, advance);
+    }
+
+    for (; i < count; i++)
+        out[i] += src[i] * (gain + delta * static_cast<float>(i));
+}
+
+// Channels hold samples in 16 bit units, the conversion to -1..1 rides along with the gain
+static void MixSamples(const float* const* channels, u32 channel_count, float gain, float delta, u32 offset, u32 count) {
+    gain *= MIXER_SAMPLE_SCALE;
+    delta *= MIXER_SAMPLE_SCALE;
+    Accumulate(channels[0], gain, delta, g_mixer.left + offset, count);
+    Accumulate(channels[channel_count > 1 ? 1 : 0], gain, delta, g_mixer.right + offset, count);
+}
+
+// Mixes count frames of a voice into the block, returns false once a one shot voice has ended
+static bool MixVoice(MixerVoice& voice, float target_gain, u32 count) {
+    MixerSound* sound = voice.sound;
+    float step = voice.pitch * static_cast<float>(sound->sample_rate) / static_cast<float>(AUDIO_SAMPLE_RATE);
+    float delta = (target_gain - voice.gain) / static_cast<float>(count);
+
+    u32 offset = 0;
+    while (offset < count) {
+        u32 base = static_cast<u32>(voice.position);
+        float frac = static_cast<float>(voice.position - base);
+        u32 remaining = static_cast<u32>(ceil((sound->frame_count - voice.position) / step));
+        u32 frames = Min(count - offset, Max(remaining, 1u));
+
+        const float* channels[2];
+        for (u32 c = 0; c < sound->channels; c++) {
+            const i16* samples = sound->samples[c];
+            if (step == 1.0f && frac == 0.0f)
+                Convert(samples + base, g_mixer.scratch[c], frames);
+            else
+                Resample(samples + base, sound->frame_count - base, voice.loop ? samples[0] : 0, frac, step, g_mixer.scratch[c], frames);
+            channels[c] = g_mixer.scratch[c];
+        }
+
+        MixSamples(channels, sound->channels, voice.gain + delta * offset, delta, offset, frames);
+        offset += frames;
+        voice.position += static_cast<double>(frames) * step;
+
+        if (voice.position >= sound->frame_count) {
+            if (!voice.loop)
+                return false;
+
+            voice.position = fmod(voice.position, static_cast<double>(sound->frame_count));
+        }
+    }
+
+    voice.gain = target_gain;
+    return true;
+}
+
+// Streamed music is pulled from the music stream into a sliding window and resampled from there
+static void MixMusicStream(MixerMusic& music, float target_gain, u32 count) {
+    float step = static_cast<float>(music.stream_rate) / static_cast<float>(AUDIO_SAMPLE_RATE);
+    u32 required = static_cast<u32>(music.stream_position + step * count) + 2;
+    u32 channel_count = music.stream_channels;
+    bool ended = false;
+    if (music.stream_count < required) {
+        i16 samples[MIXER_STREAM_FRAMES * 2];
+        u32 read = required - music.stream_count;
+        ended = ReadMusicStream(samples, read, channel_count) < read && !IsMusicStreamPlaying();
+        for (u32 c = 0; c < channel_count; c++)
+            for (u32 i = 0; i < read; i++)
+                music.stream_window[c][music.stream_count + i] = samples[i * channel_count + c];
+        music.stream_count = required;
+    }
+
+    u32 base = static_cast<u32>(music.stream_position);
+    const float* channels[2];
+    for (u32 c = 0; c < channel_count; c++) {
+        Resample(music.stream_window[c] + base, music.stream_count - base, 0, music.stream_position - base, step, g_mixer.scratch[c], count);
+        channels[c] = g_mixer.scratch[c];
+    }
+
+    MixSamples(channels, channel_count, music.voice.gain, (target_gain - music.voice.gain) / static_cast<float>(count), 0, count);
+    music.voice.gain = target_gain;
+
+    // Slide the window so it starts at the frame under the read position
+    music.stream_position += step * count;
+    u32 consumed = static_cast<u32>(music.stream_position);
+    for (u32 c = 0; c < channel_count; c++)
+        memmove(music.stream_window[c], music.stream_window[c] + consumed, (music.stream_count - consumed) * sizeof(i16));
+    music.stream_count -= consumed;
+    music.stream_position -= static_cast<float>(consumed);
+
+    // A track that is not looping stops once its last frames have been mixed
+    if (ended)
+        music.streaming = false;
+}
+
+static void MixBlock(float* out, u32 count) {
+    memset(g_mixer.left, 0, sizeof(g_mixer.left));
+    memset(g_mixer.right, 0, sizeof(g_mixer.right));
+
+    float sound_gain = g_mixer.master_volume * g_mixer.sound_volume;
+    for (u32 i = 0; i < g_mixer.voice_count; i++) {
+        MixerVoice& voice = g_mixer.voices[i];
+        if (voice.sound && !MixVoice(voice, voice.volume * sound_gain, count))
+            voice.sound = nullptr;
+    }
+
+    MixerMusic& music = g_mixer.music;
+    float music_gain = g_mixer.master_volume * g_mixer.music_volume;
+    if (music.streaming)
+        MixMusicStream(music, music_gain, count);
+    else if (music.voice.sound && !MixVoice(music.voice, music_gain, count))
+        music.voice.sound = nullptr;
+
+    u32 i = 0;
+    f32x4 lo = Set4(-1.0f);
+    f32x4 hi = Set4(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        f32x4 left = Min4(Max4(Load4(g_mixer.left + i), lo), hi);
+        f32x4 right = Min4(Max4(Load4(g_mixer.right + i), lo), hi);
+        Store4(out + i * 2, InterleaveLow4(left, right));
+        Store4(out + i * 2 + 4, InterleaveHigh4(left, right));
+    }
+
+    for (; i < count; i++) {
+        out[i * 2] = Clamp(g_mixer.left[i], -1.0f, 1.0f);
+        out[i * 2 + 1] = Clamp(g_mixer.right[i], -1.0f, 1.0f);
+    }
+}
+
+void MixAudio(float* out, u32 frame_count) {
+    std::lock_guard lock(g_mixer.mutex);
+    if (!g_mixer.voices) {
+        memset(out, 0, frame_count * AUDIO_CHANNELS * sizeof(float));
+        return;
+    }
+
+    for (u32 offset = 0; offset < frame_count; offset += MIXER_BLOCK_FRAMES)
+        MixBlock(out + offset * AUDIO_CHANNELS, Min(MIXER_BLOCK_FRAMES, frame_count - offset));
+
+    int active = 0;
+    for (u32 i = 0; i < g_mixer.voice_count; i++)
+        active += g_mixer.voices[i].sound != nullptr;
+
+    g_mixer.stats.voice_count = active;
+    g_mixer.stats.mixed_frames += frame_count;
+}
+
+MixerSound* CreateMixerSound(const void* data, u32 data_size, u32 sample_rate, u32 channels, u32 bits_per_sample) {
+    if (channels < 1 || channels > 2 || (bits_per_sample != 8 && bits_per_sample != 16)) {
+        LogError("[AUDIO] unsupported sound format (%u channels, %u bits)", channels, bits_per_sample);
+        return nullptr;
+    }
+
+    u32 frame_count = data_size / (channels * bits_per_sample / 8);
+    MixerSound* sound = static_cast<MixerSound*>(Alloc(ALLOCATOR_DEFAULT, sizeof(MixerSound) + channels * frame_count * sizeof(i16)));
+    sound->sample_rate = sample_rate;
+    sound->channels = channels;
+    sound->frame_count = frame_count;
+
+    const u8* bytes = static_cast<const u8*>(data);
+    for (u32 c = 0; c < channels; c++) {
+        i16* samples = reinterpret_cast<i16*>(sound + 1) + c * frame_count;
+        sound->samples[c] = samples;
+        for (u32 i = 0; i < frame_count; i++) {
+            u32 sample = i * channels + c;
+            if (bits_per_sample == 8)
+                samples[i] = static_cast<i16>((static_cast<i32>(bytes[sample]) - 128) << 8);
+            else
+                samples[i] = static_cast<i16>(bytes[sample * 2] | (bytes[sample * 2 + 1] << 8));
+        }
+    }
+
+    return sound;
+}
+
+SoundHandle PlayMixerSound(MixerSound* sound, float volume, float pitch, bool loop) {
+    std::lock_guard lock(g_mixer.mutex);
+    if (!sound || sound->frame_count == 0 || g_mixer.voice_count == 0)
+        return { static_cast<u64>(0xFFFFFFFF) << 32 };
+
+    // Take a free voice, otherwise steal the oldest of the quietest
+    u32 index = 0;
+    MixerVoice* steal = nullptr;
+    for (; index < g_mixer.voice_count; index++) {
+        MixerVoice& voice = g_mixer.voices[index];
+        if (!voice.sound)
+            break;
+
+        if (!steal || voice.volume < steal->volume || (voice.volume == steal->volume && voice.sequence < steal->sequence))
+            steal = &voice;
+    }
+
+    if (index == g_mixer.voice_count) {
+        index = static_cast<u32>(steal - g_mixer.voices);
+        g_mixer.stats.stolen_count++;
+    }
+
+    MixerVoice& voice = g_mixer.voices[index];
+    voice.sound = sound;
+    voice.position = 0.0;
+    voice.volume = Clamp(volume, 0.0f, 1.0f);
+    voice.pitch = Clamp(pitch, MIXER_MIN_PITCH, MIXER_MAX_PITCH);
+    voice.gain = voice.volume * g_mixer.master_volume * g_mixer.sound_volume;
+    voice.loop = loop;
+    voice.sequence = g_mixer.sequence++;
+    return { (static_cast<u64>(++voice.generation) << 32) | index };
+}
+
+void StopMixerSound(const SoundHandle& handle) {
+    std::lock_guard lock(g_mixer.mutex);
+    if (MixerVoice* voice = GetVoice(handle))
+        voice->sound = nullptr;
+}
+
+bool IsMixerSoundPlaying(const SoundHandle& handle) {
+    std::lock_guard lock(g_mixer.mutex);
+    return GetVoice(handle) != nullptr;
+}
+
+void SetMixerSoundVolume(const SoundHandle& handle, float volume) {
+    std::lock_guard lock(g_mixer.mutex);
+    if (MixerVoice* voice = GetVoice(handle))
+        voice->volume = Clamp(volume, 0.0f, 1.0f);
+}
+
+void SetMixerSoundPitch(const SoundHandle& handle, float pitch) {
+    std::lock_guard lock(g_mixer.mutex);
+    if (MixerVoice* voice = GetVoice(handle))
+        voice->pitch = Clamp(pitch, MIXER_MIN_PITCH, MIXER_MAX_PITCH);
+}
+
+float GetMixerSoundVolume(const SoundHandle& handle) {
+    std::lock_guard lock(g_mixer.mutex);
+    MixerVoice* voice = GetVoice(handle);
+    return voice ? voice->volume : 1.0f;
+}
+
+float GetMixerSoundPitch(const SoundHandle& handle) {
+    std::lock_guard lock(g_mixer.mutex);
+    MixerVoice* voice = GetVoice(handle);
+    return voice ? voice->pitch : 1.0f;
+}
+
+void PlayMixerMusic(MixerSound* sound, bool loop) {
+    std::lock_guard lock(g_mixer.mutex);
+    MixerMusic& music = g_mixer.music;
+    music.streaming = false;
+    music.voice = {};
+    music.voice.sound = sound;
+    music.voice.volume = 1.0f;
+    music.voice.pitch = 1.0f;
+    music.voice.loop = loop;
+    music.voice.gain = g_mixer.master_volume * g_mixer.music_volume;
+}
+
+void PlayMixerMusicStream(u32 sample_rate, u32 channels) {
+    std::lock_guard lock(g_mixer.mutex);
+    MixerMusic& music = g_mixer.music;
+    music.voice = {};
+    music.voice.gain = g_mixer.master_volume * g_mixer.music_volume;
+    music.streaming = true;
+    music.stream_rate = Min(sample_rate, AUDIO_SAMPLE_RATE * 2);
+    music.stream_channels = Clamp(channels, 1u, 2u);
+    music.stream_position = 0.0f;
+    music.stream_count = 0;
+}
+
+void StopMixerMusic() {
+    std::lock_guard lock(g_mixer.mutex);
+    g_mixer.music.streaming = false;
+    g_mixer.music.voice.sound = nullptr;
+}
+
+bool IsMixerMusicPlaying() {
+    std::lock_guard lock(g_mixer.mutex);
+    return g_mixer.music.streaming || g_mixer.music.voice.sound != nullptr;
+}
+
+void SetMasterVolume(float volume) {
+    std::lock_guard lock(g_mixer.mutex);
+    g_mixer.master_volume = Clamp(volume, 0.0f, 1.0f);
+}
+
+void SetSoundVolume(float volume) {
+    std::lock_guard lock(g_mixer.mutex);
+    g_mixer.sound_volume = Clamp(volume, 0.0f, 1.0f);
+}
+
+void SetMusicVolume(float volume) {
+    std::lock_guard lock(g_mixer.mutex);
+    g_mixer.music_volume = Clamp(volume, 0.0f, 1.0f);
+}
+
+float GetMasterVolume() {
+    return g_mixer.master_volume;
+}
+
+float GetSoundVolume() {
+    return g_mixer.sound_volume;
+}
+
+float GetMusicVolume() {
+    return g_mixer.music_volume;
+}
+
+const AudioStats& GetAudioStats() {
+    return g_mixer.stats;
+}
+
+void InitMixer(const ApplicationTraits& traits) {
+    std::lock_guard lock(g_mixer.mutex);
+    g_mixer.voice_count = Max(traits.audio.max_voices, 1u);
+    g_mixer.voices = static_cast<MixerVoice*>(Alloc(ALLOCATOR_DEFAULT, sizeof(MixerVoice) * g_mixer.voice_count));
+    g_mixer.master_volume = 1.0f;
+    g_mixer.sound_volume = 1.0f;
+    g_mixer.music_volume = 1.0f;
+    g_mixer.stats = {};
+}
+
+void ShutdownMixer() {
+    std::lock_guard lock(g_mixer.mutex);
+    Free(g_mixer.voices);
+    g_mixer.voices = nullptr;
+    g_mixer.voice_count = 0;
+    g_mixer.music.streaming = false;
+    g_mixer.music.voice = {};
+}
@@ -0,0 +1,198 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Streamed music is decoded a block at a time into a small ring on a worker task and pulled
+//  out by the mixer on the audio thread, so a long track never exists as PCM in memory.
+//
+
+#include "noz/noz.h"
+#include "../platform.h"
+#include "../internal.h"
+#include <mutex>
+
+constexpr u32 MUSIC_STREAM_BLOCK_COUNT = 16;
+constexpr u32 MUSIC_STREAM_MAX_CHANNELS = 2;
+constexpr u32 MUSIC_STREAM_BLOCK_SAMPLES = SOUND_ADPCM_BLOCK_FRAMES * MUSIC_STREAM_MAX_CHANNELS;
+
+struct MusicStream {
+    std::mutex mutex;
+    SoundImpl* sound;
+    u32 channels;
+    i16 blocks[MUSIC_STREAM_BLOCK_COUNT][MUSIC_STREAM_BLOCK_SAMPLES];   // Interleaved frames
+    u32 block_frames[MUSIC_STREAM_BLOCK_COUNT];
+    u64 read_block;             // Monotonic, the ring slot is the counter modulo the block count
+    u64 write_block;
+    u32 read_frame;
+    u32 next_source_block;
+    u32 generation;
+    bool loop;
+    bool finished;              // Every source block has been decoded
+    bool decoding;              // Main thread only, a decode task is in flight
+};
+
+struct MusicStreamTask {
+    SoundImpl* sound;
+    u32 generation;
+    u32 first_source_block;
+    u32 block_count;
+    bool loop;
+    i16 blocks[MUSIC_STREAM_BLOCK_COUNT][MUSIC_STREAM_BLOCK_SAMPLES];
+    u32 block_frames[MUSIC_STREAM_BLOCK_COUNT];
+};
+
+static MusicStream g_music_stream;
+
+// Decodes up to block_count source blocks starting at first, wrapping to the start when looping
+static u32 DecodeMusicBlocks(SoundImpl* sound, u32 first, u32 block_count, bool loop, i16 (*out)[MUSIC_STREAM_BLOCK_SAMPLES], u32* out_frames, u32* next) {
+    u32 source_block_count = GetSoundBlockCount(sound);
+    u32 decoded = 0;
+    for (; decoded < block_count; decoded++) {
+        if (first >= source_block_count) {
+            if (!loop || source_block_count == 0)
+                break;
+            first = 0;
+        }
+
+        out_frames[decoded] = DecodeSoundBlock(sound, first++, out[decoded]);
+    }
+
+    *next = first;
+    return decoded;
+}
+
+// Copies decoded blocks into the ring, the caller holds the lock
+static void CommitMusicBlocks(i16 (*blocks)[MUSIC_STREAM_BLOCK_SAMPLES], const u32* block_frames, u32 block_count, u32 next_source_block) {
+    MusicStream& stream = g_music_stream;
+    for (u32 i = 0; i < block_count; i++) {
+        u32 slot = static_cast<u32>(stream.write_block++ % MUSIC_STREAM_BLOCK_COUNT);
+        memcpy(stream.blocks[slot], blocks[i], block_frames[i] * stream.channels * sizeof(i16));
+        stream.block_frames[slot] = block_frames[i];
+    }
+
+    stream.next_source_block = next_source_block;
+    stream.finished = !stream.loop && next_source_block >= GetSoundBlockCount(stream.sound);
+}
+
+static void* RunMusicStreamTask(MusicStreamTask* decode) {
+    u32 next_source_block = 0;
+    u32 block_count = DecodeMusicBlocks(
+        decode->sound,
+        decode->first_source_block,
+        decode->block_count,
+        decode->loop,
+        decode->blocks,
+        decode->block_frames,
+        &next_source_block);
+
+    std::lock_guard lock(g_music_stream.mutex);
+    if (g_music_stream.generation == decode->generation && g_music_stream.sound == decode->sound)
+        CommitMusicBlocks(decode->blocks, decode->block_frames, block_count, next_source_block);
+
+    return noz::TASK_NO_RESULT;
+}
+
+void PlayMusicStream(SoundImpl* sound, bool loop) {
+    StopMusicStream();
+
+    if (!sound->data || sound->frame_count == 0) {
+        LogWarning("[AUDIO] PlayMusic: '%s' has no samples to stream", sound->name ? sound->name->value : "unnamed");
+        return;
+    }
+
+    if (sound->header.channels < 1 || sound->header.channels > MUSIC_STREAM_MAX_CHANNELS) {
+        LogWarning("[AUDIO] PlayMusic: '%s' has %u channels, only mono and stereo stream", sound->name ? sound->name->value : "unnamed", sound->header.channels);
+        return;
+    }
+
+    // Prime the ring before the mixer starts pulling so playback never opens on silence
+    {
+        MusicStream& stream = g_music_stream;
+        std::lock_guard lock(stream.mutex);
+        stream.sound = sound;
+        stream.channels = sound->header.channels;
+        stream.loop = loop;
+        stream.read_block = 0;
+        stream.read_frame = 0;
+        stream.write_block = DecodeMusicBlocks(sound, 0, MUSIC_STREAM_BLOCK_COUNT, stream.loop, stream.blocks, stream.block_frames, &stream.next_source_block);
+        stream.finished = !stream.loop && stream.next_source_block >= GetSoundBlockCount(sound);
+    }
+
+    PlayMixerMusicStream(sound->header.sample_rate, sound->header.channels);
+}
+
+void StopMusicStream() {
+    std::lock_guard lock(g_music_stream.mutex);
+    g_music_stream.sound = nullptr;
+    g_music_stream.generation++;
+}
+
+void UpdateMusicStream() {
+    MusicStream& stream = g_music_stream;
+    if (stream.decoding)
+        return;
+
+    MusicStreamTask* decode = nullptr;
+    {
+        std::lock_guard lock(stream.mutex);
+        u32 free_blocks = MUSIC_STREAM_BLOCK_COUNT - static_cast<u32>(stream.write_block - stream.read_block);
+        if (!stream.sound || stream.finished || free_blocks < MUSIC_STREAM_BLOCK_COUNT / 2)
+            return;
+
+        decode = static_cast<MusicStreamTask*>(Alloc(ALLOCATOR_DEFAULT, sizeof(MusicStreamTask)));
+        decode->sound = stream.sound;
+        decode->generation = stream.generation;
+        decode->first_source_block = stream.next_source_block;
+        decode->block_count = free_blocks;
+        decode->loop = stream.loop;
+    }
+
+    noz::Task task = noz::CreateTask({
+        .run = [decode](noz::Task) -> void* { return RunMusicStreamTask(decode); },
+        .complete = [decode](noz::Task, void*) {
+            g_music_stream.decoding = false;
+            Free(decode);
+        },
+        .name = "music_stream",
+    });
+
+    if (!task) {
+        Free(decode);
+        return;
+    }
+
+    stream.decoding = true;
+}
+
+// False once a one shot track has handed every frame to the mixer, or the stream was stopped
+bool IsMusicStreamPlaying() {
+    std::lock_guard lock(g_music_stream.mutex);
+    return g_music_stream.sound != nullptr;
+}
+
+// Called from the mixer on the audio thread for frame_count interleaved frames, frames the ring
+// cannot supply are filled with silence.  A mixer still set up for the previous track's channel
+// count gets silence until it catches up.
+u32 ReadMusicStream(i16* out, u32 frame_count, u32 channels) {
+    MusicStream& stream = g_music_stream;
+    std::lock_guard lock(stream.mutex);
+
+    u32 written = 0;
+    while (stream.sound && stream.channels == channels && written < frame_count && stream.read_block < stream.write_block) {
+        u32 slot = static_cast<u32>(stream.read_block % MUSIC_STREAM_BLOCK_COUNT);
+        u32 count = Min(frame_count - written, stream.block_frames[slot] - stream.read_frame);
+        memcpy(out + written * channels, stream.blocks[slot] + stream.read_frame * channels, count * channels * sizeof(i16));
+        written += count;
+        stream.read_frame += count;
+
+        if (stream.read_frame >= stream.block_frames[slot]) {
+            stream.read_frame = 0;
+            stream.read_block++;
+        }
+    }
+
+    if (stream.sound && stream.finished && stream.read_block == stream.write_block)
+        stream.sound = nullptr;
+
+    memset(out + written * channels, 0, (frame_count - written) * channels * sizeof(i16));
+    return written;
+}
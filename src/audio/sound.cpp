@@ -4,21 +4,38 @@
 
 #include "../platform.h"
 #include "noz/noz.h"
+#include "../internal.h"
 
 Sound** SOUND = nullptr;
 int SOUND_COUNT = 0;
 
-struct SoundHeader {
-    u32 sample_rate;
-    u32 channels;
-    u32 bits_per_sample;
-    u32 data_size;
-};
+u32 GetSoundBlockCount(SoundImpl* impl) {
+    return (impl->frame_count + SOUND_ADPCM_BLOCK_FRAMES - 1) / SOUND_ADPCM_BLOCK_FRAMES;
+}
 
-struct SoundImpl : Sound {
-    SoundHeader header;
-    PlatformSound* platform;
-};
+// Decodes one block of 16 bit samples into interleaved frames, PCM sounds are cut into blocks
+// of the same frame count as ADPCM ones
+static u32 DecodeSoundBlock(SoundImpl* impl, const u8* data, u32 block_index, i16* out) {
+    u32 first_frame = block_index * SOUND_ADPCM_BLOCK_FRAMES;
+    if (!data || first_frame >= impl->frame_count)
+        return 0;
+
+    u32 channels = Max(1u, impl->header.channels);
+    u32 frame_count = Min(SOUND_ADPCM_BLOCK_FRAMES, impl->frame_count - first_frame);
+    if (impl->flags & SOUND_FLAG_ADPCM) {
+        const u8* blocks = data + block_index * channels * SOUND_ADPCM_BLOCK_SIZE;
+        for (u32 c = 0; c < channels; c++)
+            DecodeAdpcmBlock(blocks + c * SOUND_ADPCM_BLOCK_SIZE, frame_count, out + c, channels);
+    } else {
+        memcpy(out, data + first_frame * channels * sizeof(i16), frame_count * channels * sizeof(i16));
+    }
+
+    return frame_count;
+}
+
+u32 DecodeSoundBlock(SoundImpl* impl, u32 block_index, i16* out) {
+    return DecodeSoundBlock(impl, impl->data, block_index, out);
+}
 
 Asset* LoadSound(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table) {
     (void)name_table;
@@ -28,44 +45,82 @@ Asset* LoadSound(Allocator* allocator, Stream* stream, AssetHeader* header, cons
     assert(name);
     assert(header);
 
-    SoundImpl* sound = (SoundImpl*)Alloc(allocator, sizeof(SoundImpl));
+    SoundHeader sound_header = {};
+    sound_header.sample_rate = ReadU32(stream);
+    sound_header.channels = ReadU32(stream);
+    sound_header.bits_per_sample = ReadU32(stream);
+    sound_header.data_size = ReadU32(stream);
+    u32 frame_size = Max(1u, sound_header.channels * sound_header.bits_per_sample / 8);
+    u32 frame_count = (header->flags & SOUND_FLAG_ADPCM) ? ReadU32(stream) : sound_header.data_size / frame_size;
+
+    // Streamed sounds keep their encoded samples, in place when the stream outlives the asset
+    bool streamed = (header->flags & SOUND_FLAG_STREAM) != 0;
+    bool copy = streamed && !IsReadOnly(stream);
+    SoundImpl* sound = (SoundImpl*)Alloc(allocator, sizeof(SoundImpl) + (copy ? sound_header.data_size : 0));
     sound->name = name;
-    sound->header.sample_rate = ReadU32(stream);
-    sound->header.channels = ReadU32(stream);
-    sound->header.bits_per_sample = ReadU32(stream);
-    sound->header.data_size = ReadU32(stream);
-
-    void* data = Alloc(ALLOCATOR_SCRATCH, sound->header.data_size);
-    ReadBytes(stream, data, sound->header.data_size);
-    sound->platform = PlatformCreateSound(
+    sound->flags = header->flags;
+    sound->header = sound_header;
+    sound->frame_count = frame_count;
+
+    const u8* data = ReadInPlace(stream, sound_header.data_size);
+    if (!data)
+        return sound;
+
+    if (streamed) {
+        if (copy) {
+            memcpy(sound + 1, data, sound_header.data_size);
+            data = reinterpret_cast<const u8*>(sound + 1);
+        }
+        sound->data = data;
+        return sound;
+    }
+
+    // Short sounds are decoded once and handed to the mixer, which keeps its own copy.  Async
+    // loads run this on a worker, so the temporary block can't come from scratch memory.
+    if (header->flags & SOUND_FLAG_ADPCM) {
+        u32 channels = Max(1u, sound_header.channels);
+        i16* pcm = static_cast<i16*>(Alloc(ALLOCATOR_DEFAULT, frame_count * channels * sizeof(i16)));
+        for (u32 block = 0, block_count = GetSoundBlockCount(sound); block < block_count; block++)
+            DecodeSoundBlock(sound, data, block, pcm + block * SOUND_ADPCM_BLOCK_FRAMES * channels);
+
+        sound->mixer = CreateMixerSound(pcm, frame_count * channels * sizeof(i16), sound_header.sample_rate, channels, 16);
+        Free(pcm);
+        return sound;
+    }
+
+    sound->mixer = CreateMixerSound(
         data,
-        sound->header.data_size,
-        sound->header.sample_rate,
-        sound->header.channels,
-        sound->header.bits_per_sample);
-    Free(data);
+        sound_header.data_size,
+        sound_header.sample_rate,
+        sound_header.channels,
+        sound_header.bits_per_sample);
 
     return sound;
 }
 
 bool IsPlaying(const SoundHandle& handle)
 {
-    return PlatformIsSoundPlaying({handle.value});
+    return IsMixerSoundPlaying(handle);
 }
 
-float GetSoundVolume(const SoundHandle& handle)
+float GetVolume(const SoundHandle& handle)
 {
-    return PlatformGetSoundVolume({handle.value});
+    return GetMixerSoundVolume(handle);
 }
 
-float GetSoundPitch(const SoundHandle& handle)
+float GetPitch(const SoundHandle& handle)
 {
-    return PlatformGetSoundVolume({handle.value});
+    return GetMixerSoundPitch(handle);
 }
 
-void SetSoundVolume(const SoundHandle& handle, float volume)
+void SetVolume(const SoundHandle& handle, float volume)
 {
-    PlatformSetSoundVolume({handle.value}, volume);
+    SetMixerSoundVolume(handle, volume);
+}
+
+void SetPitch(const SoundHandle& handle, float pitch)
+{
+    SetMixerSoundPitch(handle, pitch);
 }
 
 SoundHandle Play(Sound** sounds, int count, float volume, float pitch, bool loop) {
@@ -74,19 +129,28 @@ SoundHandle Play(Sound** sounds, int count, float volume, float pitch, bool loop
 
 SoundHandle Play(Sound* sound, float volume, float pitch, bool loop) {
     SoundImpl* impl = (SoundImpl*)sound;
-    PlatformSoundHandle handle = PlatformPlaySound(impl->platform, volume, pitch, loop);
-    return { handle.value };
+    if (!impl->mixer) {
+        LogWarning("[AUDIO] Play: '%s' is streamed, play it with PlayMusic", sound->name ? sound->name->value : "unnamed");
+        return { static_cast<u64>(0xFFFFFFFF) << 32 };
+    }
+
+    return PlayMixerSound(impl->mixer, volume, pitch, loop);
 }
 
-void PlayMusicInternal(Sound* sound) {
+void PlayMusicInternal(Sound* sound, bool loop) {
     if (!sound) {
         LogWarning("[AUDIO] PlayMusicInternal: sound is null");
         return;
     }
     SoundImpl* impl = static_cast<SoundImpl*>(sound);
-    if (!impl->platform) {
-        LogWarning("[AUDIO] PlayMusicInternal: platform sound is null for '%s'", sound->name ? sound->name->value : "unnamed");
+    if (impl->flags & SOUND_FLAG_STREAM) {
+        PlayMusicStream(impl, loop);
+        return;
+    }
+
+    if (!impl->mixer) {
+        LogWarning("[AUDIO] PlayMusicInternal: mixer sound is null for '%s'", sound->name ? sound->name->value : "unnamed");
         return;
     }
-    PlatformPlayMusic(impl->platform);
+    PlayMixerMusic(impl->mixer, loop);
 }
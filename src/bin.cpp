@@ -7,7 +7,7 @@ int BIN_COUNT = 0;
 
 struct BinImpl : Bin {
     u32 length;
-    u8* data;
+    const u8* data;
 };
 
 Asset* LoadBin(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table) {
@@ -21,10 +21,19 @@ Asset* LoadBin(Allocator* allocator, Stream* stream, AssetHeader* header, const
 
     u32 data_size = ReadU32(stream);
 
+    // Read only streams outlive the asset so the payload is referenced where it is
+    if (IsReadOnly(stream)) {
+        BinImpl* impl = static_cast<BinImpl*>(Alloc(allocator, sizeof(BinImpl)));
+        impl->data = ReadInPlace(stream, data_size);
+        impl->length = impl->data ? data_size : 0;
+        return impl;
+    }
+
     BinImpl* impl = static_cast<BinImpl*>(Alloc(allocator, sizeof(BinImpl) + data_size));
-    impl->data = reinterpret_cast<u8 *>(impl + 1);
+    u8* data = reinterpret_cast<u8 *>(impl + 1);
+    ReadBytes(stream, data, data_size);
+    impl->data = data;
     impl->length = data_size;
-    ReadBytes(stream, impl->data, data_size);
 
     return impl;
 }
@@ -41,5 +50,5 @@ const u8* GetData(Bin* bin) {
 
 Stream* CreateStream(Allocator* allocator, Bin* bin) {
     BinImpl* impl = static_cast<BinImpl*>(bin);
-    return CreateStream(allocator, impl->data, impl->length);
+    return CreateReadOnlyStream(allocator, impl->data, impl->length);
 }
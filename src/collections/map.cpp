@@ -2,19 +2,223 @@
 //  NoZ - Copyright(c) 2026 NoZ Games, LLC
 //
 
-constexpr size_t INVALID_KEY_INDEX = 0xFFFFFFFF;
+// Open addressing hash table with SwissTable style control bytes.  Each slot has a control
+// byte that is either empty, deleted or the low 7 bits of the key hash, and probing compares
+// a whole group of control bytes at once.  The control array is mirrored for one group past
+// the end so a group can be loaded at any slot without wrapping.
 
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NOZ_MAP_SSE2
+#endif
+
+constexpr size_t INVALID_KEY_INDEX = SIZE_MAX;
+constexpr u8 MAP_CTRL_EMPTY = 0x80;
+constexpr u8 MAP_CTRL_DELETED = 0xFE;
+
+static u64 HashKey(u64 key)
+{
+    u64 h = key * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 32);
+}
+
+static u32 MatchGroup(const u8* ctrl, u8 value)
+{
+#if defined(NOZ_MAP_SSE2)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+    u32 mask = 0;
+    for (u32 i=0; i<MAP_GROUP_SIZE; i++)
+        mask |= (ctrl[i] == value ? 1u : 0u) << i;
+    return mask;
+#endif
+}
+
+static u32 MatchEmptyOrDeleted(const u8* ctrl)
+{
+#if defined(NOZ_MAP_SSE2)
+    // Empty and deleted are the only control values with the high bit set
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<u32>(_mm_movemask_epi8(group));
+#else
+    u32 mask = 0;
+    for (u32 i=0; i<MAP_GROUP_SIZE; i++)
+        mask |= (ctrl[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+static u32 CountTrailingZeros(u32 mask)
+{
+    return static_cast<u32>(std::countr_zero(mask));
+}
+
+static void SetCtrl(Map& map, size_t index, u8 value)
+{
+    map.ctrl[index] = value;
+
+    // Keep the mirrored tail in sync, small tables mirror every slot more than once
+    for (size_t mirror = index; mirror < MAP_GROUP_SIZE; mirror += map.capacity)
+        map.ctrl[map.capacity + mirror] = value;
+}
 
 static size_t FindKey(const Map& map, u64 key)
 {
-    auto map_key = map.keys;
-    for (size_t i=0, c=map.count; i<c; i++, map_key++)
-        if (*map_key == key)
-            return i;
+    if (map.count == 0)
+        return INVALID_KEY_INDEX;
+
+    u64 hash = HashKey(key);
+    u8 h2 = static_cast<u8>(hash & 0x7F);
+    size_t mask = map.capacity - 1;
+    size_t pos = (hash >> 7) & mask;
+    size_t group_count = (map.capacity + MAP_GROUP_SIZE - 1) / MAP_GROUP_SIZE;
+
+    for (size_t probe=0; probe<group_count; probe++)
+    {
+        const u8* group = map.ctrl + pos;
+        for (u32 match = MatchGroup(group, h2); match; match &= match - 1)
+        {
+            size_t index = (pos + CountTrailingZeros(match)) & mask;
+            if (map.keys[index] == key)
+                return index;
+        }
+
+        if (MatchGroup(group, MAP_CTRL_EMPTY))
+            return INVALID_KEY_INDEX;
+
+        pos = (pos + (probe + 1) * MAP_GROUP_SIZE) & mask;
+    }
+
+    return INVALID_KEY_INDEX;
+}
+
+// First empty or deleted slot along the probe sequence of the key
+static size_t FindInsertSlot(const Map& map, u64 key)
+{
+    u64 hash = HashKey(key);
+    size_t mask = map.capacity - 1;
+    size_t pos = (hash >> 7) & mask;
+    size_t group_count = (map.capacity + MAP_GROUP_SIZE - 1) / MAP_GROUP_SIZE;
+
+    for (size_t probe=0; probe<group_count; probe++)
+    {
+        u32 match = MatchEmptyOrDeleted(map.ctrl + pos);
+        if (match)
+            return (pos + CountTrailingZeros(match)) & mask;
+
+        pos = (pos + (probe + 1) * MAP_GROUP_SIZE) & mask;
+    }
 
     return INVALID_KEY_INDEX;
 }
 
+static void SwapSlots(Map& map, size_t a, size_t b)
+{
+    u64 key = map.keys[a];
+    map.keys[a] = map.keys[b];
+    map.keys[b] = key;
+
+    u8* value_a = (u8*)map.values + a * map.value_stride;
+    u8* value_b = (u8*)map.values + b * map.value_stride;
+    for (size_t i=0; i<map.value_stride; i++)
+    {
+        u8 v = value_a[i];
+        value_a[i] = value_b[i];
+        value_b[i] = v;
+    }
+}
+
+// Probe group a slot falls in for a probe sequence starting at start
+static size_t GetProbeGroup(const Map& map, size_t start, size_t index)
+{
+    return ((index - start) & (map.capacity - 1)) / MAP_GROUP_SIZE;
+}
+
+// Rehashes every key in place, turning all tombstones back into empty slots.  Live slots are
+// first marked deleted and empty, then each is moved to the first free slot on its probe
+// sequence, swapping with a not yet placed key when that slot is still marked.
+static void DropDeletedSlots(Map& map)
+{
+    for (size_t i=0; i<map.capacity; i++)
+    {
+        u8 ctrl = map.ctrl[i];
+        if (ctrl == MAP_CTRL_DELETED)
+            SetCtrl(map, i, MAP_CTRL_EMPTY);
+        else if (ctrl != MAP_CTRL_EMPTY)
+            SetCtrl(map, i, MAP_CTRL_DELETED);
+    }
+
+    size_t mask = map.capacity - 1;
+    for (size_t i=0; i<map.capacity; i++)
+    {
+        if (map.ctrl[i] != MAP_CTRL_DELETED)
+            continue;
+
+        u64 hash = HashKey(map.keys[i]);
+        u8 h2 = static_cast<u8>(hash & 0x7F);
+        size_t start = (hash >> 7) & mask;
+        size_t target = FindInsertSlot(map, map.keys[i]);
+        assert(target != INVALID_KEY_INDEX);
+
+        // Already in the first group that has room, leave it where it is
+        if (GetProbeGroup(map, start, target) == GetProbeGroup(map, start, i))
+        {
+            SetCtrl(map, i, h2);
+            continue;
+        }
+
+        if (map.ctrl[target] == MAP_CTRL_EMPTY)
+        {
+            SwapSlots(map, i, target);
+            SetCtrl(map, target, h2);
+            SetCtrl(map, i, MAP_CTRL_EMPTY);
+            continue;
+        }
+
+        // Target holds a key still waiting to be placed, swap and place that one next
+        SwapSlots(map, i, target);
+        SetCtrl(map, target, h2);
+        i--;
+    }
+
+    map.deleted = 0;
+}
+
+// Tombstones count as occupied for misses, so once few empty slots are left and enough of
+// the rest are tombstones the table is rebuilt.  Requiring a share of tombstones keeps the
+// rebuild amortized over at least capacity/16 removals.
+static void ReclaimDeletedSlots(Map& map)
+{
+    if (map.deleted == 0)
+        return;
+
+    size_t empty = map.capacity - map.count - map.deleted;
+    size_t min_deleted = map.capacity >= 16 ? map.capacity / 16 : 1;
+    if (empty == 0 || (empty < map.capacity / 8 && map.deleted >= min_deleted))
+        DropDeletedSlots(map);
+}
+
+void Init(Map& map, u64* keys, void* values, u8* ctrl, size_t capacity, size_t value_stride)
+{
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "Map capacity must be a power of two");
+    map.capacity = capacity;
+    map.keys = keys;
+    map.values = values;
+    map.ctrl = ctrl;
+    map.value_stride = value_stride;
+    Clear(map);
+}
+
+void Clear(Map& map)
+{
+    memset(map.ctrl, MAP_CTRL_EMPTY, GetMapCtrlSize(map.capacity));
+    map.count = 0;
+    map.deleted = 0;
+}
+
 bool HasKey(const Map& map, u64 key)
 {
     return FindKey(map, key) != INVALID_KEY_INDEX;
@@ -48,14 +252,52 @@ void* SetValue(Map& map, u64 key, void* value)
         if (map.count >= map.capacity)
             return nullptr;
 
-        key_index = map.count;
+        ReclaimDeletedSlots(map);
+
+        key_index = FindInsertSlot(map, key);
+        assert(key_index != INVALID_KEY_INDEX);
+
+        if (map.ctrl[key_index] == MAP_CTRL_DELETED)
+            map.deleted--;
+
+        SetCtrl(map, key_index, static_cast<u8>(HashKey(key) & 0x7F));
+        map.keys[key_index] = key;
         map.count++;
     }
 
-    map.keys[key_index] = key;
-
     auto data = (u8*)map.values + key_index * map.value_stride;
     if (value)
         memcpy(data, value, map.value_stride);
     return data;
 }
+
+bool RemoveKey(Map& map, const char* key)
+{
+    return RemoveKey(map, Hash(key));
+}
+
+bool RemoveKey(Map& map, u64 key)
+{
+    auto key_index = FindKey(map, key);
+    if (key_index == INVALID_KEY_INDEX)
+        return false;
+
+    // A slot can go straight back to empty if no probe sequence could have passed over it
+    // while looking for a later slot, which is the case when its window was never full.
+    bool was_never_full = map.capacity <= MAP_GROUP_SIZE;
+    if (!was_never_full)
+    {
+        size_t mask = map.capacity - 1;
+        u32 empty_after = MatchGroup(map.ctrl + key_index, MAP_CTRL_EMPTY);
+        u32 empty_before = MatchGroup(map.ctrl + ((key_index - MAP_GROUP_SIZE) & mask), MAP_CTRL_EMPTY);
+        was_never_full =
+            empty_after && empty_before &&
+            CountTrailingZeros(empty_after) + static_cast<u32>(std::countl_zero(empty_before << (32 - MAP_GROUP_SIZE))) < MAP_GROUP_SIZE;
+    }
+
+    SetCtrl(map, key_index, was_never_full ? MAP_CTRL_EMPTY : MAP_CTRL_DELETED);
+    map.count--;
+    if (!was_never_full)
+        map.deleted++;
+    return true;
+}
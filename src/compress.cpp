@@ -0,0 +1,156 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+// Each sequence is a token holding the literal count in the high nibble and the match length
+// minus COMPRESS_MIN_MATCH in the low nibble, a nibble of 15 continues in bytes of up to 255.
+// The literals follow, then a little endian u16 offset back into the output.  The final
+// sequence stops after its literals.
+
+constexpr u32 COMPRESS_MIN_MATCH = 4;
+constexpr u32 COMPRESS_MAX_OFFSET = 65535;
+constexpr int COMPRESS_HASH_BITS = 14;
+
+static u32 Read32(const u8* p) {
+    u32 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static u8* WriteLength(u8* op, u32 length) {
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = static_cast<u8>(length);
+    return op;
+}
+
+static u8* WriteSequence(u8* op, u8* op_end, const u8* literals, u32 literal_count, u32 offset, u32 match_length) {
+    u32 required = 1 + literal_count + literal_count / 255 + 1 + (match_length ? 2 + match_length / 255 + 1 : 0);
+    if (required > static_cast<u32>(op_end - op))
+        return nullptr;
+
+    u8* token = op++;
+    *token = static_cast<u8>(Min(literal_count, 15u) << 4);
+    if (literal_count >= 15)
+        op = WriteLength(op, literal_count - 15);
+
+    memcpy(op, literals, literal_count);
+    op += literal_count;
+
+    if (!match_length)
+        return op;
+
+    *op++ = static_cast<u8>(offset);
+    *op++ = static_cast<u8>(offset >> 8);
+
+    u32 length = match_length - COMPRESS_MIN_MATCH;
+    *token |= static_cast<u8>(Min(length, 15u));
+    if (length >= 15)
+        op = WriteLength(op, length - 15);
+
+    return op;
+}
+
+u32 Compress(const u8* src, u32 src_size, u8* dst, u32 dst_capacity) {
+    // Positions are stored plus one so zero marks an empty slot
+    u32 table[1 << COMPRESS_HASH_BITS] = {};
+
+    const u8* ip = src;
+    const u8* anchor = src;
+    const u8* end = src + src_size;
+    u8* op = dst;
+    u8* op_end = dst + dst_capacity;
+
+    while (end - ip >= static_cast<ptrdiff_t>(COMPRESS_MIN_MATCH)) {
+        u32 sequence = Read32(ip);
+        u32 slot = (sequence * 2654435761u) >> (32 - COMPRESS_HASH_BITS);
+        u32 position = static_cast<u32>(ip - src);
+        u32 candidate = table[slot];
+        table[slot] = position + 1;
+
+        if (candidate == 0 || position + 1 - candidate > COMPRESS_MAX_OFFSET || Read32(src + candidate - 1) != sequence) {
+            ip++;
+            continue;
+        }
+
+        const u8* match = src + candidate - 1;
+        u32 length = COMPRESS_MIN_MATCH;
+        while (ip + length < end && match[length] == ip[length])
+            length++;
+
+        op = WriteSequence(op, op_end, anchor, static_cast<u32>(ip - anchor), static_cast<u32>(ip - match), length);
+        if (!op)
+            return COMPRESS_FAILED;
+
+        ip += length;
+        anchor = ip;
+    }
+
+    if (anchor < end) {
+        op = WriteSequence(op, op_end, anchor, static_cast<u32>(end - anchor), 0, 0);
+        if (!op)
+            return COMPRESS_FAILED;
+    }
+
+    return static_cast<u32>(op - dst);
+}
+
+static bool ReadLength(const u8*& ip, const u8* ip_end, u32& length) {
+    u8 value;
+    do {
+        if (ip >= ip_end)
+            return false;
+        value = *ip++;
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+bool Decompress(const u8* src, u32 src_size, u8* dst, u32 dst_size) {
+    const u8* ip = src;
+    const u8* ip_end = src + src_size;
+    u8* op = dst;
+    u8* op_end = dst + dst_size;
+
+    while (ip < ip_end) {
+        u8 token = *ip++;
+
+        u32 literal_count = token >> 4;
+        if (literal_count == 15 && !ReadLength(ip, ip_end, literal_count))
+            return false;
+        if (literal_count > static_cast<u32>(ip_end - ip) || literal_count > static_cast<u32>(op_end - op))
+            return false;
+
+        memcpy(op, ip, literal_count);
+        ip += literal_count;
+        op += literal_count;
+
+        if (ip == ip_end)
+            break;
+
+        if (ip_end - ip < 2)
+            return false;
+        u32 offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        u32 length = token & 15;
+        if (length == 15 && !ReadLength(ip, ip_end, length))
+            return false;
+        length += COMPRESS_MIN_MATCH;
+
+        if (offset == 0 || offset > static_cast<u32>(op - dst) || length > static_cast<u32>(op_end - op))
+            return false;
+
+        // Overlapping matches repeat the last offset bytes so they copy forward one at a time
+        const u8* match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            for (u32 i = 0; i < length; i++)
+                *op++ = match[i];
+        }
+    }
+
+    return op == op_end;
+}
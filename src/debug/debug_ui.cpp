@@ -74,6 +74,21 @@ void DebugProperty(const char* name, int value) {
     DebugProperty(name, text.value);
 }
 
+static void RenderSection() {
+    const RenderStats& stats = GetRenderStats();
+    DebugProperty("commands", stats.command_count);
+    DebugProperty("draws", stats.draw_count);
+    DebugProperty("culled", stats.culled_count);
+}
+
+static void VfxSection() {
+    const VfxStats& stats = GetVfxStats();
+    DebugProperty("particles", stats.particle_count);
+    DebugProperty("emitters", stats.emitter_count);
+    DebugProperty("dropped", stats.dropped_count);
+    DebugProperty("thinned", stats.thinned_count);
+}
+
 static void UISection() {
     DebugProperty("canvas_id", g_debug_ui.last_canvas_id);
     DebugProperty("element_id", g_debug_ui.last_element_id);
@@ -100,6 +115,8 @@ void UpdateDebugUI() {
 
     BeginRow({.spacing=16});
     Section("UI", UISection);
+    Section("Render", RenderSection);
+    Section("VFX", VfxSection);
 
     if (g_debug_ui.game_section)
         Section("Game", g_debug_ui.game_section);
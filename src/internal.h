@@ -19,9 +19,15 @@ constexpr ShaderFlags SHADER_FLAGS_DEPTH_LESS = 1 << 2;
 constexpr ShaderFlags SHADER_FLAGS_POSTPROCESS = 1 << 3;
 constexpr ShaderFlags SHADER_FLAGS_UI_COMPOSITE = 1 << 4;
 constexpr ShaderFlags SHADER_FLAGS_PREMULTIPLIED_ALPHA = 1 << 5;
+constexpr ShaderFlags SHADER_FLAGS_INSTANCED = 1 << 6;
 
 // @render
 void BeginUIPass();
+void AddCulledDraws(int count);
+bool GetCullBounds(Bounds2* bounds);
+
+// @texture
+void DecodeTexture(TextureFormat format, const u8* data, int width, int height, u8* rgba);
 
 // @input
 void InitInput();
@@ -48,6 +54,22 @@ struct AnimationFrame {
     float root_motion1;
 };
 
+// Compressed channel of a single bone, keys are 16 bit values between min and min + 65535 *
+// scale at sparse transform indices and a track without keys is the constant min.
+struct AnimationTrack {
+    float min;
+    float scale;
+    u32 key_offset;
+    u32 key_count;
+};
+
+constexpr int ANIMATION_TRACK_POSITION_X = 0;
+constexpr int ANIMATION_TRACK_POSITION_Y = 1;
+constexpr int ANIMATION_TRACK_SCALE_X = 2;
+constexpr int ANIMATION_TRACK_SCALE_Y = 3;
+constexpr int ANIMATION_TRACK_ROTATION = 4;
+constexpr int ANIMATION_TRACKS_PER_BONE = 5;
+
 struct AnimationImpl : Animation {
     int bone_count;
     int transform_count;
@@ -60,18 +82,68 @@ struct AnimationImpl : Animation {
     AnimationBone* bones;
     BoneTransform* transforms;
     AnimationFrame* frames;
+    AnimationTrack* tracks;
+    u8* key_frames;
+    u16* key_values;
 };
 
+extern BoneTransform DecodeBoneTransform(AnimationImpl* impl, int transform_index, int bone_index);
+
 // @skeleton
 struct SkeletonImpl : Skeleton {
     int bone_count;
     Bone* bones;
 };
 
+// @animator
+extern void InitAnimators(const ApplicationTraits* traits);
+extern void ShutdownAnimators();
+
 // @tween
 extern void InitTween();
 extern void ShutdownTween();
 
+// @sound
+struct MixerSound;
+
+struct SoundHeader {
+    u32 sample_rate;
+    u32 channels;
+    u32 bits_per_sample;
+    u32 data_size;
+};
+
+struct SoundImpl : Sound {
+    SoundHeader header;
+    MixerSound* mixer;
+    const u8* data;         // Encoded samples of a streamed sound
+    u32 frame_count;
+};
+
+extern u32 DecodeSoundBlock(SoundImpl* impl, u32 block_index, i16* out);
+extern u32 GetSoundBlockCount(SoundImpl* impl);
+
+// @mixer
+extern void InitMixer(const ApplicationTraits& traits);
+extern void ShutdownMixer();
+extern MixerSound* CreateMixerSound(const void* data, u32 data_size, u32 sample_rate, u32 channels, u32 bits_per_sample);
+extern SoundHandle PlayMixerSound(MixerSound* sound, float volume, float pitch, bool loop);
+extern void StopMixerSound(const SoundHandle& handle);
+extern bool IsMixerSoundPlaying(const SoundHandle& handle);
+extern void SetMixerSoundVolume(const SoundHandle& handle, float volume);
+extern void SetMixerSoundPitch(const SoundHandle& handle, float pitch);
+extern float GetMixerSoundVolume(const SoundHandle& handle);
+extern float GetMixerSoundPitch(const SoundHandle& handle);
+extern void PlayMixerMusic(MixerSound* sound, bool loop);
+extern void PlayMixerMusicStream(u32 sample_rate, u32 channels);
+extern void StopMixerMusic();
+extern bool IsMixerMusicPlaying();
+
+// @music_stream
+extern void PlayMusicStream(SoundImpl* impl, bool loop);
+extern void StopMusicStream();
+extern void UpdateMusicStream();
+
 
 #if defined(NOZ_LUA)
 
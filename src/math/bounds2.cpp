@@ -24,6 +24,19 @@ bool Contains(const Bounds2& bounds, const Vec2& point)
            point.y >= bounds.min.y && point.y <= bounds.max.y;
 }
 
+// Axis aligned bounds of the transformed box, the extents are projected through the
+// absolute value of the linear part so no corners need to be transformed.
+Bounds2 TransformBounds(const Mat3& m, const Bounds2& bounds)
+{
+    Vec2 center = TransformPoint(m, GetCenter(bounds));
+    Vec2 half = GetSize(bounds) * 0.5f;
+    Vec2 extent = {
+        Abs(m.m[0]) * half.x + Abs(m.m[3]) * half.y,
+        Abs(m.m[1]) * half.x + Abs(m.m[4]) * half.y
+    };
+    return Bounds2{ center - extent, center + extent };
+}
+
 bool Intersects(const Bounds2& bounds, const Bounds2& other)
 {
     const Vec2& min = bounds.min;
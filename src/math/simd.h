@@ -0,0 +1,122 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#pragma once
+
+// Four wide float helpers shared by the batched kernels.  SSE2 and AArch64 NEON map straight
+// onto intrinsics, everything else falls back to plain loops.  Loads and stores are unaligned
+// since the streams live inside pool items and structs with no 16 byte guarantee.  Masks are
+// all bits set on the SIMD paths and 1.0 on the scalar path, only Select4 and Or4 read them.
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NOZ_SIMD_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NOZ_SIMD_NEON
+#endif
+
+#if defined(NOZ_SIMD_SSE2)
+typedef __m128 f32x4;
+inline f32x4 Load4(const float* p) { return _mm_loadu_ps(p); }
+inline void Store4(float* p, f32x4 v) { _mm_storeu_ps(p, v); }
+inline f32x4 Set4(float v) { return _mm_set1_ps(v); }
+inline f32x4 Set4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline f32x4 Add4(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 Sub4(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+inline f32x4 Mul4(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 Div4(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+inline f32x4 Min4(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+inline f32x4 Max4(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+inline f32x4 Sqrt4(f32x4 v) { return _mm_sqrt_ps(v); }
+inline f32x4 Round4(f32x4 v) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(v)); }
+inline f32x4 Select4(f32x4 a, f32x4 b, f32x4 mask) { return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a)); }
+inline f32x4 Or4(f32x4 a, f32x4 b) { return _mm_or_ps(a, b); }
+inline f32x4 Greater4(f32x4 a, f32x4 b) { return _mm_cmpgt_ps(a, b); }
+inline f32x4 Less4(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a, b); }
+inline f32x4 DupLow4(f32x4 v) { return _mm_movelh_ps(v, v); }
+inline f32x4 DupHigh4(f32x4 v) { return _mm_movehl_ps(v, v); }
+inline f32x4 InterleaveLow4(f32x4 a, f32x4 b) { return _mm_unpacklo_ps(a, b); }
+inline f32x4 InterleaveHigh4(f32x4 a, f32x4 b) { return _mm_unpackhi_ps(a, b); }
+#elif defined(NOZ_SIMD_NEON)
+typedef float32x4_t f32x4;
+inline f32x4 Load4(const float* p) { return vld1q_f32(p); }
+inline void Store4(float* p, f32x4 v) { vst1q_f32(p, v); }
+inline f32x4 Set4(float v) { return vdupq_n_f32(v); }
+inline f32x4 Set4(float x, float y, float z, float w) { float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+inline f32x4 Add4(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 Sub4(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+inline f32x4 Mul4(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+inline f32x4 Div4(f32x4 a, f32x4 b) { return vdivq_f32(a, b); }
+inline f32x4 Min4(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+inline f32x4 Max4(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+inline f32x4 Sqrt4(f32x4 v) { return vsqrtq_f32(v); }
+inline f32x4 Round4(f32x4 v) { return vrndnq_f32(v); }
+inline f32x4 Select4(f32x4 a, f32x4 b, f32x4 mask) { return vbslq_f32(vreinterpretq_u32_f32(mask), b, a); }
+inline f32x4 Or4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline f32x4 Greater4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+inline f32x4 Less4(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline f32x4 DupLow4(f32x4 v) { return vcombine_f32(vget_low_f32(v), vget_low_f32(v)); }
+inline f32x4 DupHigh4(f32x4 v) { return vcombine_f32(vget_high_f32(v), vget_high_f32(v)); }
+inline f32x4 InterleaveLow4(f32x4 a, f32x4 b) { return vzip1q_f32(a, b); }
+inline f32x4 InterleaveHigh4(f32x4 a, f32x4 b) { return vzip2q_f32(a, b); }
+#else
+struct f32x4 { float v[4]; };
+inline f32x4 Load4(const float* p) { return { p[0], p[1], p[2], p[3] }; }
+inline void Store4(float* p, f32x4 v) { for (int i=0; i<4; i++) p[i] = v.v[i]; }
+inline f32x4 Set4(float v) { return { v, v, v, v }; }
+inline f32x4 Set4(float x, float y, float z, float w) { return { x, y, z, w }; }
+inline f32x4 Add4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] += b.v[i]; return a; }
+inline f32x4 Sub4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] -= b.v[i]; return a; }
+inline f32x4 Mul4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] *= b.v[i]; return a; }
+inline f32x4 Div4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] /= b.v[i]; return a; }
+inline f32x4 Min4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] = Min(a.v[i], b.v[i]); return a; }
+inline f32x4 Max4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] = Max(a.v[i], b.v[i]); return a; }
+inline f32x4 Sqrt4(f32x4 v) { for (int i=0; i<4; i++) v.v[i] = sqrtf(v.v[i]); return v; }
+inline f32x4 Round4(f32x4 v) { for (int i=0; i<4; i++) v.v[i] = nearbyintf(v.v[i]); return v; }
+inline f32x4 Select4(f32x4 a, f32x4 b, f32x4 mask) { for (int i=0; i<4; i++) if (mask.v[i] != 0.0f) a.v[i] = b.v[i]; return a; }
+inline f32x4 Or4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] = (a.v[i] != 0.0f || b.v[i] != 0.0f) ? 1.0f : 0.0f; return a; }
+inline f32x4 Greater4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] = a.v[i] > b.v[i] ? 1.0f : 0.0f; return a; }
+inline f32x4 Less4(f32x4 a, f32x4 b) { for (int i=0; i<4; i++) a.v[i] = a.v[i] < b.v[i] ? 1.0f : 0.0f; return a; }
+inline f32x4 DupLow4(f32x4 v) { return { v.v[0], v.v[1], v.v[0], v.v[1] }; }
+inline f32x4 DupHigh4(f32x4 v) { return { v.v[2], v.v[3], v.v[2], v.v[3] }; }
+inline f32x4 InterleaveLow4(f32x4 a, f32x4 b) { return { a.v[0], b.v[0], a.v[1], b.v[1] }; }
+inline f32x4 InterleaveHigh4(f32x4 a, f32x4 b) { return { a.v[2], b.v[2], a.v[3], b.v[3] }; }
+#endif
+
+inline f32x4 Mix4(f32x4 a, f32x4 b, f32x4 t) { return Add4(a, Mul4(Sub4(b, a), t)); }
+inline f32x4 Negate4(f32x4 v) { return Sub4(Set4(0.0f), v); }
+
+// Sine and cosine of radian angles.  The angle is reduced to [-pi/4, pi/4] around the nearest
+// multiple of pi/2 with a three part pi/2 so the reduction stays exact for a few thousand
+// radians, then both minimax polynomials run and the quadrant picks and signs the results.
+inline void SinCos4(f32x4 x, f32x4* out_sin, f32x4* out_cos)
+{
+    f32x4 q = Round4(Mul4(x, Set4(0.636619772367581343f)));
+    f32x4 r = Sub4(x, Mul4(q, Set4(1.5703125f)));
+    r = Sub4(r, Mul4(q, Set4(4.837512969970703125e-4f)));
+    r = Sub4(r, Mul4(q, Set4(7.54978995489188216e-8f)));
+
+    f32x4 z = Mul4(r, r);
+    f32x4 s = Add4(Set4(8.3321608736e-3f), Mul4(z, Set4(-1.9515295891e-4f)));
+    s = Add4(Set4(-1.6666654611e-1f), Mul4(z, s));
+    s = Add4(r, Mul4(Mul4(r, z), s));
+
+    f32x4 c = Add4(Set4(-1.388731625493765e-3f), Mul4(z, Set4(2.443315711809948e-5f)));
+    c = Add4(Set4(4.166664568298827e-2f), Mul4(z, c));
+    c = Add4(Sub4(Set4(1.0f), Mul4(z, Set4(0.5f))), Mul4(Mul4(z, z), c));
+
+    // Quadrant in -2..2, odd quadrants swap sine and cosine
+    f32x4 m = Sub4(q, Mul4(Set4(4.0f), Round4(Mul4(q, Set4(0.25f)))));
+    f32x4 half = Set4(0.5f);
+    f32x4 m_abs = Max4(m, Negate4(m));
+    f32x4 odd = Less4(Max4(Sub4(m_abs, Set4(1.0f)), Sub4(Set4(1.0f), m_abs)), half);
+    f32x4 sin_value = Select4(s, c, odd);
+    f32x4 cos_value = Select4(c, s, odd);
+
+    f32x4 sin_negative = Or4(Less4(m, Negate4(half)), Greater4(m, Set4(1.5f)));
+    f32x4 cos_negative = Or4(Greater4(m, half), Less4(m, Set4(-1.5f)));
+    *out_sin = Select4(sin_value, Negate4(sin_value), sin_negative);
+    *out_cos = Select4(cos_value, Negate4(cos_value), cos_negative);
+}
@@ -163,6 +163,9 @@ void Destroy(Allocator* a)
     if (a == g_default_allocator)
         return;
 
+    if (a->destroy)
+        a->destroy(a);
+
     free(a);
 }
 
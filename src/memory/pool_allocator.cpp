@@ -2,38 +2,119 @@
 //  NoZ - Copyright(c) 2026 NoZ Games, LLC
 //
 
+#include <bit>
+
+constexpr u32 POOL_INDEX_NONE = 0xFFFFFFFF;
+
+// Slots are handed out from an intrusive free list (the next index is stored in the free
+// slot itself), slots past high_water have never been used and are taken in order.
+// Occupancy is a bitset so enumeration can skip 64 empty slots at a time.
 struct PoolAllocatorImpl : PoolAllocator
 {
-    Allocator base;
     u32 count;
     u32 capacity;
+    u32 block_capacity;
+    u32 block_count;
     u32 item_size;
-    bool* items_used;
-    void* items;
+    u32 free_head;
+    u32 high_water;
+    bool grow;
+    u64* used;
+    u8** blocks;
+    u8* first_block;
 };
 
+static u32 GetWordCount(u32 capacity) { return (capacity + 63) / 64; }
+
+static u8* GetItem(PoolAllocatorImpl* impl, u32 index)
+{
+    return impl->blocks[index / impl->block_capacity] + (index % impl->block_capacity) * impl->item_size;
+}
+
+static bool IsUsed(PoolAllocatorImpl* impl, u32 index)
+{
+    return (impl->used[index / 64] & (1ull << (index % 64))) != 0;
+}
+
+static u32 GetItemIndex(PoolAllocatorImpl* impl, const void* ptr)
+{
+    for (u32 block_index=0; block_index<impl->block_count; block_index++)
+    {
+        u8* block = impl->blocks[block_index];
+        if (ptr >= block && ptr < block + impl->block_capacity * impl->item_size)
+            return block_index * impl->block_capacity + (u32)((const u8*)ptr - block) / impl->item_size;
+    }
+
+    assert(false && "pointer does not belong to pool");
+    return POOL_INDEX_NONE;
+}
+
+static bool GrowPool(PoolAllocatorImpl* impl)
+{
+    u32 new_capacity = impl->capacity + impl->block_capacity;
+    u32 old_words = GetWordCount(impl->capacity);
+    u32 new_words = GetWordCount(new_capacity);
+
+    u8* block = (u8*)calloc(impl->block_capacity, impl->item_size);
+    if (!block)
+        return false;
+
+    // The first block, its bitset and block table live inline with the pool
+    u64* used = impl->used == (u64*)(impl + 1)
+        ? (u64*)malloc(sizeof(u64) * new_words)
+        : (u64*)realloc(impl->used, sizeof(u64) * new_words);
+    if (used == nullptr)
+    {
+        free(block);
+        return false;
+    }
+
+    if (used != impl->used && impl->used == (u64*)(impl + 1))
+        memcpy(used, impl->used, sizeof(u64) * old_words);
+    memset(used + old_words, 0, sizeof(u64) * (new_words - old_words));
+    impl->used = used;
+
+    u8** blocks = impl->blocks == &impl->first_block
+        ? (u8**)malloc(sizeof(u8*) * (impl->block_count + 1))
+        : (u8**)realloc(impl->blocks, sizeof(u8*) * (impl->block_count + 1));
+    if (blocks == nullptr)
+    {
+        free(block);
+        return false;
+    }
+
+    if (impl->blocks == &impl->first_block)
+        blocks[0] = impl->first_block;
+    blocks[impl->block_count++] = block;
+    impl->blocks = blocks;
+    impl->capacity = new_capacity;
+    return true;
+}
+
 static void* PoolAlloc(Allocator* a, u32 size) {
     (void)size;
 
     assert(a);
 
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(a);
-    if (impl->count >= impl->capacity)
-        return nullptr;
-
     assert(size == impl->item_size);
 
-    for (u32 i=0; i<impl->capacity; i++)
+    u32 index = impl->free_head;
+    if (index != POOL_INDEX_NONE)
     {
-        if (!impl->items_used[i])
-        {
-            impl->items_used[i] = true;
-            impl->count++;
-            return (u8*)impl->items + impl->item_size * i;
-        }
+        impl->free_head = *(u32*)GetItem(impl, index);
     }
+    else
+    {
+        if (impl->high_water >= impl->capacity && (!impl->grow || !GrowPool(impl)))
+            return nullptr;
 
-    return nullptr;
+        index = impl->high_water++;
+    }
+
+    impl->used[index / 64] |= 1ull << (index % 64);
+    impl->count++;
+    return GetItem(impl, index);
 }
 
 static void* PoolRealloc(Allocator* a, void* ptr, u32 new_size)
@@ -50,13 +131,15 @@ static void PoolFree(Allocator* a, void* ptr)
     assert(a);
     assert(ptr);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(a);
-    assert(ptr >= impl->items);
     assert(impl->count > 0);
 
-    u32 index = (u32)((u8*)ptr - (u8*)impl->items) / impl->item_size;
+    u32 index = GetItemIndex(impl, ptr);
     assert(index < impl->capacity);
+    assert(IsUsed(impl, index) && "double free");
 
-    impl->items_used[index] = false;
+    impl->used[index / 64] &= ~(1ull << (index % 64));
+    *(u32*)ptr = impl->free_head;
+    impl->free_head = index;
     impl->count--;
 }
 
@@ -65,25 +148,50 @@ static void PoolClear(Allocator* a)
     assert(a);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(a);
 
-    memset(impl->items_used, 0, sizeof(bool) * impl->capacity);
-    memset(impl->items, 0, impl->item_size * impl->capacity);
+    memset(impl->used, 0, sizeof(u64) * GetWordCount(impl->capacity));
+    for (u32 block_index=0; block_index<impl->block_count; block_index++)
+        memset(impl->blocks[block_index], 0, impl->item_size * impl->block_capacity);
+    impl->free_head = POOL_INDEX_NONE;
+    impl->high_water = 0;
     impl->count = 0;
 }
 
+static void PoolDestroy(Allocator* a)
+{
+    assert(a);
+    PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(a);
+    if (impl->used != (u64*)(impl + 1))
+        free(impl->used);
+
+    if (impl->blocks != &impl->first_block)
+    {
+        for (u32 block_index=1; block_index<impl->block_count; block_index++)
+            free(impl->blocks[block_index]);
+        free(impl->blocks);
+    }
+}
 
-PoolAllocator* CreatePoolAllocator(u32 item_size, u32 capacity) {
+PoolAllocator* CreatePoolAllocator(u32 item_size, u32 capacity, bool grow) {
+    assert(capacity > 0);
     item_size += sizeof(AllocHeader);
 
-    u32 alloc_size = sizeof(PoolAllocatorImpl) + (item_size + sizeof(bool)) * capacity;
+    u32 word_count = GetWordCount(capacity);
+    u32 alloc_size = sizeof(PoolAllocatorImpl) + sizeof(u64) * word_count + item_size * capacity;
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(calloc(1, alloc_size));
     impl->alloc = PoolAlloc;
     impl->free = PoolFree;
     impl->realloc = PoolRealloc;
     impl->clear = PoolClear;
-    impl->items_used = (bool*)(impl + 1);
-    impl->items = impl->items_used + capacity;
+    impl->destroy = PoolDestroy;
+    impl->used = (u64*)(impl + 1);
+    impl->first_block = (u8*)(impl->used + word_count);
+    impl->blocks = &impl->first_block;
+    impl->block_count = 1;
+    impl->block_capacity = capacity;
     impl->capacity = capacity;
     impl->item_size = item_size;
+    impl->free_head = POOL_INDEX_NONE;
+    impl->grow = grow;
     return impl;
 }
 
@@ -92,9 +200,7 @@ u32 GetIndex(PoolAllocator* allocator, const void* ptr)
     assert(allocator);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(allocator);
 
-    u8* corrected_ptr = (u8*)ptr - sizeof(AllocHeader);
-    assert(corrected_ptr >= impl->items);
-    u32 index = (u32)(corrected_ptr - (u8*)impl->items) / impl->item_size;
+    u32 index = GetItemIndex(impl, (u8*)ptr - sizeof(AllocHeader));
     assert(index < impl->capacity);
     return index;
 }
@@ -104,7 +210,7 @@ void* GetAt(PoolAllocator* allocator, u32 index)
     assert(allocator);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(allocator);
     assert(index < impl->capacity);
-    return (u8*)impl->items + impl->item_size * index + sizeof(AllocHeader);
+    return GetItem(impl, index) + sizeof(AllocHeader);
 }
 
 bool IsValid(PoolAllocator* allocator, u32 index)
@@ -112,7 +218,7 @@ bool IsValid(PoolAllocator* allocator, u32 index)
     assert(allocator);
     assert(index < static_cast<PoolAllocatorImpl*>(allocator)->capacity);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(allocator);
-    return impl->items_used[index];
+    return IsUsed(impl, index);
 }
 
 u32 GetCount(PoolAllocator* allocator) {
@@ -120,11 +226,16 @@ u32 GetCount(PoolAllocator* allocator) {
     return static_cast<PoolAllocatorImpl*>(allocator)->count;
 }
 
+u32 GetCapacity(PoolAllocator* allocator) {
+    assert(allocator);
+    return static_cast<PoolAllocatorImpl*>(allocator)->capacity;
+}
+
 bool IsFull(PoolAllocator* allocator)
 {
     assert(allocator);
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(allocator);
-    return impl->count == impl->capacity;
+    return !impl->grow && impl->count == impl->capacity;
 }
 
 bool IsEmpty(PoolAllocator* allocator)
@@ -141,11 +252,20 @@ void Enumerate(PoolAllocator* allocator, bool (*func)(u32 index, void* item, voi
     PoolAllocatorImpl* impl = static_cast<PoolAllocatorImpl*>(allocator);
 
     int c = impl->count;
-    for (u32 i=0; i<impl->capacity && c > 0; i++)
-        if (impl->items_used[i])
+    u32 word_count = GetWordCount(impl->high_water);
+    for (u32 word_index=0; word_index<word_count && c > 0; word_index++)
+    {
+        for (u64 word = impl->used[word_index]; word != 0; word &= word - 1)
         {
+            u32 index = word_index * 64 + (u32)std::countr_zero(word);
+
+            // The callback may have freed a later item in the same word
+            if (!IsUsed(impl, index))
+                continue;
+
             c--;
-            if (!func(i, GetAt(allocator, i), user_data))
-                break;
+            if (!func(index, GetItem(impl, index) + sizeof(AllocHeader), user_data))
+                return;
         }
+    }
 }
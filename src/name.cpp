@@ -3,12 +3,40 @@
 //
 
 #include <noz/name.h>
+#include <atomic>
 #include <mutex>
-#include <map>
+#include <unordered_map>
+
+// Names are interned in a fixed size open addressing table keyed by the hash of the
+// requested string.  Slots only ever go from empty to a published entry, so lookups are
+// a lock free probe.  Entries are bump allocated from name_memory_size sized chunks.
+//
+// A probe gives up after NAME_MAX_PROBES occupied slots and the name goes to an overflow map
+// under a mutex instead.  Slots never empty again, so a probe that stops early behaves the
+// same for every later lookup of that name and the overflow map is only consulted then.
+
+constexpr u32 NAME_MAX_PROBES = 64;
+
+struct NameEntry {
+    u64 key;
+    Name name;      // only as many characters as the value needs are allocated
+};
+
+struct NameChunk {
+    NameChunk* next;
+    std::atomic<u32> used;
+    u32 size;
+    u8* data;
+};
 
 struct NameSystem {
-    std::mutex mutex;
-    std::map<u64, Name>* map;
+    std::atomic<NameEntry*>* slots;
+    u32 capacity;
+    std::atomic<NameChunk*> chunk;
+    std::mutex chunk_mutex;
+    u32 chunk_size;
+    std::unordered_map<u64, NameEntry*> overflow;
+    std::mutex overflow_mutex;
     Name none = {""};
 };
 
@@ -16,31 +44,119 @@ static NameSystem g_name_system;
 
 Name* NAME_NONE;
 
+static NameChunk* CreateNameChunk(u32 size, NameChunk* next) {
+    NameChunk* chunk = static_cast<NameChunk*>(calloc(1, sizeof(NameChunk) + size));
+    if (!chunk)
+        Exit("out_of_memory: name chunk (%d)", static_cast<int>(size));
+
+    chunk->next = next;
+    chunk->size = size;
+    chunk->data = reinterpret_cast<u8*>(chunk + 1);
+    return chunk;
+}
+
+static NameEntry* CreateNameEntry(const char* value, u64 key);
+
+static Name* GetOverflowName(const char* value, u64 key, NameEntry* created) {
+    std::lock_guard lock(g_name_system.overflow_mutex);
+    auto it = g_name_system.overflow.find(key);
+    if (it != g_name_system.overflow.end())
+        return &it->second->name;
+
+    if (g_name_system.overflow.empty())
+        LogWarning("name table full (%d), raise ApplicationTraits::max_names", static_cast<int>(g_name_system.capacity));
+
+    NameEntry* entry = created ? created : CreateNameEntry(value, key);
+    g_name_system.overflow[key] = entry;
+    return &entry->name;
+}
+
+static NameEntry* AllocNameEntry(u32 value_length) {
+    u32 size = static_cast<u32>(offsetof(NameEntry, name) + offsetof(Name, value)) + value_length + 1;
+    size = (size + 7) & ~7u;
+
+    while (true) {
+        NameChunk* chunk = g_name_system.chunk.load(std::memory_order_acquire);
+        u32 offset = chunk->used.fetch_add(size);
+        if (offset + size <= chunk->size)
+            return reinterpret_cast<NameEntry*>(chunk->data + offset);
+
+        // Chunk is full, the first thread to get here chains a new one
+        std::lock_guard lock(g_name_system.chunk_mutex);
+        if (g_name_system.chunk.load() == chunk)
+            g_name_system.chunk.store(CreateNameChunk(Max(g_name_system.chunk_size, size), chunk), std::memory_order_release);
+    }
+}
+
+static NameEntry* CreateNameEntry(const char* value, u64 key) {
+    u32 length = static_cast<u32>(strlen(value));
+    assert(length < MAX_NAME_LENGTH - 1);
+    NameEntry* entry = AllocNameEntry(length);
+    entry->key = key;
+    Copy(entry->name.value, length + 1, value);
+    CleanPath(entry->name.value);
+    return entry;
+}
+
 Name* GetName(const char* value) {
     if (!value || *value == 0)
         return NAME_NONE;
 
-    std::lock_guard lock(g_name_system.mutex);
+    u64 key = Hash(value);
+    u32 mask = g_name_system.capacity - 1;
+    NameEntry* created = nullptr;
 
-    auto key = Hash(value);
-    auto it = g_name_system.map->find(key);
-    if (it != g_name_system.map->end())
-        return &it->second;
+    u32 max_probes = Min(g_name_system.capacity, NAME_MAX_PROBES);
+    for (u32 probe = 0, index = static_cast<u32>(key) & mask; probe < max_probes; probe++, index = (index + 1) & mask) {
+        NameEntry* entry = g_name_system.slots[index].load(std::memory_order_acquire);
+        if (entry) {
+            if (entry->key == key)
+                return &entry->name;
+            continue;
+        }
 
-    assert(static_cast<u32>(strlen(value)) < MAX_NAME_LENGTH - 1);
+        if (!created)
+            created = CreateNameEntry(value, key);
 
-    Name& name = (*g_name_system.map)[key];
-    Copy(name.value, MAX_NAME_LENGTH, value);
-    CleanPath(name.value);
-    return &name;
+        // Another thread may publish the same name into this slot first, in which case the
+        // entry we built is simply left unused in the chunk.
+        if (g_name_system.slots[index].compare_exchange_strong(entry, created, std::memory_order_acq_rel, std::memory_order_acquire))
+            return &created->name;
+
+        if (entry->key == key)
+            return &entry->name;
+    }
+
+    return GetOverflowName(value, key, created);
 }
 
-void InitName(ApplicationTraits*) {
-    g_name_system.map = new std::map<u64, Name>();
+void InitName(ApplicationTraits* traits) {
+    // Keep the table at most half full for the number of names the memory can hold
+    u32 max_names = Max(traits->max_names, traits->name_memory_size / 64);
+    u32 capacity = 1;
+    while (capacity < max_names * 2)
+        capacity <<= 1;
+
+    g_name_system.capacity = capacity;
+    g_name_system.slots = new std::atomic<NameEntry*>[capacity];
+    for (u32 i = 0; i < capacity; i++)
+        g_name_system.slots[i].store(nullptr, std::memory_order_relaxed);
+
+    g_name_system.chunk_size = Max(traits->name_memory_size, static_cast<u32>(sizeof(NameEntry)));
+    g_name_system.chunk = CreateNameChunk(g_name_system.chunk_size, nullptr);
     NAME_NONE = &g_name_system.none;
 }
 
 void ShutdownName() {
-    delete g_name_system.map;
-    g_name_system.map = nullptr;
-}
\ No newline at end of file
+    delete[] g_name_system.slots;
+    g_name_system.slots = nullptr;
+    g_name_system.overflow.clear();
+
+    NameChunk* chunk = g_name_system.chunk.load();
+    while (chunk) {
+        NameChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    g_name_system.chunk = nullptr;
+}
@@ -13,6 +13,7 @@ enum InputCode;
 typedef u32 ShaderFlags;
 struct ApplicationTraits;
 struct MeshVertex;
+struct GlyphVertex;
 struct SamplerOptions;
 struct RectInt;
 
@@ -20,8 +21,6 @@ struct PlatformBuffer;
 struct PlatformBufferMemory {};
 struct PlatformShader;
 struct PlatformTexture;
-struct PlatformSound {};
-struct PlatformSoundHandle { u64 value;};
 struct PlatformHttpHandle { u64 value; };
 struct PlatformWebSocketHandle { u64 value; };
 struct PlatformWebSocketServerHandle { u64 value; };
@@ -33,6 +32,15 @@ enum BufferFlags : u32 {
     BUFFER_FLAG_DYNAMIC = 1 << 0,  // Use GL_DYNAMIC_DRAW, optimized for frequent updates
 };
 
+// Per instance vertex data, transform rows match the row_major layout of the uniform buffers
+struct PlatformInstance {
+    float transform[9];
+    float depth;
+    Vec2 color_offset;
+    Color color;
+    Color emission;
+};
+
 struct NativeTextboxStyle {
     Color background_color;
     Color text_color;
@@ -54,6 +62,11 @@ extern std::filesystem::path PatformGetCurrentPath();
 extern bool PlatformSavePersistentData(const char* name, const void* data, u32 size);
 extern u8* PlatformLoadPersistentData(Allocator* allocator, const char* name, u32* out_size);
 
+// @file_mapping
+// Read only view of a whole file, returns null where the file is missing or mapping is unsupported
+extern const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size);
+extern void PlatformUnmapFile(const u8* data, u32 size);
+
 extern u64 PlatformGetTimeCounter();
 extern u64 PlatformGetTimeFrequency();
 
@@ -82,7 +95,7 @@ extern void PlatformBindVertexBuffer(PlatformBuffer* buffer);
 extern void PlatformBindIndexBuffer(PlatformBuffer* buffer);
 extern void PlatformBindSkeleton(const Mat3* bone_transforms, u8 bone_count);
 extern PlatformTexture* PlatformCreateTexture(
-    void* data,
+    const void* data,
     size_t width,
     size_t height,
     int channels,
@@ -96,6 +109,15 @@ extern PlatformTexture* PlatformCreateTextureArray(
     int channels,
     const SamplerOptions& sampler_options,
     const char* name);
+extern PlatformTexture* PlatformCreateCompressedTexture(
+    const void* data,
+    u32 data_size,
+    size_t width,
+    size_t height,
+    TextureFormat format,
+    const SamplerOptions& sampler_options,
+    const char* name);
+extern bool PlatformIsTextureFormatSupported(TextureFormat format);
 extern void PlatformUpdateTexture(PlatformTexture* texture, void* data);
 extern void PlatformFree(PlatformTexture* texture);
 extern void PlatformEnablePostProcess(bool enabled);
@@ -120,6 +142,8 @@ extern PlatformBuffer* PlatformCreateIndexBuffer(const u16* indices, u16 index_c
 extern void PlatformUpdateVertexBuffer(PlatformBuffer* buffer, const MeshVertex* vertices, u16 vertex_count);
 extern void PlatformUpdateIndexBuffer(PlatformBuffer* buffer, const u16* indices, u16 index_count);
 extern void PlatformDrawIndexed(u16 index_count);
+extern void PlatformDrawIndexedInstanced(u16 index_count, const PlatformInstance* instances, u32 instance_count);
+extern void PlatformDrawGlyphs(const GlyphVertex* vertices, u32 quad_count);
 extern void PlatformBindTexture(PlatformTexture* texture, int slot);
 extern PlatformShader* PlatformCreateShader(
     const void* vertex,
@@ -204,26 +228,17 @@ extern bool PlatformUpdateTextboxText(Text& text);
 extern bool PlatformIsTextboxVisible();
 
 // @audio
+// The engine mixes every voice itself, platforms only open an output at AUDIO_SAMPLE_RATE and
+// pull interleaved float stereo from MixAudio, usually from their own audio thread.
+constexpr u32 AUDIO_SAMPLE_RATE = 44100;
+constexpr u32 AUDIO_CHANNELS = 2;
+
 extern void PlatformInitAudio();
 extern void PlatformShutdownAudio();
-extern PlatformSound* PlatformCreateSound(void* data, u32 data_size, u32 sample_rate, u32 channels, u32 bits_per_sample);
-extern void PlatformFree(PlatformSound*);
-extern PlatformSoundHandle PlatformPlaySound(PlatformSound* sound, float volume, float pitch, bool loop);
-extern void PlatformPlayMusic(PlatformSound* sound);
-extern bool PlatformIsMusicPlaying();
-extern void PlatformStopMusic();
-extern void PlatformStopSound(const PlatformSoundHandle& handle);
-extern void PlatformSetSoundVolume(const PlatformSoundHandle& handle, float volume);
-extern void PlatformSetSoundPitch(const PlatformSoundHandle& handle, float pitch);
-extern bool PlatformIsSoundPlaying(const PlatformSoundHandle& handle);
-extern float PlatformGetSoundVolume(const PlatformSoundHandle& handle);
-extern float PlatformGetSoundPitch(const PlatformSoundHandle& handle);
-extern void PlatformSetMasterVolume(float volume);
-extern void PlatformSetSoundVolume(float volume);
-extern void PlatformSetMusicVolume(float volume);
-extern float PlatformGetMasterVolume();
-extern float PlatformGetSoundVolume();
-extern float PlatformGetMusicVolume();
+extern void PlatformUpdateAudio();
+extern void MixAudio(float* out, u32 frame_count);
+extern u32 ReadMusicStream(i16* out, u32 frame_count, u32 channels);
+extern bool IsMusicStreamPlaying();
 
 // @http
 enum PlatformHttpStatus : u8 {
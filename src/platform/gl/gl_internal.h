@@ -24,6 +24,9 @@ enum UniformBufferType {
     UNIFORM_BUFFER_COUNT
 };
 
+// Segments in the uniform ring, each one fenced so the CPU never writes data the GPU may still read
+constexpr int UNIFORM_RING_SEGMENTS = 3;
+
 constexpr int VK_MAX_TEXTURES = 128;
 constexpr int VK_MAX_UNIFORM_BUFFERS = 8192;
 constexpr u32 VK_DYNAMIC_UNIFORM_BUFFER_SIZE = MAX_UNIFORM_BUFFER_SIZE * VK_MAX_UNIFORM_BUFFERS;
@@ -88,15 +91,36 @@ struct GLState {
     Vec2Int screen_size;         // Logical screen size (may be rotated)
     Vec2Int native_screen_size;   // Native/physical screen size
 
-    // Uniform buffer data (CPU-side, uploaded per-draw)
+    // Uniform buffer data (CPU-side, uploaded per-draw) and the bytes actually in use
     u8 uniform_data[UNIFORM_BUFFER_COUNT][MAX_UNIFORM_BUFFER_SIZE];
-
-    // GPU-side Uniform Buffer Objects
-    GLuint ubos[UNIFORM_BUFFER_COUNT];
+    u32 uniform_sizes[UNIFORM_BUFFER_COUNT];
+
+    // Uniform ring, draws append their dirty blocks at aligned offsets and bind them with
+    // glBindBufferRange.  The ring is persistently mapped when buffer storage is available.
+    GLuint uniform_ring;
+    u8* uniform_ring_mapped;
+    u8* uniform_ring_staging;
+    u32 uniform_ring_segment_size;
+    u32 uniform_ring_segment;
+    u32 uniform_ring_offset;
+    u32 uniform_ring_end;
+    u32 uniform_alignment;
+    GLsync uniform_ring_fences[UNIFORM_RING_SEGMENTS];
 
     // Dirty flags for uniform buffers (1 bit per buffer)
     u32 ubo_dirty_flags;
 
+    // Per frame instance stream, appended to by instanced draws and orphaned each frame
+    GLuint instance_buffer;
+    u32 instance_buffer_size;
+    u32 instance_buffer_offset;
+
+    // Per frame glyph stream for text quads, indexed by a static quad index buffer
+    GLuint glyph_buffer;
+    GLuint glyph_index_buffer;
+    u32 glyph_buffer_size;
+    u32 glyph_buffer_offset;
+
     // State caching for textures
     GLuint bound_textures[8];
 
@@ -112,6 +136,9 @@ struct GLState {
 
     // Stencil clipping
     int stencil_ref;
+
+    // Block compressed formats the driver can sample directly
+    bool texture_formats[TEXTURE_FORMAT_COUNT];
 };
 
 // Global GL state - defined in gles_render.cpp
@@ -119,3 +146,16 @@ extern GLState g_gl;
 
 // Debug test quad
 void DrawTestQuad();
+
+// Instance stream shared by the windows and web drivers
+void CreateInstanceBuffer();
+void DestroyInstanceBuffer();
+void CreateGlyphBuffer();
+void DestroyGlyphBuffer();
+
+// Compressed texture support shared by the windows and web drivers
+void InitTextureFormats();
+
+// Uniform ring shared by the windows and web drivers
+void CreateUniformRing();
+void DestroyUniformRing();
@@ -85,6 +85,9 @@ PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = nullptr;
 PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
 PFNGLVERTEXATTRIBIPOINTERPROC glVertexAttribIPointer = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = nullptr;
+PFNGLBINDATTRIBLOCATIONPROC glBindAttribLocation = nullptr;
 PFNGLVIEWPORTPROC glViewport = nullptr;
 PFNGLCLIPCONTROLPROC glClipControl = nullptr;
 PFNGLGETINTEGERVPROC glGetIntegerv = nullptr;
@@ -95,6 +98,15 @@ PFNGLCOLORMASKPROC glColorMask = nullptr;
 PFNGLCLEARSTENCILPROC glClearStencil = nullptr;
 PFNGLOBJECTLABELPROC glObjectLabel = nullptr;
 PFNGLDEBUGMESSAGECONTROLPROC glDebugMessageControl = nullptr;
+PFNGLGETSTRINGIPROC glGetStringi = nullptr;
+PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D = nullptr;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = nullptr;
+PFNGLFENCESYNCPROC glFenceSync = nullptr;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = nullptr;
+PFNGLDELETESYNCPROC glDeleteSync = nullptr;
+PFNGLBUFFERSTORAGEPROC glBufferStorage = nullptr;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
 #endif // NOZ_PLATFORM_WEB
 
 GLState g_gl = {};
@@ -213,7 +225,210 @@ void DestroyOffscreenTarget(OffscreenTarget& target) {
     }
 }
 
+// Instance attributes follow the MeshVertex attributes (0-8)
+constexpr GLuint INSTANCE_ATTRIBUTE_TRANSFORM = 9;
+constexpr GLuint INSTANCE_ATTRIBUTE_PARAMS = 12;
+constexpr GLuint INSTANCE_ATTRIBUTE_COLOR = 13;
+constexpr GLuint INSTANCE_ATTRIBUTE_EMISSION = 14;
+constexpr GLuint INSTANCE_ATTRIBUTE_COUNT = 6;
+
+static bool HasGLExtension(const char* suffix) {
+#ifndef NOZ_PLATFORM_WEB
+    if (!glGetStringi)
+        return false;
+#endif
+
+    // Match on the suffix so the WEBGL_ and EXT_ spellings of an extension both count
+    size_t suffix_length = strlen(suffix);
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if (!extension)
+            continue;
+
+        size_t length = strlen(extension);
+        if (length >= suffix_length && strcmp(extension + length - suffix_length, suffix) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static u32 AlignUniform(u32 size) {
+    return (size + g_gl.uniform_alignment - 1) / g_gl.uniform_alignment * g_gl.uniform_alignment;
+}
+
+void CreateUniformRing() {
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    g_gl.uniform_alignment = alignment > 0 ? (u32)alignment : 256;
+
+    // A segment must hold at least one draw with every block at full size
+    u32 min_segment_size = AlignUniform(MAX_UNIFORM_BUFFER_SIZE) * UNIFORM_BUFFER_COUNT;
+    g_gl.uniform_ring_segment_size = AlignUniform(Max(g_gl.traits.frame_uniform_memory_size, min_segment_size));
+
+    // Ranges are always bound at full block size, the tail keeps the last one inside the buffer
+    GLsizeiptr ring_size = (GLsizeiptr)g_gl.uniform_ring_segment_size * UNIFORM_RING_SEGMENTS + MAX_UNIFORM_BUFFER_SIZE;
+
+    glGenBuffers(1, &g_gl.uniform_ring);
+    glBindBuffer(GL_UNIFORM_BUFFER, g_gl.uniform_ring);
+
+#ifndef NOZ_PLATFORM_WEB
+    if (glBufferStorage && glMapBufferRange && HasGLExtension("buffer_storage")) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, ring_size, nullptr, flags);
+        g_gl.uniform_ring_mapped = (u8*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, ring_size, flags);
+    }
+#endif
+
+    if (!g_gl.uniform_ring_mapped) {
+        glBufferData(GL_UNIFORM_BUFFER, ring_size, nullptr, GL_STREAM_DRAW);
+        g_gl.uniform_ring_staging = (u8*)Alloc(ALLOCATOR_DEFAULT, min_segment_size);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    g_gl.uniform_ring_segment = 0;
+    g_gl.uniform_ring_offset = 0;
+    g_gl.uniform_ring_end = g_gl.uniform_ring_segment_size;
+
+    // Nothing is bound yet, the first draw uploads every block in full
+    for (int i = 0; i < UNIFORM_BUFFER_COUNT; i++)
+        g_gl.uniform_sizes[i] = MAX_UNIFORM_BUFFER_SIZE;
+    g_gl.ubo_dirty_flags = (1 << UNIFORM_BUFFER_COUNT) - 1;
+}
+
+void DestroyUniformRing() {
+    for (int i = 0; i < UNIFORM_RING_SEGMENTS; i++) {
+        if (g_gl.uniform_ring_fences[i]) {
+            glDeleteSync(g_gl.uniform_ring_fences[i]);
+            g_gl.uniform_ring_fences[i] = nullptr;
+        }
+    }
+
+#ifndef NOZ_PLATFORM_WEB
+    if (g_gl.uniform_ring_mapped) {
+        glBindBuffer(GL_UNIFORM_BUFFER, g_gl.uniform_ring);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        g_gl.uniform_ring_mapped = nullptr;
+    }
+#endif
+
+    if (g_gl.uniform_ring_staging) {
+        Free(g_gl.uniform_ring_staging);
+        g_gl.uniform_ring_staging = nullptr;
+    }
+
+    if (g_gl.uniform_ring) {
+        glDeleteBuffers(1, &g_gl.uniform_ring);
+        g_gl.uniform_ring = 0;
+    }
+}
+
+// Fence the segment being left and move to the next one, waiting for the GPU if it
+// is still reading it.  Called at the start of every frame and when a frame overflows.
+static void AdvanceUniformRing() {
+    u32 segment = g_gl.uniform_ring_segment;
+
+#ifndef NOZ_PLATFORM_WEB
+    // WebGL copies glBufferSubData data and cannot block on a fence, so it skips the sync
+    if (g_gl.uniform_ring_fences[segment])
+        glDeleteSync(g_gl.uniform_ring_fences[segment]);
+    g_gl.uniform_ring_fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+
+    segment = (segment + 1) % UNIFORM_RING_SEGMENTS;
+
+#ifndef NOZ_PLATFORM_WEB
+    if (GLsync fence = g_gl.uniform_ring_fences[segment]) {
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(fence);
+        g_gl.uniform_ring_fences[segment] = nullptr;
+    }
+#endif
+
+    g_gl.uniform_ring_segment = segment;
+    g_gl.uniform_ring_offset = segment * g_gl.uniform_ring_segment_size;
+    g_gl.uniform_ring_end = g_gl.uniform_ring_offset + g_gl.uniform_ring_segment_size;
+
+    // Bindings still point into older segments that will be overwritten, so re-upload everything
+    g_gl.ubo_dirty_flags = (1 << UNIFORM_BUFFER_COUNT) - 1;
+}
+
+void CreateInstanceBuffer() {
+    g_gl.instance_buffer_size = (u32)g_gl.traits.max_frame_instances * sizeof(PlatformInstance);
+    g_gl.instance_buffer_offset = 0;
+    glGenBuffers(1, &g_gl.instance_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, g_gl.instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, g_gl.instance_buffer_size, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DestroyInstanceBuffer() {
+    if (g_gl.instance_buffer) {
+        glDeleteBuffers(1, &g_gl.instance_buffer);
+        g_gl.instance_buffer = 0;
+    }
+}
+
+// Quads are drawn with a fixed index pattern, so one index buffer covers every glyph draw
+constexpr u32 MAX_GLYPH_DRAW_QUADS = 65536 / 4;
+constexpr GLuint GLYPH_UNUSED_ATTRIBUTES[] = { 1, 2, 4, 5, 6, 7 };
+
+void CreateGlyphBuffer() {
+    g_gl.glyph_buffer_size = (u32)g_gl.traits.max_frame_glyphs * 4 * sizeof(GlyphVertex);
+    g_gl.glyph_buffer_offset = 0;
+    glGenBuffers(1, &g_gl.glyph_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, g_gl.glyph_buffer);
+    glBufferData(GL_ARRAY_BUFFER, g_gl.glyph_buffer_size, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    u16* indices = static_cast<u16*>(Alloc(ALLOCATOR_DEFAULT, MAX_GLYPH_DRAW_QUADS * 6 * sizeof(u16)));
+    for (u32 i = 0; i < MAX_GLYPH_DRAW_QUADS; i++) {
+        u16 v = (u16)(i * 4);
+        u16* dst = indices + i * 6;
+        dst[0] = v; dst[1] = v + 1; dst[2] = v + 2;
+        dst[3] = v; dst[4] = v + 2; dst[5] = v + 3;
+    }
+
+    glGenBuffers(1, &g_gl.glyph_index_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_gl.glyph_index_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_GLYPH_DRAW_QUADS * 6 * sizeof(u16), indices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    Free(indices);
+}
+
+void DestroyGlyphBuffer() {
+    if (g_gl.glyph_buffer) {
+        glDeleteBuffers(1, &g_gl.glyph_buffer);
+        g_gl.glyph_buffer = 0;
+    }
+
+    if (g_gl.glyph_index_buffer) {
+        glDeleteBuffers(1, &g_gl.glyph_index_buffer);
+        g_gl.glyph_index_buffer = 0;
+    }
+}
+
 void PlatformBeginRender() {
+    // Orphan last frame's instances and glyphs so the driver never stalls on buffers still in flight
+    if (g_gl.instance_buffer) {
+        glBindBuffer(GL_ARRAY_BUFFER, g_gl.instance_buffer);
+        glBufferData(GL_ARRAY_BUFFER, g_gl.instance_buffer_size, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, g_gl.bound_vertex_buffer);
+    }
+    g_gl.instance_buffer_offset = 0;
+
+    if (g_gl.glyph_buffer) {
+        glBindBuffer(GL_ARRAY_BUFFER, g_gl.glyph_buffer);
+        glBufferData(GL_ARRAY_BUFFER, g_gl.glyph_buffer_size, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, g_gl.bound_vertex_buffer);
+    }
+    g_gl.glyph_buffer_offset = 0;
+
+    AdvanceUniformRing();
 }
 
 void PlatformBindSkeleton(const Mat3* bone_transforms, u8 bone_count) {
@@ -224,6 +439,7 @@ void PlatformBindSkeleton(const Mat3* bone_transforms, u8 bone_count) {
         *dst++ = m.m[1]; *dst++ = m.m[4]; *dst++ = m.m[7]; *dst++ = 0.0f;
         *dst++ = m.m[2]; *dst++ = m.m[5]; *dst++ = m.m[8]; *dst++ = 0.0f;
     }
+    g_gl.uniform_sizes[UNIFORM_BUFFER_SKELETON] = Min(bone_count, MAX_BONES) * 12 * sizeof(float);
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_SKELETON);
 }
 
@@ -237,16 +453,19 @@ void PlatformBindTransform(const Mat3& transform, float depth, float depth_scale
     obj->depth_scale = depth_scale;
     obj->depth_min = g_gl.traits.min_depth;
     obj->depth_max = g_gl.traits.max_depth;
+    g_gl.uniform_sizes[UNIFORM_BUFFER_OBJECT] = sizeof(ObjectBuffer);
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_OBJECT);
 }
 
 void PlatformBindVertexUserData(const u8* data, u32 size) {
     memcpy(g_gl.uniform_data[UNIFORM_BUFFER_VERTEX_USER], data, size);
+    g_gl.uniform_sizes[UNIFORM_BUFFER_VERTEX_USER] = size;
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_VERTEX_USER);
 }
 
 void PlatformBindFragmentUserData(const u8* data, u32 size) {
     memcpy(g_gl.uniform_data[UNIFORM_BUFFER_FRAGMENT_USER], data, size);
+    g_gl.uniform_sizes[UNIFORM_BUFFER_FRAGMENT_USER] = size;
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_FRAGMENT_USER);
 }
 
@@ -255,6 +474,7 @@ void PlatformBindCamera(const Mat3& view_matrix) {
     *dst++ = view_matrix.m[0]; *dst++ = view_matrix.m[3]; *dst++ = view_matrix.m[6]; *dst++ = 0.0f;
     *dst++ = view_matrix.m[1]; *dst++ = view_matrix.m[4]; *dst++ = view_matrix.m[7]; *dst++ = 0.0f;
     *dst++ = view_matrix.m[2]; *dst++ = view_matrix.m[5]; *dst++ = view_matrix.m[8]; *dst++ = 0.0f;
+    g_gl.uniform_sizes[UNIFORM_BUFFER_CAMERA] = 12 * sizeof(float);
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_CAMERA);
 }
 
@@ -263,6 +483,7 @@ void PlatformBindColor(const Color& color, const Vec2& color_uv_offset, const Co
     cb->color = color;
     cb->emission = emission;
     cb->uv_offset = color_uv_offset;
+    g_gl.uniform_sizes[UNIFORM_BUFFER_COLOR] = sizeof(ColorBuffer);
     g_gl.ubo_dirty_flags |= (1 << UNIFORM_BUFFER_COLOR);
 }
 
@@ -364,25 +585,143 @@ void PlatformBindIndexBuffer(PlatformBuffer* buffer) {
     g_gl.bound_index_buffer = ibo;
 }
 
-void PlatformDrawIndexed(u16 index_count) {
-    assert(index_count > 0);
+static u32 GetUniformUploadSize(u32 dirty_flags) {
+    u32 size = 0;
+    for (int i = 0; i < UNIFORM_BUFFER_COUNT; i++)
+        if (dirty_flags & (1 << i))
+            size += AlignUniform(g_gl.uniform_sizes[i]);
+    return size;
+}
 
-    // Upload only uniform buffers that changed since last draw
+static void UploadUniformBuffers() {
+    // Append only uniform buffers that changed since last draw, sized to the data actually written
+    if (!g_gl.ubo_dirty_flags)
+        return;
+
+    if (g_gl.uniform_ring_offset + GetUniformUploadSize(g_gl.ubo_dirty_flags) > g_gl.uniform_ring_end)
+        AdvanceUniformRing();
+
+    u32 base = g_gl.uniform_ring_offset;
+    u8* dst = g_gl.uniform_ring_mapped ? g_gl.uniform_ring_mapped + base : g_gl.uniform_ring_staging;
+    u32 cursor = 0;
     for (int i = 0; i < UNIFORM_BUFFER_COUNT; i++) {
         if (!(g_gl.ubo_dirty_flags & (1 << i)))
             continue;
-        glBindBuffer(GL_UNIFORM_BUFFER, g_gl.ubos[i]);
-        glBufferData(GL_UNIFORM_BUFFER, MAX_UNIFORM_BUFFER_SIZE, g_gl.uniform_data[i], GL_DYNAMIC_DRAW);
-        glBindBufferBase(GL_UNIFORM_BUFFER, i, g_gl.ubos[i]);
+
+        memcpy(dst + cursor, g_gl.uniform_data[i], g_gl.uniform_sizes[i]);
+
+        // Shaders may declare a larger block than was written, bind the full size so the range is valid
+        glBindBufferRange(GL_UNIFORM_BUFFER, i, g_gl.uniform_ring, base + cursor, MAX_UNIFORM_BUFFER_SIZE);
+        cursor += AlignUniform(g_gl.uniform_sizes[i]);
+    }
+
+    if (!g_gl.uniform_ring_mapped) {
+        glBindBuffer(GL_UNIFORM_BUFFER, g_gl.uniform_ring);
+        glBufferSubData(GL_UNIFORM_BUFFER, base, cursor, g_gl.uniform_ring_staging);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
+
+    g_gl.uniform_ring_offset += cursor;
     g_gl.ubo_dirty_flags = 0;
+}
 
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+void PlatformDrawIndexed(u16 index_count) {
+    assert(index_count > 0);
+    UploadUniformBuffers();
     glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_SHORT, nullptr);
 }
 
+void PlatformDrawIndexedInstanced(u16 index_count, const PlatformInstance* instances, u32 instance_count) {
+    assert(index_count > 0);
+    assert(instances);
+
+    u32 size = instance_count * sizeof(PlatformInstance);
+    if (g_gl.instance_buffer_offset + size > g_gl.instance_buffer_size) {
+        LogWarning("instance buffer full, dropping %u instances", instance_count);
+        return;
+    }
+
+    u32 offset = g_gl.instance_buffer_offset;
+    g_gl.instance_buffer_offset += size;
+
+    UploadUniformBuffers();
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_gl.instance_buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, instances);
+
+    for (GLuint i = 0; i < 3; i++) {
+        glEnableVertexAttribArray(INSTANCE_ATTRIBUTE_TRANSFORM + i);
+        glVertexAttribPointer(INSTANCE_ATTRIBUTE_TRANSFORM + i, 3, GL_FLOAT, GL_FALSE, sizeof(PlatformInstance), (void*)(offset + offsetof(PlatformInstance, transform) + i * 3 * sizeof(float)));
+    }
+
+    // depth followed by color_offset
+    glEnableVertexAttribArray(INSTANCE_ATTRIBUTE_PARAMS);
+    glVertexAttribPointer(INSTANCE_ATTRIBUTE_PARAMS, 3, GL_FLOAT, GL_FALSE, sizeof(PlatformInstance), (void*)(offset + offsetof(PlatformInstance, depth)));
+
+    glEnableVertexAttribArray(INSTANCE_ATTRIBUTE_COLOR);
+    glVertexAttribPointer(INSTANCE_ATTRIBUTE_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(PlatformInstance), (void*)(offset + offsetof(PlatformInstance, color)));
+
+    glEnableVertexAttribArray(INSTANCE_ATTRIBUTE_EMISSION);
+    glVertexAttribPointer(INSTANCE_ATTRIBUTE_EMISSION, 4, GL_FLOAT, GL_FALSE, sizeof(PlatformInstance), (void*)(offset + offsetof(PlatformInstance, emission)));
+
+    for (GLuint i = 0; i < INSTANCE_ATTRIBUTE_COUNT; i++)
+        glVertexAttribDivisor(INSTANCE_ATTRIBUTE_TRANSFORM + i, 1);
+
+    glDrawElementsInstanced(GL_TRIANGLES, index_count, GL_UNSIGNED_SHORT, nullptr, (GLsizei)instance_count);
+
+    // Leave the instance attributes disabled so regular draws never read them
+    for (GLuint i = 0; i < INSTANCE_ATTRIBUTE_COUNT; i++) {
+        glVertexAttribDivisor(INSTANCE_ATTRIBUTE_TRANSFORM + i, 0);
+        glDisableVertexAttribArray(INSTANCE_ATTRIBUTE_TRANSFORM + i);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_gl.bound_vertex_buffer);
+}
+
+// Glyph vertices feed the position, uv and color locations of the MeshVertex layout, the
+// remaining locations are disabled so they read constant defaults.  The caller rebinds a
+// mesh before its next mesh draw.
+void PlatformDrawGlyphs(const GlyphVertex* vertices, u32 quad_count) {
+    assert(vertices);
+    assert(quad_count > 0);
+
+    u32 size = quad_count * 4 * sizeof(GlyphVertex);
+    if (g_gl.glyph_buffer_offset + size > g_gl.glyph_buffer_size) {
+        LogWarning("glyph buffer full, dropping %u glyphs", quad_count);
+        return;
+    }
+
+    u32 offset = g_gl.glyph_buffer_offset;
+    g_gl.glyph_buffer_offset += size;
+
+    UploadUniformBuffers();
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_gl.glyph_buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, vertices);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_gl.glyph_index_buffer);
+
+    for (GLuint i : GLYPH_UNUSED_ATTRIBUTES)
+        glDisableVertexAttribArray(i);
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(3);
+    glEnableVertexAttribArray(8);
+
+    for (u32 first = 0; first < quad_count; first += MAX_GLYPH_DRAW_QUADS) {
+        u32 count = Min(quad_count - first, MAX_GLYPH_DRAW_QUADS);
+        uintptr_t base = offset + first * 4 * sizeof(GlyphVertex);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (void*)(base + offsetof(GlyphVertex, position)));
+        glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (void*)(base + offsetof(GlyphVertex, uv)));
+        glVertexAttribPointer(8, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(GlyphVertex), (void*)(base + offsetof(GlyphVertex, color)));
+        glDrawElements(GL_TRIANGLES, (GLsizei)(count * 6), GL_UNSIGNED_SHORT, nullptr);
+    }
+
+    g_gl.bound_vertex_buffer = 0;
+    g_gl.bound_index_buffer = 0;
+}
+
 PlatformTexture* PlatformCreateTexture(
-    void* data,
+    const void* data,
     size_t width,
     size_t height,
     int channels,
@@ -440,6 +779,79 @@ PlatformTexture* PlatformCreateTexture(
     return texture;
 }
 
+void InitTextureFormats() {
+    bool s3tc = HasGLExtension("texture_compression_s3tc") || HasGLExtension("compressed_texture_s3tc");
+    bool etc2 = HasGLExtension("ES3_compatibility") || HasGLExtension("compressed_texture_etc");
+#ifndef NOZ_PLATFORM_WEB
+    if (!glCompressedTexImage2D)
+        s3tc = etc2 = false;
+#endif
+
+    g_gl.texture_formats[TEXTURE_FORMAT_BC1] = s3tc;
+    g_gl.texture_formats[TEXTURE_FORMAT_BC3] = s3tc;
+    g_gl.texture_formats[TEXTURE_FORMAT_ETC2] = etc2;
+}
+
+bool PlatformIsTextureFormatSupported(TextureFormat format) {
+    return g_gl.texture_formats[format];
+}
+
+static GLenum ToGLCompressed(TextureFormat format) {
+    switch (format) {
+        case TEXTURE_FORMAT_BC1:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case TEXTURE_FORMAT_BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TEXTURE_FORMAT_ETC2:
+        default:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    }
+}
+
+PlatformTexture* PlatformCreateCompressedTexture(
+    const void* data,
+    u32 data_size,
+    size_t width,
+    size_t height,
+    TextureFormat format,
+    const SamplerOptions& sampler_options,
+    const char* name) {
+    if (!PlatformIsTextureFormatSupported(format))
+        return nullptr;
+
+    PlatformTexture* texture = new PlatformTexture();
+    texture->size = {static_cast<i32>(width), static_cast<i32>(height)};
+    texture->target = GL_TEXTURE_2D;
+    texture->channels = 4;
+    texture->sampler_options = sampler_options;
+
+    glGenTextures(1, &texture->gl_texture);
+    glBindTexture(GL_TEXTURE_2D, texture->gl_texture);
+
+    glCompressedTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        ToGLCompressed(format),
+        static_cast<GLsizei>(width),
+        static_cast<GLsizei>(height),
+        0,
+        static_cast<GLsizei>(data_size),
+        data);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, ToGL(sampler_options.filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, ToGL(sampler_options.filter));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ToGL(sampler_options.clamp));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ToGL(sampler_options.clamp));
+
+    if (glObjectLabel && name) {
+        glObjectLabel(GL_TEXTURE, texture->gl_texture, -1, name);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return texture;
+}
+
 void PlatformFree(PlatformTexture* texture) {
     if (!texture) return;
     if (texture->gl_texture)
@@ -784,6 +1196,16 @@ PlatformShader* PlatformCreateShader(
     glAttachShader(shader->program, vert_shader);
     glAttachShader(shader->program, frag_shader);
 
+    // GLES sources have their locations stripped, pin the instance stream by name
+    if (flags & SHADER_FLAGS_INSTANCED) {
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_TRANSFORM + 0, "i_transform0");
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_TRANSFORM + 1, "i_transform1");
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_TRANSFORM + 2, "i_transform2");
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_PARAMS, "i_params");
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_COLOR, "i_color");
+        glBindAttribLocation(shader->program, INSTANCE_ATTRIBUTE_EMISSION, "i_emission");
+    }
+
     glLinkProgram(shader->program);
 
     GLint success;
@@ -109,14 +109,10 @@ void InitWebGL(const RendererTraits* traits, const char* canvas_id) {
     // Set initial viewport
     glViewport(0, 0, g_gl.screen_size.x, g_gl.screen_size.y);
 
-    // Create Uniform Buffer Objects
-    glGenBuffers(UNIFORM_BUFFER_COUNT, g_gl.ubos);
-    for (int i = 0; i < UNIFORM_BUFFER_COUNT; i++) {
-        glBindBuffer(GL_UNIFORM_BUFFER, g_gl.ubos[i]);
-        glBufferData(GL_UNIFORM_BUFFER, MAX_UNIFORM_BUFFER_SIZE, nullptr, GL_DYNAMIC_DRAW);
-        glBindBufferBase(GL_UNIFORM_BUFFER, i, g_gl.ubos[i]);
-    }
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    CreateUniformRing();
+    CreateInstanceBuffer();
+    CreateGlyphBuffer();
+    InitTextureFormats();
 
     // Determine MSAA sample count
     int samples = 1;
@@ -171,8 +167,9 @@ void ShutdownWebGL() {
     // Delete offscreen target
     DestroyOffscreenTarget(g_gl.offscreen);
 
-    // Delete UBOs
-    glDeleteBuffers(UNIFORM_BUFFER_COUNT, g_gl.ubos);
+    DestroyUniformRing();
+    DestroyInstanceBuffer();
+    DestroyGlyphBuffer();
 
     if (g_gl.current_vao) {
         glDeleteVertexArrays(1, &g_gl.current_vao);
@@ -152,6 +152,9 @@ static void LoadGLESFunctions() {
     glUseProgram = (PFNGLUSEPROGRAMPROC)GetGLProcAddress("glUseProgram");
     glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)GetGLProcAddress("glVertexAttribPointer");
     glVertexAttribIPointer = (PFNGLVERTEXATTRIBIPOINTERPROC)GetGLProcAddress("glVertexAttribIPointer");
+    glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)GetGLProcAddress("glVertexAttribDivisor");
+    glDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)GetGLProcAddress("glDrawElementsInstanced");
+    glBindAttribLocation = (PFNGLBINDATTRIBLOCATIONPROC)GetGLProcAddress("glBindAttribLocation");
     glViewport = (PFNGLVIEWPORTPROC)GetGLProcAddress("glViewport");
     glClipControl = (PFNGLCLIPCONTROLPROC)GetGLProcAddress("glClipControl");
     glGetIntegerv = (PFNGLGETINTEGERVPROC)GetGLProcAddress("glGetIntegerv");
@@ -162,6 +165,15 @@ static void LoadGLESFunctions() {
     glClearStencil = (PFNGLCLEARSTENCILPROC)GetGLProcAddress("glClearStencil");
     glObjectLabel = (PFNGLOBJECTLABELPROC)GetGLProcAddress("glObjectLabel");
     glDebugMessageControl = (PFNGLDEBUGMESSAGECONTROLPROC)GetGLProcAddress("glDebugMessageControl");
+    glGetStringi = (PFNGLGETSTRINGIPROC)GetGLProcAddress("glGetStringi");
+    glCompressedTexImage2D = (PFNGLCOMPRESSEDTEXIMAGE2DPROC)GetGLProcAddress("glCompressedTexImage2D");
+    glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC)GetGLProcAddress("glBindBufferRange");
+    glFenceSync = (PFNGLFENCESYNCPROC)GetGLProcAddress("glFenceSync");
+    glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)GetGLProcAddress("glClientWaitSync");
+    glDeleteSync = (PFNGLDELETESYNCPROC)GetGLProcAddress("glDeleteSync");
+    glBufferStorage = (PFNGLBUFFERSTORAGEPROC)GetGLProcAddress("glBufferStorage");
+    glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)GetGLProcAddress("glMapBufferRange");
+    glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)GetGLProcAddress("glUnmapBuffer");
 
     // WGL extensions
     wglCreateContextAttribsARB_ptr = (wglCreateContextAttribsARB_t*)GetGLProcAddress("wglCreateContextAttribsARB");
@@ -298,14 +310,10 @@ void InitRenderDriver(const RendererTraits* traits, HWND hwnd) {
     // Set initial viewport
     glViewport(0, 0, g_gl.screen_size.x, g_gl.screen_size.y);
 
-    // Create Uniform Buffer Objects
-    glGenBuffers(UNIFORM_BUFFER_COUNT, g_gl.ubos);
-    for (int i = 0; i < UNIFORM_BUFFER_COUNT; i++) {
-        glBindBuffer(GL_UNIFORM_BUFFER, g_gl.ubos[i]);
-        glBufferData(GL_UNIFORM_BUFFER, MAX_UNIFORM_BUFFER_SIZE, nullptr, GL_DYNAMIC_DRAW);
-        glBindBufferBase(GL_UNIFORM_BUFFER, i, g_gl.ubos[i]);
-    }
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    CreateUniformRing();
+    CreateInstanceBuffer();
+    CreateGlyphBuffer();
+    InitTextureFormats();
 
     // Determine MSAA sample count
     int samples = 1;
@@ -353,8 +361,9 @@ void PlatformSetRenderSize(Vec2Int logical_size, Vec2Int native_size) {
 }
 
 void ShutdownRenderDriver() {
-    // Delete UBOs
-    glDeleteBuffers(UNIFORM_BUFFER_COUNT, g_gl.ubos);
+    DestroyUniformRing();
+    DestroyInstanceBuffer();
+    DestroyGlyphBuffer();
 
     if (g_gl.current_vao) {
         glDeleteVertexArrays(1, &g_gl.current_vao);
@@ -7,6 +7,10 @@
 #include <QuartzCore/CAMetalLayer.h>
 #include <filesystem>
 #include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 extern void InitMetal(const RendererTraits* traits, NSWindow* window, CAMetalLayer* layer);
 extern void ResizeMetal(const Vec2Int& screen_size);
@@ -374,6 +378,33 @@ u8* PlatformLoadPersistentData(Allocator* allocator, const char* name, u32* out_
     return data;
 }
 
+const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size) {
+    *out_size = 0;
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size > U32_MAX) {
+        close(fd);
+        return nullptr;
+    }
+
+    // The mapping keeps the file alive, the descriptor is not needed past this point
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    *out_size = static_cast<u32>(st.st_size);
+    return static_cast<const u8*>(data);
+}
+
+void PlatformUnmapFile(const u8* data, u32 size) {
+    if (data)
+        munmap(const_cast<u8*>(data), size);
+}
+
 extern int main(int argc, char* argv[]);
 
 int main(int argc, char* argv[])
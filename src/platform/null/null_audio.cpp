@@ -0,0 +1,45 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Headless sink, the mixer runs on the main thread each frame for the wall clock time that has
+//  passed and the output is discarded.  Voices end and get stolen just as they would on a device.
+//
+
+#include "null_internal.h"
+
+constexpr u32 NULL_AUDIO_BUFFER_FRAMES = 1024;
+constexpr u32 NULL_AUDIO_MAX_FRAMES = AUDIO_SAMPLE_RATE / 4;    // Cap after a stall so one frame never mixes seconds
+
+struct NullAudio {
+    u64 last_time;
+    u64 pending;        // Elapsed time counter ticks times AUDIO_SAMPLE_RATE not yet mixed
+    float buffer[NULL_AUDIO_BUFFER_FRAMES * AUDIO_CHANNELS];
+};
+
+static NullAudio g_null_audio = {};
+
+void PlatformInitAudio() {
+    g_null_audio = {};
+    g_null_audio.last_time = PlatformGetTimeCounter();
+}
+
+void PlatformShutdownAudio() {
+    g_null_audio = {};
+}
+
+void PlatformUpdateAudio() {
+    u64 now = PlatformGetTimeCounter();
+    u64 frequency = PlatformGetTimeFrequency();
+    g_null_audio.pending += (now - g_null_audio.last_time) * AUDIO_SAMPLE_RATE;
+    g_null_audio.last_time = now;
+
+    u64 frame_count = g_null_audio.pending / frequency;
+    g_null_audio.pending -= frame_count * frequency;
+    frame_count = Min(frame_count, static_cast<u64>(NULL_AUDIO_MAX_FRAMES));
+
+    while (frame_count > 0) {
+        u32 count = static_cast<u32>(Min(frame_count, static_cast<u64>(NULL_AUDIO_BUFFER_FRAMES)));
+        MixAudio(g_null_audio.buffer, count);
+        frame_count -= count;
+    }
+}
@@ -0,0 +1,200 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Scripted input.  Each line of an input script is "<frame> <code> <value>" where code
+//  is an InputCode value or key label ("A", "F1", "ESC").  Buttons are down while value
+//  is non zero and axes take the value directly.  "<frame> mouse <x> <y>" moves the
+//  mouse and "<frame> scroll <x> <y>" scrolls for that frame only.  Lines starting
+//  with # are ignored.
+//
+
+#include "null_internal.h"
+
+extern const char* g_input_code_strings[INPUT_CODE_COUNT];
+
+constexpr int MAX_INPUT_SCRIPT_EVENTS = 4096;
+
+enum NullInputEventType {
+    NULL_INPUT_EVENT_CODE,
+    NULL_INPUT_EVENT_MOUSE,
+    NULL_INPUT_EVENT_SCROLL
+};
+
+struct NullInputEvent {
+    u64 frame;
+    NullInputEventType type;
+    InputCode code;
+    Vec2 value;
+};
+
+struct NullInput {
+    float values[INPUT_CODE_COUNT];
+    Vec2 mouse_position;
+    Vec2 mouse_scroll;
+    NullInputEvent* events;
+    int event_count;
+    int next_event;
+};
+
+static NullInput g_null_input = {};
+
+static InputCode ParseInputCode(const char* name) {
+    char* end = nullptr;
+    long value = strtol(name, &end, 10);
+    if (end && *end == 0)
+        return value > INPUT_CODE_NONE && value < INPUT_CODE_COUNT ? (InputCode)value : INPUT_CODE_NONE;
+
+    for (int i = 0; i < INPUT_CODE_COUNT; i++)
+        if (g_input_code_strings[i] && strcmp(g_input_code_strings[i], name) == 0)
+            return (InputCode)i;
+
+    return INPUT_CODE_NONE;
+}
+
+void LoadInputScript(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        LogError("failed to open input script '%s'", path);
+        return;
+    }
+
+    if (!g_null_input.events)
+        g_null_input.events = (NullInputEvent*)Alloc(ALLOCATOR_DEFAULT, sizeof(NullInputEvent) * MAX_INPUT_SCRIPT_EVENTS);
+
+    g_null_input.event_count = 0;
+    g_null_input.next_event = 0;
+
+    char line[256];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        if (line[0] == '#')
+            continue;
+
+        unsigned long long frame;
+        char name[64];
+        float x = 0.0f;
+        float y = 0.0f;
+        int count = sscanf(line, "%llu %63s %f %f", &frame, name, &x, &y);
+        if (count < 3)
+            continue;
+
+        if (g_null_input.event_count >= MAX_INPUT_SCRIPT_EVENTS) {
+            LogWarning("%s: too many input events, ignoring the rest", path);
+            break;
+        }
+
+        NullInputEvent event = { .frame = frame, .type = NULL_INPUT_EVENT_CODE, .code = INPUT_CODE_NONE, .value = { x, y } };
+        if (strcmp(name, "mouse") == 0) {
+            event.type = NULL_INPUT_EVENT_MOUSE;
+        } else if (strcmp(name, "scroll") == 0) {
+            event.type = NULL_INPUT_EVENT_SCROLL;
+        } else {
+            event.code = ParseInputCode(name);
+            if (event.code == INPUT_CODE_NONE) {
+                LogWarning("%s(%d): unknown input code '%s'", path, line_number, name);
+                continue;
+            }
+        }
+
+        // Keep the script ordered by frame so playback only ever looks at the front
+        int insert = g_null_input.event_count++;
+        while (insert > 0 && g_null_input.events[insert - 1].frame > event.frame) {
+            g_null_input.events[insert] = g_null_input.events[insert - 1];
+            insert--;
+        }
+        g_null_input.events[insert] = event;
+    }
+
+    fclose(file);
+}
+
+void UpdateInputScript(u64 frame) {
+    g_null_input.mouse_scroll = VEC2_ZERO;
+
+    while (g_null_input.next_event < g_null_input.event_count) {
+        NullInputEvent& event = g_null_input.events[g_null_input.next_event];
+        if (event.frame > frame)
+            break;
+
+        switch (event.type) {
+        case NULL_INPUT_EVENT_CODE:
+            g_null_input.values[event.code] = event.value.x;
+            break;
+
+        case NULL_INPUT_EVENT_MOUSE:
+            g_null_input.mouse_position = event.value;
+            break;
+
+        case NULL_INPUT_EVENT_SCROLL:
+            g_null_input.mouse_scroll = event.value;
+            break;
+        }
+
+        g_null_input.next_event++;
+    }
+}
+
+void PlatformInitInput() {
+    g_null_input.mouse_position = VEC2_ZERO;
+    g_null_input.mouse_scroll = VEC2_ZERO;
+}
+
+void PlatformShutdownInput() {
+    Free(g_null_input.events);
+    g_null_input = {};
+}
+
+void PlatformUpdateInputState() {
+}
+
+bool PlatformIsInputButtonDown(InputCode code) {
+    return g_null_input.values[code] != 0.0f;
+}
+
+float PlatformGetInputAxisValue(InputCode code) {
+    if (code == MOUSE_X) return g_null_input.mouse_position.x;
+    if (code == MOUSE_Y) return g_null_input.mouse_position.y;
+    if (code == MOUSE_SCROLL_X) return g_null_input.mouse_scroll.x;
+    if (code == MOUSE_SCROLL_Y) return g_null_input.mouse_scroll.y;
+    return g_null_input.values[code];
+}
+
+Vec2 PlatformGetMousePosition() {
+    return g_null_input.mouse_position;
+}
+
+Vec2 PlatformGetMouseScroll() {
+    return g_null_input.mouse_scroll;
+}
+
+bool PlatformIsGamepadActive() {
+    return false;
+}
+
+bool PlatformIsMouseOverWindow() {
+    return true;
+}
+
+void PlatformShowTextbox(const noz::Rect& rect, const Text& text, const NativeTextboxStyle& style) {
+    (void)rect;
+    (void)text;
+    (void)style;
+}
+
+void PlatformHideTextbox() {
+}
+
+void PlatformUpdateTextboxRect(const noz::Rect& rect, int font_size) {
+    (void)rect;
+    (void)font_size;
+}
+
+bool PlatformUpdateTextboxText(Text& text) {
+    (void)text;
+    return false;
+}
+
+bool PlatformIsTextboxVisible() {
+    return false;
+}
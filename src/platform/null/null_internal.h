@@ -0,0 +1,36 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Internal shared definitions for the headless platform
+//
+
+#pragma once
+
+#include "../../platform.h"
+#include "../../internal.h"
+
+// Everything the recording renderer was asked to do, accumulated since init
+struct NullRenderStats {
+    u64 frames;
+    u64 draws;
+    u64 instanced_draws;
+    u64 instances;
+    u64 glyphs;
+    u64 indices;
+    u64 shader_binds;
+    u64 texture_binds;
+    u64 buffer_binds;
+    u64 uniform_binds;
+    u64 buffer_bytes;
+    u64 texture_bytes;
+    u64 uniform_bytes;
+    u64 instance_bytes;
+    u64 glyph_bytes;
+};
+
+extern void InitRenderDriver(const RendererTraits* traits, const Vec2Int& screen_size);
+extern void ShutdownRenderDriver();
+extern const NullRenderStats& GetNullRenderStats();
+
+extern void LoadInputScript(const char* path);
+extern void UpdateInputScript(u64 frame);
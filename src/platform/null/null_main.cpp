@@ -0,0 +1,303 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Headless platform.  Runs Main() without a window, GPU or audio device, which makes
+//  it suitable for CI and performance regression runs.  Command line options:
+//
+//    --frames <count>   Exit after running count frames (0 runs until exit is requested)
+//    --input <path>     Play back a scripted input file (see null_input.cpp)
+//
+
+#include "null_internal.h"
+#include <filesystem>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct NullApp {
+    const ApplicationTraits* traits;
+    Vec2Int screen_size;
+    void (*on_close) ();
+    u64 frame;
+    bool driver_initialized;
+};
+
+static NullApp g_null = {};
+
+void ThreadSleep(int milliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+void ThreadYield() {
+    std::this_thread::yield();
+}
+
+void PlatformSetThreadName(const char* name) {
+#if defined(__linux__)
+    // Linux limits thread names to 15 characters
+    char short_name[16];
+    Copy(short_name, sizeof(short_name), name);
+    pthread_setname_np(pthread_self(), short_name);
+#elif defined(__APPLE__)
+    pthread_setname_np(name);
+#else
+    (void)name;
+#endif
+}
+
+u64 PlatformGetThreadId() {
+    return static_cast<u64>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+void PlatformInit(const ApplicationTraits* traits) {
+    g_null = {};
+    g_null.traits = traits;
+}
+
+void PlatformInitWindow(void (*on_close)()) {
+    g_null.on_close = on_close;
+    g_null.screen_size = { g_null.traits->width, g_null.traits->height };
+
+    InitRenderDriver(&g_null.traits->renderer, g_null.screen_size);
+    g_null.driver_initialized = true;
+}
+
+void PlatformShutdown() {
+    if (!g_null.driver_initialized)
+        return;
+
+    ShutdownRenderDriver();
+    g_null.driver_initialized = false;
+}
+
+bool PlatformUpdate() {
+    UpdateInputScript(g_null.frame++);
+    return true;
+}
+
+void PlatformFocusWindow() {
+}
+
+bool PlatformIsWindowFocused() {
+    return true;
+}
+
+bool PlatformIsWindowResizing() {
+    return false;
+}
+
+noz::RectInt PlatformGetWindowRect() {
+    return noz::RectInt{0, 0, g_null.screen_size.x, g_null.screen_size.y};
+}
+
+Vec2Int PlatformGetWindowSize() {
+    return g_null.screen_size;
+}
+
+void PlatformSetCursor(SystemCursor cursor) {
+    (void)cursor;
+}
+
+float PlatformGetSystemDPIScale() {
+    return 1.0f;
+}
+
+std::filesystem::path PlatformGetSaveGamePath() {
+    std::filesystem::path save_path;
+    if (const char* data_home = getenv("XDG_DATA_HOME"); data_home && *data_home)
+        save_path = data_home;
+    else if (const char* home = getenv("HOME"); home && *home)
+        save_path = std::filesystem::path(home) / ".local" / "share";
+    else
+        save_path = ".";
+
+    save_path /= g_null.traits->name;
+
+    std::error_code ec;
+    std::filesystem::create_directories(save_path, ec);
+
+    return save_path;
+}
+
+bool PlatformSavePersistentData(const char* name, const void* data, u32 size) {
+    std::filesystem::path path = PlatformGetSaveGamePath() / name;
+
+    FILE* file = fopen(path.string().c_str(), "wb");
+    if (!file)
+        return false;
+
+    u32 written = static_cast<u32>(fwrite(data, 1, size, file));
+    fclose(file);
+
+    return written == size;
+}
+
+u8* PlatformLoadPersistentData(Allocator* allocator, const char* name, u32* out_size) {
+    std::filesystem::path path = PlatformGetSaveGamePath() / name;
+
+    FILE* file = fopen(path.string().c_str(), "rb");
+    if (!file) {
+        *out_size = 0;
+        return nullptr;
+    }
+
+    fseek(file, 0, SEEK_END);
+    u32 file_size = static_cast<u32>(ftell(file));
+    fseek(file, 0, SEEK_SET);
+
+    if (file_size == 0) {
+        fclose(file);
+        *out_size = 0;
+        return nullptr;
+    }
+
+    u8* data = static_cast<u8*>(Alloc(allocator, file_size));
+    *out_size = static_cast<u32>(fread(data, 1, file_size, file));
+    fclose(file);
+
+    return data;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size) {
+    *out_size = 0;
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || st.st_size > U32_MAX) {
+        close(fd);
+        return nullptr;
+    }
+
+    // The mapping keeps the file alive, the descriptor is not needed past this point
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    *out_size = static_cast<u32>(st.st_size);
+    return static_cast<const u8*>(data);
+}
+
+void PlatformUnmapFile(const u8* data, u32 size) {
+    if (data)
+        munmap(const_cast<u8*>(data), size);
+}
+#else
+const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size) {
+    (void)path;
+    *out_size = 0;
+    return nullptr;
+}
+
+void PlatformUnmapFile(const u8* data, u32 size) {
+    (void)data;
+    (void)size;
+}
+#endif
+
+std::filesystem::path PlatformGetBinaryPath() {
+    std::error_code ec;
+    std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", ec);
+    return ec ? std::filesystem::current_path() : path;
+}
+
+std::filesystem::path PatformGetCurrentPath() {
+    return std::filesystem::current_path();
+}
+
+void PlatformLog(LogType type, const char* message) {
+    FILE* stream = type == LOG_TYPE_ERROR || type == LOG_TYPE_WARNING ? stderr : stdout;
+    fputs(message, stream);
+    fputc('\n', stream);
+}
+
+bool PlatformIsMobile() {
+    return false;
+}
+
+bool PlatformIsPortrait() {
+    return g_null.screen_size.y > g_null.screen_size.x;
+}
+
+void PlatformRequestLandscape() {
+}
+
+void PlatformRequestFullscreen() {
+}
+
+bool PlatformIsFullscreen() {
+    return false;
+}
+
+void PlatformOpenUrl(const char* url) {
+    (void)url;
+}
+
+// Parse command-line arguments in key=value format as query params
+static void ParseCommandLineQueryParams(int argc, char** argv) {
+    InitQueryParams();
+
+    for (int i = 1; i < argc; i++) {
+        char* arg = argv[i];
+        char* eq = strchr(arg, '=');
+        if (eq && eq != arg) {
+            size_t name_len = eq - arg;
+            char name[256];
+            if (name_len >= sizeof(name)) name_len = sizeof(name) - 1;
+            memcpy(name, arg, name_len);
+            name[name_len] = '\0';
+
+            SetQueryParam(name, eq + 1);
+        }
+    }
+}
+
+static void LogRunStats(u64 frame_count, u64 elapsed_ticks) {
+    const NullRenderStats& stats = GetNullRenderStats();
+    double elapsed_ms = (double)elapsed_ticks * 1000.0 / (double)PlatformGetTimeFrequency();
+    double frames = (double)Max(frame_count, (u64)1);
+
+    LogInfo("headless: %llu frames in %.1f ms (%.3f ms/frame)", frame_count, elapsed_ms, elapsed_ms / frames);
+    LogInfo("headless: draws %.1f/frame (%.1f instanced, %.1f instances)",
+        stats.draws / frames, stats.instanced_draws / frames, stats.instances / frames);
+    LogInfo("headless: binds %.1f shader, %.1f texture, %.1f buffer, %.1f uniform per frame",
+        stats.shader_binds / frames, stats.texture_binds / frames, stats.buffer_binds / frames, stats.uniform_binds / frames);
+    LogInfo("headless: uploaded %llu uniform, %llu instance, %llu buffer, %llu texture bytes",
+        stats.uniform_bytes, stats.instance_bytes, stats.buffer_bytes, stats.texture_bytes);
+}
+
+int main(int argc, char** argv) {
+    InitCommandLine(argc, argv);
+    ParseCommandLineQueryParams(argc, argv);
+
+    u64 max_frames = 0;
+    if (const char* frames = GetArgValue("frames"))
+        max_frames = strtoull(frames, nullptr, 10);
+
+    Main();
+
+    if (const char* input = GetArgValue("input"))
+        LoadInputScript(input);
+
+    u64 frame_count = 0;
+    u64 start = PlatformGetTimeCounter();
+    while (IsApplicationRunning() && (max_frames == 0 || frame_count < max_frames)) {
+        RunApplicationFrame();
+        frame_count++;
+    }
+
+    LogRunStats(frame_count, PlatformGetTimeCounter() - start);
+
+    ShutdownApplication();
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+//  Recording renderer, draws nothing but counts what it was asked to do
+//
+
+#include "null_internal.h"
+
+struct PlatformBuffer {
+    u32 size;
+};
+
+struct PlatformTexture {
+    Vec2Int size;
+    int channels;
+    int layer_count;
+};
+
+struct PlatformShader {
+    ShaderFlags flags;
+};
+
+struct NullRenderer {
+    RendererTraits traits;
+    Vec2Int screen_size;
+    NullRenderStats stats;
+    PlatformShader* bound_shader;
+};
+
+static NullRenderer g_null_render = {};
+
+const NullRenderStats& GetNullRenderStats() {
+    return g_null_render.stats;
+}
+
+void InitRenderDriver(const RendererTraits* traits, const Vec2Int& screen_size) {
+    g_null_render = {};
+    g_null_render.traits = *traits;
+    g_null_render.screen_size = screen_size;
+}
+
+void ShutdownRenderDriver() {
+}
+
+void PlatformSetRenderSize(Vec2Int logical_size, Vec2Int native_size) {
+    (void)native_size;
+    g_null_render.screen_size = logical_size;
+}
+
+void PlatformBeginRender() {
+}
+
+void PlatformEndRender() {
+    g_null_render.stats.frames++;
+}
+
+void PlatformBeginScenePass(Color clear_color) {
+    (void)clear_color;
+}
+
+void PlatformEndScenePass() {
+}
+
+void PlatformEnablePostProcess(bool enabled) {
+    (void)enabled;
+}
+
+void PlatformBeginPostProcPass() {
+}
+
+void PlatformEndPostProcPass() {
+}
+
+void PlatformBeginUIPass() {
+}
+
+void PlatformEndUIPass() {
+}
+
+void PlatformBeginCompositePass() {
+}
+
+void PlatformEndCompositePass() {
+}
+
+void PlatformBindSceneTexture() {
+    g_null_render.stats.texture_binds++;
+}
+
+void PlatformBindUITexture() {
+    g_null_render.stats.texture_binds++;
+}
+
+void PlatformBindSceneTextureOnly() {
+    g_null_render.stats.texture_binds++;
+}
+
+void PlatformBindUITextureOnly() {
+    g_null_render.stats.texture_binds++;
+}
+
+void PlatformSetViewport(const noz::Rect& viewport) {
+    (void)viewport;
+}
+
+void PlatformBeginClip() {
+}
+
+void PlatformEndClipWrite() {
+}
+
+void PlatformEndClip() {
+}
+
+// Uniform sizes match the std140 layouts the GPU backends upload
+static void AddUniformBind(u32 size) {
+    g_null_render.stats.uniform_binds++;
+    g_null_render.stats.uniform_bytes += size;
+}
+
+void PlatformBindSkeleton(const Mat3* bone_transforms, u8 bone_count) {
+    (void)bone_transforms;
+    AddUniformBind(bone_count * sizeof(float) * 12);
+}
+
+void PlatformBindTransform(const Mat3& transform, float depth, float depth_scale) {
+    (void)transform;
+    (void)depth;
+    (void)depth_scale;
+    AddUniformBind(sizeof(float) * 16);
+}
+
+void PlatformBindVertexUserData(const u8* data, u32 size) {
+    (void)data;
+    AddUniformBind(size);
+}
+
+void PlatformBindFragmentUserData(const u8* data, u32 size) {
+    (void)data;
+    AddUniformBind(size);
+}
+
+void PlatformBindCamera(const Mat3& view_matrix) {
+    (void)view_matrix;
+    AddUniformBind(sizeof(float) * 12);
+}
+
+void PlatformBindColor(const Color& color, const Vec2& color_uv_offset, const Color& emission) {
+    (void)color;
+    (void)color_uv_offset;
+    (void)emission;
+    AddUniformBind(sizeof(float) * 12);
+}
+
+static PlatformBuffer* CreateBuffer(u32 size) {
+    PlatformBuffer* buffer = new PlatformBuffer();
+    buffer->size = size;
+    g_null_render.stats.buffer_bytes += size;
+    return buffer;
+}
+
+PlatformBuffer* PlatformCreateVertexBuffer(const MeshVertex* vertices, u16 vertex_count, const char* name, BufferFlags flags) {
+    (void)vertices;
+    (void)name;
+    (void)flags;
+    return CreateBuffer(vertex_count * sizeof(MeshVertex));
+}
+
+PlatformBuffer* PlatformCreateIndexBuffer(const u16* indices, u16 index_count, const char* name, BufferFlags flags) {
+    (void)indices;
+    (void)name;
+    (void)flags;
+    return CreateBuffer(index_count * sizeof(u16));
+}
+
+void PlatformUpdateVertexBuffer(PlatformBuffer* buffer, const MeshVertex* vertices, u16 vertex_count) {
+    (void)buffer;
+    (void)vertices;
+    g_null_render.stats.buffer_bytes += vertex_count * sizeof(MeshVertex);
+}
+
+void PlatformUpdateIndexBuffer(PlatformBuffer* buffer, const u16* indices, u16 index_count) {
+    (void)buffer;
+    (void)indices;
+    g_null_render.stats.buffer_bytes += index_count * sizeof(u16);
+}
+
+void PlatformFree(PlatformBuffer* buffer) {
+    delete buffer;
+}
+
+void PlatformBindVertexBuffer(PlatformBuffer* buffer) {
+    assert(buffer);
+    g_null_render.stats.buffer_binds++;
+}
+
+void PlatformBindIndexBuffer(PlatformBuffer* buffer) {
+    assert(buffer);
+    g_null_render.stats.buffer_binds++;
+}
+
+void PlatformDrawIndexed(u16 index_count) {
+    assert(index_count > 0);
+    g_null_render.stats.draws++;
+    g_null_render.stats.indices += index_count;
+}
+
+void PlatformDrawIndexedInstanced(u16 index_count, const PlatformInstance* instances, u32 instance_count) {
+    assert(index_count > 0);
+    assert(instances);
+    g_null_render.stats.draws++;
+    g_null_render.stats.instanced_draws++;
+    g_null_render.stats.instances += instance_count;
+    g_null_render.stats.indices += (u64)index_count * instance_count;
+    g_null_render.stats.instance_bytes += instance_count * sizeof(PlatformInstance);
+}
+
+void PlatformDrawGlyphs(const GlyphVertex* vertices, u32 quad_count) {
+    assert(vertices);
+    assert(quad_count > 0);
+    g_null_render.stats.draws++;
+    g_null_render.stats.glyphs += quad_count;
+    g_null_render.stats.indices += (u64)quad_count * 6;
+    g_null_render.stats.glyph_bytes += quad_count * 4 * sizeof(GlyphVertex);
+}
+
+PlatformTexture* PlatformCreateTexture(
+    const void* data,
+    size_t width,
+    size_t height,
+    int channels,
+    const SamplerOptions& sampler_options,
+    const char* name) {
+    (void)data;
+    (void)sampler_options;
+    (void)name;
+
+    PlatformTexture* texture = new PlatformTexture();
+    texture->size = {static_cast<i32>(width), static_cast<i32>(height)};
+    texture->channels = channels;
+    texture->layer_count = 1;
+    g_null_render.stats.texture_bytes += width * height * channels;
+    return texture;
+}
+
+PlatformTexture* PlatformCreateCompressedTexture(
+    const void* data,
+    u32 data_size,
+    size_t width,
+    size_t height,
+    TextureFormat format,
+    const SamplerOptions& sampler_options,
+    const char* name) {
+    (void)data;
+    (void)format;
+    (void)sampler_options;
+    (void)name;
+
+    PlatformTexture* texture = new PlatformTexture();
+    texture->size = {static_cast<i32>(width), static_cast<i32>(height)};
+    texture->channels = 4;
+    texture->layer_count = 1;
+    g_null_render.stats.texture_bytes += data_size;
+    return texture;
+}
+
+bool PlatformIsTextureFormatSupported(TextureFormat format) {
+    (void)format;
+    return true;
+}
+
+PlatformTexture* PlatformCreateTextureArray(
+    void** layer_data,
+    int layer_count,
+    size_t width,
+    size_t height,
+    int channels,
+    const SamplerOptions& sampler_options,
+    const char* name) {
+    (void)sampler_options;
+    (void)name;
+
+    if (layer_count <= 0 || !layer_data) return nullptr;
+
+    PlatformTexture* texture = new PlatformTexture();
+    texture->size = {static_cast<i32>(width), static_cast<i32>(height)};
+    texture->channels = channels;
+    texture->layer_count = layer_count;
+    g_null_render.stats.texture_bytes += width * height * channels * layer_count;
+    return texture;
+}
+
+void PlatformUpdateTexture(PlatformTexture* texture, void* data) {
+    (void)data;
+    if (!texture) return;
+    g_null_render.stats.texture_bytes += (u64)texture->size.x * texture->size.y * texture->channels * texture->layer_count;
+}
+
+void PlatformFree(PlatformTexture* texture) {
+    delete texture;
+}
+
+void PlatformBindTexture(PlatformTexture* texture, int slot) {
+    (void)texture;
+    (void)slot;
+    g_null_render.stats.texture_binds++;
+}
+
+PlatformShader* PlatformCreateShader(
+    const void* vertex,
+    u32 vertex_size,
+    const void* fragment,
+    u32 fragment_size,
+    ShaderFlags flags,
+    const char* name) {
+    (void)vertex;
+    (void)vertex_size;
+    (void)fragment;
+    (void)fragment_size;
+    (void)name;
+
+    PlatformShader* shader = new PlatformShader();
+    shader->flags = flags;
+    return shader;
+}
+
+void PlatformFree(PlatformShader* shader) {
+    if (g_null_render.bound_shader == shader)
+        g_null_render.bound_shader = nullptr;
+    delete shader;
+}
+
+void PlatformBindShader(PlatformShader* shader) {
+    if (!shader || shader == g_null_render.bound_shader)
+        return;
+
+    g_null_render.bound_shader = shader;
+    g_null_render.stats.shader_binds++;
+}
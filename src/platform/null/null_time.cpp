@@ -0,0 +1,15 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "../../platform.h"
+#include <chrono>
+
+u64 PlatformGetTimeCounter() {
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+u64 PlatformGetTimeFrequency() {
+    return 1000000000ull;
+}
@@ -41,9 +41,9 @@ void PlatformFree(const PlatformWebSocketHandle& handle) {
     (void)handle;
 }
 
-WebSocketStatus PlatformGetStatus(const PlatformWebSocketHandle& handle) {
+noz::WebSocketStatus PlatformGetStatus(const PlatformWebSocketHandle& handle) {
     (void)handle;
-    return WebSocketStatus::Error;
+    return noz::WebSocketStatus::Error;
 }
 
 bool PlatformHasMessages(const PlatformWebSocketHandle& handle) {
@@ -51,7 +51,7 @@ bool PlatformHasMessages(const PlatformWebSocketHandle& handle) {
     return false;
 }
 
-bool PlatformGetMessage(const PlatformWebSocketHandle& handle, WebSocketMessageType* out_type, u8** out_data, u32* out_size) {
+bool PlatformGetMessage(const PlatformWebSocketHandle& handle, noz::WebSocketMessageType* out_type, u8** out_data, u32* out_size) {
     (void)handle;
     (void)out_type;
     (void)out_data;
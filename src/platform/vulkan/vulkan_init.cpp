@@ -2,6 +2,7 @@
 //  NoZ - Copyright(c) 2026 NoZ Games, LLC
 //
 
+#include "../../platform.h"
 #include "../vulkan/vulkan_render.h"
 
 const char* VK_UNIFORM_BUFFER_NAMES[] = {
@@ -15,15 +16,15 @@ const char* VK_UNIFORM_BUFFER_NAMES[] = {
 
 static_assert(sizeof(VK_UNIFORM_BUFFER_NAMES) / sizeof(const char*) == UNIFORM_BUFFER_COUNT);
 
-static void InitUniformBuffer(DynamicBuffer* buffer, const char* name) {
-    buffer->size = VK_DYNAMIC_UNIFORM_BUFFER_SIZE;
-    buffer->alignment = g_vulkan.min_uniform_buffer_offset_alignment;
+static void InitDynamicBuffer(DynamicBuffer* buffer, u32 size, u32 alignment, VkBufferUsageFlags usage, const char* name) {
+    buffer->size = size;
+    buffer->alignment = alignment;
     buffer->offset = 0;
 
     VkBufferCreateInfo buffer_info = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .size = buffer->size,
-        .usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        .usage = usage,
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE
     };
 
@@ -48,7 +49,21 @@ static void InitUniformBuffer(DynamicBuffer* buffer, const char* name) {
 
 static void InitUniformBuffers() {
     for (u32 i = 0; i < UNIFORM_BUFFER_COUNT; i++)
-        InitUniformBuffer(&g_vulkan.uniform_buffers[i], VK_UNIFORM_BUFFER_NAMES[i]);
+        InitDynamicBuffer(
+            &g_vulkan.uniform_buffers[i],
+            VK_DYNAMIC_UNIFORM_BUFFER_SIZE,
+            g_vulkan.min_uniform_buffer_offset_alignment,
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            VK_UNIFORM_BUFFER_NAMES[i]);
+}
+
+static void InitInstanceBuffer() {
+    InitDynamicBuffer(
+        &g_vulkan.instance_buffer,
+        (u32)g_vulkan.traits.max_frame_instances * sizeof(PlatformInstance),
+        sizeof(float),
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        "InstanceBuffer");
 }
 
 
@@ -1381,6 +1396,7 @@ void InitRenderDriver(const RendererTraits* traits, HWND hwnd) {
     InitDescriptorSetLayout();
     InitDescriptorPool();
     InitUniformBuffers();
+    InitInstanceBuffer();
     InitDescriptorSets();
     InitPipeline();
     InitCommandPool();
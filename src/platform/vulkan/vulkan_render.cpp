@@ -280,7 +280,25 @@ void PlatformDrawIndexed(u16 index_count) {
     vkCmdDrawIndexed(g_vulkan.command_buffer, index_count, 1, 0, 0, 0);
 }
 
-static bool CreateTextureInternal(PlatformTexture* texture, void* data, const SamplerOptions& sampler_options, const char* name) {
+void PlatformDrawIndexedInstanced(u16 index_count, const PlatformInstance* instances, u32 instance_count) {
+    assert(g_vulkan.command_buffer);
+    assert(index_count > 0);
+    assert(instances);
+
+    DynamicBuffer* buffer = &g_vulkan.instance_buffer;
+    u32 size = instance_count * sizeof(PlatformInstance);
+    if (buffer->offset + size > buffer->size)
+        return;
+
+    VkDeviceSize offset = buffer->offset;
+    memcpy(static_cast<char*>(buffer->mapped_ptr) + buffer->offset, instances, size);
+    buffer->offset += size;
+
+    vkCmdBindVertexBuffers(g_vulkan.command_buffer, 1, 1, &buffer->buffer, &offset);
+    vkCmdDrawIndexed(g_vulkan.command_buffer, index_count, instance_count, 0, 0, 0);
+}
+
+static bool CreateTextureInternal(PlatformTexture* texture, const void* data, const SamplerOptions& sampler_options, const char* name) {
     VkBuffer staging_buffer;
     VkDeviceMemory staging_buffer_memory;
     VkBufferCreateInfo buffer_info = {
@@ -517,7 +535,7 @@ static bool CreateTextureInternal(PlatformTexture* texture, void* data, const Sa
 }
 
 PlatformTexture* PlatformCreateTexture(
-    void* data,
+    const void* data,
     size_t width,
     size_t height,
     int channels,
@@ -534,6 +552,30 @@ PlatformTexture* PlatformCreateTexture(
     return texture;
 }
 
+// Block compressed uploads are not wired up here yet, the texture loader decodes to RGBA8
+bool PlatformIsTextureFormatSupported(TextureFormat format) {
+    (void)format;
+    return false;
+}
+
+PlatformTexture* PlatformCreateCompressedTexture(
+    const void* data,
+    u32 data_size,
+    size_t width,
+    size_t height,
+    TextureFormat format,
+    const SamplerOptions& sampler_options,
+    const char* name) {
+    (void)data;
+    (void)data_size;
+    (void)width;
+    (void)height;
+    (void)format;
+    (void)sampler_options;
+    (void)name;
+    return nullptr;
+}
+
 void PlatformUpdateTexture(PlatformTexture* texture, void* data) {
     if (!texture || !data) return;
 
@@ -1081,18 +1123,74 @@ static bool CreateShaderInternal(
         },
     };
 
-    VkVertexInputBindingDescription binding_desc = {
-        .binding = 0,
-        .stride = sizeof(MeshVertex),
-        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+    // Instanced shaders read per instance data from binding 1
+    VkVertexInputAttributeDescription instance_attr_descs[] = {
+        // Transform rows
+        {
+            .location = 9,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32_SFLOAT,
+            .offset = offsetof(PlatformInstance, transform)
+        },
+        {
+            .location = 10,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32_SFLOAT,
+            .offset = offsetof(PlatformInstance, transform) + sizeof(float) * 3
+        },
+        {
+            .location = 11,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32_SFLOAT,
+            .offset = offsetof(PlatformInstance, transform) + sizeof(float) * 6
+        },
+        // Depth and color offset
+        {
+            .location = 12,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32_SFLOAT,
+            .offset = offsetof(PlatformInstance, depth)
+        },
+        // Color
+        {
+            .location = 13,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(PlatformInstance, color)
+        },
+        // Emission
+        {
+            .location = 14,
+            .binding = 1,
+            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+            .offset = offsetof(PlatformInstance, emission)
+        },
     };
 
+    VkVertexInputBindingDescription binding_descs[] = {
+        {
+            .binding = 0,
+            .stride = sizeof(MeshVertex),
+            .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+        },
+        {
+            .binding = 1,
+            .stride = sizeof(PlatformInstance),
+            .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+        },
+    };
+
+    std::vector<VkVertexInputAttributeDescription> vertex_attributes(std::begin(attr_descs), std::end(attr_descs));
+    bool instanced = (flags & SHADER_FLAGS_INSTANCED) != 0;
+    if (instanced)
+        vertex_attributes.insert(vertex_attributes.end(), std::begin(instance_attr_descs), std::end(instance_attr_descs));
+
     VkPipelineVertexInputStateCreateInfo vertex_input = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-        .vertexBindingDescriptionCount = 1,
-        .pVertexBindingDescriptions = &binding_desc,
-        .vertexAttributeDescriptionCount = sizeof(attr_descs) / sizeof(VkVertexInputAttributeDescription),
-        .pVertexAttributeDescriptions = attr_descs,
+        .vertexBindingDescriptionCount = instanced ? 2u : 1u,
+        .pVertexBindingDescriptions = binding_descs,
+        .vertexAttributeDescriptionCount = static_cast<u32>(vertex_attributes.size()),
+        .pVertexAttributeDescriptions = vertex_attributes.data(),
     };
 
     shader->vertex_module = CreateShaderModule(vertex_code, vertex_code_size, name);
@@ -1274,6 +1372,7 @@ void PlatformBeginRender() {
 
     for (u32 i = 0; i < UNIFORM_BUFFER_COUNT; i++)
         g_vulkan.uniform_buffers[i].offset = 0;
+    g_vulkan.instance_buffer.offset = 0;
 
     // Use current_frame to select which semaphore to signal during acquire
     VkResult result = vkAcquireNextImageKHR(
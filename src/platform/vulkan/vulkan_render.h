@@ -209,6 +209,7 @@ struct VulkanRenderer {
     std::vector<VkFramebuffer> composite_framebuffers;
 
     DynamicBuffer uniform_buffers[UNIFORM_BUFFER_COUNT];
+    DynamicBuffer instance_buffer;
 
     VkRenderPass render_pass;
     VkRenderPass scene_render_pass;
@@ -481,6 +481,18 @@ u8* PlatformLoadPersistentData(Allocator* allocator, const char* name, u32* out_
     return data;
 }
 
+// Web builds embed their assets, there is no file system worth mapping
+const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size) {
+    (void)path;
+    *out_size = 0;
+    return nullptr;
+}
+
+void PlatformUnmapFile(const u8* data, u32 size) {
+    (void)data;
+    (void)size;
+}
+
 std::filesystem::path PlatformGetBinaryPath() {
     return std::filesystem::path("/");
 }
@@ -441,6 +441,39 @@ u8* PlatformLoadPersistentData(Allocator* allocator, const char* name, u32* out_
     return data;
 }
 
+const u8* PlatformMapFile(const std::filesystem::path& path, u32* out_size) {
+    *out_size = 0;
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0 || file_size.QuadPart > U32_MAX) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    // The view keeps the mapping and file alive, both handles can be closed right away
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return nullptr;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return nullptr;
+
+    *out_size = static_cast<u32>(file_size.QuadPart);
+    return static_cast<const u8*>(data);
+}
+
+void PlatformUnmapFile(const u8* data, u32 size) {
+    (void)size;
+    if (data)
+        UnmapViewOfFile(data);
+}
+
 std::filesystem::path PlatformGetBinaryPath() {
     char path[MAX_PATH];
     GetModuleFileNameA(nullptr, path, MAX_PATH);
@@ -23,6 +23,81 @@ bool IsLooping(Animation* animation) {
     return (impl->flags & ANIMATION_FLAG_LOOPING) != 0;
 }
 
+// Compressed animations replace the transform table with one track per bone channel.  Keys
+// between the kept ones are reconstructed by linear interpolation, which the importer checked
+// against its error tolerance.  The segment is found by binary search over the key frames.
+static float DecodeTrack(AnimationImpl* impl, const AnimationTrack& track, int transform_index) {
+    if (track.key_count == 0)
+        return track.min;
+
+    const u8* frames = impl->key_frames + track.key_offset;
+    const u16* values = impl->key_values + track.key_offset;
+
+    // Last key at or before transform_index, never the final key so key + 1 is the segment end
+    u32 key = 0;
+    u32 count = track.key_count > 1 ? track.key_count - 1 : 1;
+    while (count > 1) {
+        u32 half = count / 2;
+        if (frames[key + half] <= transform_index) {
+            key += half;
+            count -= half;
+        } else {
+            count = half;
+        }
+    }
+
+    float value = static_cast<float>(values[key]);
+    if (key + 1 < track.key_count && transform_index > frames[key]) {
+        float t = static_cast<float>(transform_index - frames[key]) / static_cast<float>(frames[key + 1] - frames[key]);
+        value += (static_cast<float>(values[key + 1]) - value) * Min(t, 1.0f);
+    }
+
+    return track.min + value * track.scale;
+}
+
+BoneTransform DecodeBoneTransform(AnimationImpl* impl, int transform_index, int bone_index) {
+    if (!impl->tracks)
+        return impl->transforms[transform_index * impl->transform_stride + bone_index];
+
+    const AnimationTrack* tracks = impl->tracks + bone_index * ANIMATION_TRACKS_PER_BONE;
+    return {
+        .position = {
+            DecodeTrack(impl, tracks[ANIMATION_TRACK_POSITION_X], transform_index),
+            DecodeTrack(impl, tracks[ANIMATION_TRACK_POSITION_Y], transform_index) },
+        .scale = {
+            DecodeTrack(impl, tracks[ANIMATION_TRACK_SCALE_X], transform_index),
+            DecodeTrack(impl, tracks[ANIMATION_TRACK_SCALE_Y], transform_index) },
+        .rotation = DecodeTrack(impl, tracks[ANIMATION_TRACK_ROTATION], transform_index),
+    };
+}
+
+static void ReadTracks(Allocator* allocator, Stream* stream, AnimationImpl* impl) {
+    int track_count = impl->bone_count * ANIMATION_TRACKS_PER_BONE;
+    u32 key_total = ReadU32(stream);
+    impl->tracks = static_cast<AnimationTrack*>(Alloc(allocator, sizeof(AnimationTrack) * track_count));
+    impl->key_frames = static_cast<u8*>(Alloc(allocator, Max(key_total, 1u)));
+    impl->key_values = static_cast<u16*>(Alloc(allocator, sizeof(u16) * Max(key_total, 1u)));
+
+    u32 key_offset = 0;
+    for (int track_index=0; track_index<track_count; track_index++) {
+        AnimationTrack& track = impl->tracks[track_index];
+        track.key_count = ReadU8(stream);
+        track.key_offset = key_offset;
+        track.min = ReadFloat(stream);
+        track.scale = 0.0f;
+        if (track.key_count == 0)
+            continue;
+
+        assert(key_offset + track.key_count <= key_total);
+        track.scale = ReadFloat(stream);
+        ReadBytes(stream, impl->key_frames + key_offset, track.key_count);
+        for (u32 key_index=0; key_index<track.key_count; key_index++)
+            impl->key_values[key_offset + key_index] = ReadU16(stream);
+
+        key_offset += track.key_count;
+    }
+}
+
 Asset* LoadAnimation(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table) {
     (void)header;
     (void)name;
@@ -41,7 +116,10 @@ Asset* LoadAnimation(Allocator* allocator, Stream* stream, AssetHeader* header,
     impl->frame_count = frame_count;
     impl->transform_count = transform_count;
     impl->bones = static_cast<AnimationBone*>(Alloc(allocator, sizeof(AnimationBone) * bone_count));
-    impl->transforms = static_cast<BoneTransform*>(Alloc(allocator, sizeof(BoneTransform) * bone_count * transform_count));
+    impl->transforms = nullptr;
+    impl->tracks = nullptr;
+    impl->key_frames = nullptr;
+    impl->key_values = nullptr;
     impl->frames = static_cast<AnimationFrame*>(Alloc(allocator, sizeof(AnimationFrame) * (frame_count + 1)));
     impl->transform_stride = bone_count;
     impl->frame_rate = frame_rate;
@@ -50,7 +128,14 @@ Asset* LoadAnimation(Allocator* allocator, Stream* stream, AssetHeader* header,
     impl->flags = flags;
 
     ReadBytes(stream, &impl->bones[0], sizeof(AnimationBone) * bone_count);
-    ReadBytes(stream, &impl->transforms[0], sizeof(BoneTransform) * bone_count * transform_count);
+
+    if (flags & ANIMATION_FLAG_COMPRESSED) {
+        ReadTracks(allocator, stream, impl);
+    } else {
+        impl->transforms = static_cast<BoneTransform*>(Alloc(allocator, sizeof(BoneTransform) * bone_count * transform_count));
+        ReadBytes(stream, &impl->transforms[0], sizeof(BoneTransform) * bone_count * transform_count);
+    }
+
     ReadBytes(stream, &impl->frames[0], sizeof(AnimationFrame) * (frame_count + 1));
 
     impl->frames[impl->frame_count] = impl->frames[impl->frame_count-1];
@@ -88,6 +173,9 @@ Animation* CreateAnimation(
     impl->duration = frame_count * impl->frame_rate_inv;
     impl->flags = flags;
     impl->transforms = transforms;
+    impl->tracks = nullptr;
+    impl->key_frames = nullptr;
+    impl->key_values = nullptr;
 
     for (int frame_index=0; frame_index<frame_count; frame_index++) {
         AnimationFrame& f = impl->frames[frame_index];
@@ -2,7 +2,33 @@
 //  NoZ - Copyright(c) 2026 NoZ Games, LLC
 //
 
+#include "../math/simd.h"
+
+// Animators sample their layers into BoneTransforms, then the pose is gathered into structure
+// of arrays streams so the TRS and hierarchy kernels run four bones or one 2x2 matrix at a
+// time.  Registered animators are advanced and evaluated together by UpdateAnimators, each
+// animator only touches its own state so the batch is split across the task workers.
+
 constexpr float ANIMATOR_BLEND_TIME = 0.05f;
+constexpr int ANIMATOR_BATCH_GRAIN = 8;
+constexpr int ANIMATOR_POSE_SIZE = (MAX_BONES + 3) & ~3;
+
+struct AnimatorPose {
+    float position_x[ANIMATOR_POSE_SIZE];
+    float position_y[ANIMATOR_POSE_SIZE];
+    float scale_x[ANIMATOR_POSE_SIZE];
+    float scale_y[ANIMATOR_POSE_SIZE];
+    float rotation[ANIMATOR_POSE_SIZE];
+    float local[6][ANIMATOR_POSE_SIZE];
+};
+
+struct AnimatorSystem {
+    Animator** animators;
+    u32 animator_count;
+    u32 max_animators;
+};
+
+static AnimatorSystem g_animators = {};
 
 void AddEvent(Animator& animator, int event_id) {
     if (event_id <= 0) return;
@@ -39,26 +65,23 @@ static void EvalulateFrame(Animator& animator, int layer_index) {
     i32 transform_index0 = frame.transform0;
     i32 transform_index1 = frame.transform1;
     f32 frame_fraction = (frame_index_float - static_cast<f32>(frame_index)) * (frame.fraction1 - frame.fraction0) + frame.fraction0;
-    BoneTransform* transform0 = anim_impl->transforms + transform_index0 * anim_impl->transform_stride;
-    BoneTransform* transform1 = anim_impl->transforms + transform_index1 * anim_impl->transform_stride;
 
     // Blend
-    BoneTransform* blend_transform0 = nullptr;
-    BoneTransform* blend_transform1 = nullptr;
+    AnimationImpl* blend_anim_impl = nullptr;
+    i32 blend_transform_index0 = 0;
+    i32 blend_transform_index1 = 0;
     f32 blend_frame_fraction = 0.0f;
     f32 blend_t = 0.0f;
     if (layer.blend_animation) {
-        AnimationImpl* blend_anim_impl = static_cast<AnimationImpl*>(layer.blend_animation);
+        blend_anim_impl = static_cast<AnimationImpl*>(layer.blend_animation);
         assert(blend_anim_impl);
         assert(GetBoneCount(animator.skeleton) == blend_anim_impl->bone_count);
         f32 blend_index_float = layer.blend_frame_time * blend_anim_impl->frame_rate;
         i32 blend_index = static_cast<i32>(blend_index_float);
         AnimationFrame& blend_frame = blend_anim_impl->frames[blend_index];
-        i32 blend_transform_index0 = blend_frame.transform0;
-        i32 blend_transform_index1 = blend_frame.transform1;
+        blend_transform_index0 = blend_frame.transform0;
+        blend_transform_index1 = blend_frame.transform1;
         blend_frame_fraction = (blend_index_float - static_cast<f32>(blend_index)) * (blend_frame.fraction1 - blend_frame.fraction0) + blend_frame.fraction0;
-        blend_transform0 = blend_anim_impl->transforms + blend_transform_index0 * blend_anim_impl->transform_stride;
-        blend_transform1 = blend_anim_impl->transforms + blend_transform_index1 * blend_anim_impl->transform_stride;
         blend_t = layer.blend_time / ANIMATOR_BLEND_TIME;
     }
 
@@ -66,15 +89,16 @@ static void EvalulateFrame(Animator& animator, int layer_index) {
         if ((layer.bone_mask & (static_cast<u64>(1) << static_cast<u64>(bone_index))) == 0)
             continue;
 
-        BoneTransform* bone_transform0 = transform0 + bone_index;
-        BoneTransform* bone_transform1 = transform1 + bone_index;
-        BoneTransform frame_transform = Mix(*bone_transform0, *bone_transform1, frame_fraction);
+        BoneTransform frame_transform = Mix(
+            DecodeBoneTransform(anim_impl, transform_index0, bone_index),
+            DecodeBoneTransform(anim_impl, transform_index1, bone_index),
+            frame_fraction);
 
-        if (blend_transform0) {
-            assert(blend_transform1);
-            BoneTransform* bbt1 = blend_transform0 + bone_index;
-            BoneTransform* bbt2 = blend_transform1 + bone_index;
-            BoneTransform blend_frame = Mix(*bbt1, *bbt2, blend_frame_fraction);
+        if (blend_anim_impl) {
+            BoneTransform blend_frame = Mix(
+                DecodeBoneTransform(blend_anim_impl, blend_transform_index0, bone_index),
+                DecodeBoneTransform(blend_anim_impl, blend_transform_index1, bone_index),
+                blend_frame_fraction);
             frame_transform = Mix(blend_frame, frame_transform, blend_t);
         }
 
@@ -100,17 +124,93 @@ static void EvalulateFrame(Animator& animator, int layer_index) {
     layer.frame_index = frame_index;
 }
 
+// Local bone matrices for the whole pose, rotation is in degrees like TRS
+static void EvaluateLocalPose(AnimatorPose& pose, int bone_count) {
+    f32x4 radians = Set4(noz::DEG_TO_RAD);
+    for (int i=0; i<bone_count; i+=4) {
+        f32x4 s;
+        f32x4 c;
+        SinCos4(Mul4(Load4(pose.rotation + i), radians), &s, &c);
+
+        f32x4 sx = Load4(pose.scale_x + i);
+        f32x4 sy = Load4(pose.scale_y + i);
+        Store4(pose.local[0] + i, Mul4(sx, c));
+        Store4(pose.local[1] + i, Mul4(sx, s));
+        Store4(pose.local[2] + i, Negate4(Mul4(sy, s)));
+        Store4(pose.local[3] + i, Mul4(sy, c));
+        Store4(pose.local[4] + i, Load4(pose.position_x + i));
+        Store4(pose.local[5] + i, Load4(pose.position_y + i));
+    }
+}
+
+// Parents always come before their children, so a single forward pass concatenates the pose.
+// Each world matrix is kept as its x and y axes duplicated across both halves of a register
+// plus its duplicated translation, which turns parent * local into two multiply adds for the
+// axes and two for the translation.
+static void EvaluateWorldPose(Animator& animator, const AnimatorPose& pose, int bone_count) {
+    SkeletonImpl* skel_impl = static_cast<SkeletonImpl*>(animator.skeleton);
+    f32x4 world[MAX_BONES][3];
+
+    for (int bone_index=0; bone_index<bone_count; bone_index++) {
+        float a = pose.local[0][bone_index];
+        float b = pose.local[1][bone_index];
+        float c = pose.local[2][bone_index];
+        float d = pose.local[3][bone_index];
+        float tx = pose.local[4][bone_index];
+        float ty = pose.local[5][bone_index];
+
+        f32x4 axes;
+        f32x4 translation;
+        if (bone_index == 0) {
+            axes = Set4(a, b, c, d);
+            translation = Set4(tx, ty, tx, ty);
+        } else {
+            const f32x4* parent = world[skel_impl->bones[bone_index].parent_index];
+            axes = Add4(Mul4(parent[0], Set4(a, a, c, c)), Mul4(parent[1], Set4(b, b, d, d)));
+            translation = Add4(Add4(Mul4(parent[0], Set4(tx)), Mul4(parent[1], Set4(ty))), parent[2]);
+        }
+
+        world[bone_index][0] = DupLow4(axes);
+        world[bone_index][1] = DupHigh4(axes);
+        world[bone_index][2] = translation;
+
+        float m[8];
+        Store4(m, axes);
+        Store4(m + 4, translation);
+        animator.bones[bone_index] = Mat3{
+            m[0], m[1], 0.0f,
+            m[2], m[3], 0.0f,
+            m[4], m[5], 1.0f
+        };
+    }
+}
+
 static void EvalulateFrame(Animator& animator) {
     for (int layer_index=0; layer_index<animator.layer_count; layer_index++)
         EvalulateFrame(animator, layer_index);
 
-    SkeletonImpl* skel_impl = static_cast<SkeletonImpl*>(animator.skeleton);
-    int bone_count = skel_impl->bone_count;
-    animator.bones[0] = ToMat3(animator.transforms[0]);
-    for (int bone_index=1; bone_index<bone_count; bone_index++) {
-        int parent_index = skel_impl->bones[bone_index].parent_index;
-        animator.bones[bone_index] = animator.bones[parent_index] * ToMat3(animator.transforms[bone_index]);
+    int bone_count = static_cast<SkeletonImpl*>(animator.skeleton)->bone_count;
+    AnimatorPose pose;
+    for (int bone_index=0; bone_index<bone_count; bone_index++) {
+        const BoneTransform& bt = animator.transforms[bone_index];
+        pose.position_x[bone_index] = bt.position.x;
+        pose.position_y[bone_index] = bt.position.y;
+        pose.scale_x[bone_index] = bt.scale.x;
+        pose.scale_y[bone_index] = bt.scale.y;
+        pose.rotation[bone_index] = bt.rotation;
+    }
+
+    // Pad the last group of four so the kernel never reads uninitialized lanes
+    for (int bone_index=bone_count; bone_index<((bone_count + 3) & ~3); bone_index++) {
+        pose.position_x[bone_index] = 0.0f;
+        pose.position_y[bone_index] = 0.0f;
+        pose.scale_x[bone_index] = 1.0f;
+        pose.scale_y[bone_index] = 1.0f;
+        pose.rotation[bone_index] = 0.0f;
     }
+
+    EvaluateLocalPose(pose, bone_count);
+    EvaluateWorldPose(animator, pose, bone_count);
 }
 
 void Stop(Animator& animator, int layer_index) {
@@ -157,11 +257,7 @@ void Play(Animator& animator, Animation* animation, int layer_index, float speed
     EvalulateFrame(animator);
 }
 
-void Update(Animator& animator, float time_scale) {
-    if (!animator.skeleton) return;
-
-    float dt = GetFrameTime() * time_scale;
-
+static void AdvanceLayers(Animator& animator, float dt) {
     for (int layer_index=0; layer_index<animator.layer_count; layer_index++) {
         AnimatorLayer& layer = GetLayer(animator, layer_index);
         if (!layer.playing || !layer.animation)
@@ -191,10 +287,52 @@ void Update(Animator& animator, float time_scale) {
             }
         }
     }
+}
+
+void Update(Animator& animator, float time_scale) {
+    if (!animator.skeleton) return;
 
+    AdvanceLayers(animator, GetFrameTime() * time_scale);
     EvalulateFrame(animator);
 }
 
+void UpdateAnimators(float time_scale) {
+    float dt = GetFrameTime() * time_scale;
+    noz::ParallelFor(0, static_cast<int>(g_animators.animator_count), ANIMATOR_BATCH_GRAIN, [dt](int begin, int end) {
+        for (int i=begin; i<end; i++) {
+            Animator& animator = *g_animators.animators[i];
+            if (!animator.skeleton)
+                continue;
+
+            AdvanceLayers(animator, dt);
+            EvalulateFrame(animator);
+        }
+    });
+}
+
+void AddAnimator(Animator& animator) {
+    for (u32 i=0; i<g_animators.animator_count; i++)
+        if (g_animators.animators[i] == &animator)
+            return;
+
+    if (g_animators.animator_count >= g_animators.max_animators) {
+        LogWarning("animator limit reached (%u)", g_animators.max_animators);
+        return;
+    }
+
+    g_animators.animators[g_animators.animator_count++] = &animator;
+}
+
+void RemoveAnimator(Animator& animator) {
+    for (u32 i=0; i<g_animators.animator_count; i++) {
+        if (g_animators.animators[i] != &animator)
+            continue;
+
+        g_animators.animators[i] = g_animators.animators[--g_animators.animator_count];
+        return;
+    }
+}
+
 float GetNormalizedTime(Animator& animator, int layer_index) {
     AnimatorLayer& layer = animator.layers[layer_index];
     if (!layer.animation)
@@ -272,3 +410,14 @@ void Init(Animator& animator, Skeleton* skeleton, int layer_count) {
         };
     }
 }
+
+void InitAnimators(const ApplicationTraits* traits) {
+    g_animators = {};
+    g_animators.max_animators = traits->max_animators;
+    g_animators.animators = static_cast<Animator**>(Alloc(ALLOCATOR_DEFAULT, sizeof(Animator*) * g_animators.max_animators));
+}
+
+void ShutdownAnimators() {
+    Free(g_animators.animators);
+    g_animators = {};
+}
@@ -23,6 +23,7 @@ struct FontImpl : Font {
     uint16_t kerning_index[MAX_KERNING]; // Index into kerning_values array (0xFFFF = no kerning)
     float* kerning_values;               // Dynamic array of actual kerning values
     uint16_t kerning_count;              // Number of kerning pairs
+    u8* pending_atlas;                   // Atlas pixels from an async load, waiting for UploadFont
 };
 
 struct TextBuffer {
@@ -42,6 +43,7 @@ void FontDestructor(void* p) {
     Free(impl->kerning_values);
     Free(impl->material);
     Free(impl->texture);
+    Free(impl->pending_atlas);
 }
 
 Asset* LoadFont(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table) {
@@ -120,7 +122,7 @@ Asset* LoadFont(Allocator* allocator, Stream* stream, AssetHeader* header, const
 
     // Read atlas data
     uint32_t atlas_data_size = impl->atlas_width * impl->atlas_height; // R8 format
-    uint8_t* atlas_data = (uint8_t*)Alloc(ALLOCATOR_SCRATCH, atlas_data_size);
+    const u8* atlas_data = ReadInPlace(stream, atlas_data_size);
     if (!atlas_data)
     {
         // todo: free without allocator, stuff allocator with destructor?
@@ -128,11 +130,16 @@ Asset* LoadFont(Allocator* allocator, Stream* stream, AssetHeader* header, const
         return nullptr;
     }
 
-    ReadBytes(stream, atlas_data, atlas_data_size);
+    // Off the main thread the atlas is kept and its texture created later by UploadFont
+    if (!IsMainThread())
+    {
+        impl->pending_atlas = (u8*)Alloc(ALLOCATOR_DEFAULT, atlas_data_size);
+        memcpy(impl->pending_atlas, atlas_data, atlas_data_size);
+        return impl;
+    }
 
     impl->texture =
         CreateTexture(allocator, atlas_data, impl->atlas_width, impl->atlas_height, TEXTURE_FORMAT_R8, name);
-    Free(atlas_data);
 
     if (!impl->texture)
     {
@@ -143,6 +150,25 @@ Asset* LoadFont(Allocator* allocator, Stream* stream, AssetHeader* header, const
     return impl;
 }
 
+bool UploadFont(Asset* asset)
+{
+    FontImpl* impl = static_cast<FontImpl*>(asset);
+    if (impl->pending_atlas)
+    {
+        impl->texture = CreateTexture(
+            GetAllocator(impl),
+            impl->pending_atlas,
+            impl->atlas_width,
+            impl->atlas_height,
+            TEXTURE_FORMAT_R8,
+            impl->name);
+        Free(impl->pending_atlas);
+        impl->pending_atlas = nullptr;
+    }
+
+    return impl->texture != nullptr;
+}
+
 const FontGlyph* GetGlyph(Font* font, char ch)
 {
     FontImpl* impl = static_cast<FontImpl*>(font);
@@ -221,11 +221,15 @@ bool OverlapPoint(Mesh* mesh, const Vec2& overlap_point) {
     return false;
 }
 
-void RenderMesh(Mesh* mesh) {
+void BindMeshInternal(Mesh* mesh) {
     MeshImpl* impl = static_cast<MeshImpl*>(mesh);
     PlatformBindVertexBuffer(impl->vertex_buffer);
     PlatformBindIndexBuffer(impl->index_buffer);
-    PlatformDrawIndexed(impl->index_count);
+}
+
+void RenderMesh(Mesh* mesh) {
+    BindMeshInternal(mesh);
+    PlatformDrawIndexed(static_cast<MeshImpl*>(mesh)->index_count);
 }
 
 void RenderMesh(Mesh* mesh, float time, bool loop) {
@@ -263,7 +267,8 @@ Mesh* LoadMesh(Allocator* allocator, Stream* stream, const Name* name) {
     }
     impl->duration = impl->frame_count * impl->frame_rate_inv;
 
-    if (vertex_count > 0)
+    // Async loads parse on a worker, the buffers are created in the upload phase instead
+    if (vertex_count > 0 && IsMainThread())
         UploadMesh(impl);
 
     return impl;
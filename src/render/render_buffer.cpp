@@ -10,6 +10,12 @@ extern void BindMaterialInternal(Material* material);
 extern void BindTextureInternal(Texture* texture, i32 slot);
 extern void BindShaderInternal(Shader* shader);
 extern void UploadMesh(Mesh* mesh);
+extern void BindMeshInternal(Mesh* mesh);
+extern bool IsInstanced(Shader* shader);
+
+constexpr int MAX_BATCH_INSTANCES = 1024;
+constexpr int MAX_GLYPH_STREAMS = 8;
+constexpr int MIN_GLYPH_STREAM_CAPACITY = 256;
 
 enum RenderCommandType {
     RENDER_COMMAND_TYPE_BIND_VERTEX_USER,
@@ -18,6 +24,8 @@ enum RenderCommandType {
     RENDER_COMMAND_TYPE_BIND_DEFAULT_TEXTURE,
     RENDER_COMMAND_TYPE_BIND_SKELETON,
     RENDER_COMMAND_TYPE_DRAW_MESH,
+    RENDER_COMMAND_TYPE_DRAW_MESH_INSTANCED,
+    RENDER_COMMAND_TYPE_DRAW_GLYPHS,
     RENDER_COMMAND_TYPE_BEGIN_CLIP,
     RENDER_COMMAND_TYPE_END_CLIP_WRITE,
     RENDER_COMMAND_TYPE_END_CLIP
@@ -41,8 +49,22 @@ struct DrawMeshData {
     Vec2Int color_offset;
 };
 
-struct BeginPassData {
-    Color clear_color;
+struct DrawMeshInstancedData {
+    Mesh* mesh;
+    Material* material;
+    Texture* texture;
+    Shader* shader;
+    float depth_scale;
+    const PlatformInstance* instances;
+    int instance_count;
+};
+
+struct DrawGlyphsData {
+    Material* material;
+    const GlyphVertex* vertices;
+    int quad_count;
+    float depth;
+    float depth_scale;
 };
 
 struct BindDefaultTextureData {
@@ -50,31 +72,76 @@ struct BindDefaultTextureData {
 };
 
 struct BindUserData {
-    u8 data[MAX_UNIFORM_BUFFER_SIZE];
+    const u8* data;
+    u32 size;
 };
 
 // todo: change to current skeleton, no need for storing them in commands
 struct BindSkeletonData {
+    const Mat3* bones;
     int bone_count;
-    Mat3 bones[MAX_BONES];
 };
 
+// Commands are packed back to back in a byte stream, each one a header followed
+// by a payload sized to its type.  Variable sized data such as user uniforms and
+// bone palettes is stored out of line in the per frame data buffer.
 struct RenderCommand {
     RenderCommandType type;
-    union {
-        BindCameraData bind_camera;
-        BindDefaultTextureData bind_default_texture;
-        BeginPassData begin_pass;
-        DrawMeshData draw_mesh;
-        BindUserData bind_user_data;
-        BindSkeletonData bind_skeleton;
-    } data;
+    u32 size;
+};
+
+constexpr u32 RENDER_COMMAND_ALIGNMENT = 8;
+
+// Draw commands between two barriers (any non draw command) are stable sorted by a
+// 64 bit key: depth in the high 32 bits so back to front order is preserved, then
+// shader, material, texture and mesh so draws sharing state end up adjacent.  The
+// clip region and camera are constant within a run since both are barriers.
+struct RenderSortItem {
+    u64 key;
+    u32 offset;
+};
+
+// Quads appended for one font material since the last flush.  The vertex storage belongs to the
+// slot and is kept across frames, so steady text never allocates.
+struct GlyphStream {
+    Material* material;
+    GlyphVertex* vertices;
+    int quad_count;
+    int quad_capacity;
+    float depth;
+    float depth_scale;
+};
+
+// Last state handed to the platform, used to skip redundant binds
+struct RenderState {
+    Material* material;
+    Shader* shader;
+    Texture* texture;
+    Mesh* mesh;
+    Color color;
+    Color emission;
+    Vec2Int color_offset;
+    bool has_color;
+    bool instanced;
 };
 
 struct RenderBuffer {
-    RenderCommand* commands;
+    u8* commands;
+    u32 command_size;
+    u32 command_size_max;
     int command_count;
-    int command_count_max;
+    u8* frame_data;
+    u32 frame_data_size;
+    u32 frame_data_size_max;
+    RenderSortItem* sort_items;
+    RenderSortItem* sort_temp;
+    PlatformInstance* batch_instances;
+    GlyphStream glyph_streams[MAX_GLYPH_STREAMS];
+    int glyph_stream_count;
+    GlyphVertex* frame_glyphs;
+    int frame_glyph_count;
+    int frame_glyph_count_max;
+    bool sort_enabled;
     bool is_full;
     Material* current_material;
     Texture* current_texture;
@@ -85,27 +152,141 @@ struct RenderBuffer {
     Color current_color;
     Vec2Int current_color_offset;
     Color current_emission;
+    bool current_displaced;
+    const Mat3* skeleton_bones;
+    int skeleton_bone_count;
+    Bounds2 cull_bounds;
+    bool cull_enabled;
+    RenderStats stats;
+    RenderStats last_stats;
 };
 
 static RenderBuffer g_render_buffer = {};
 
-static void AddRenderCommand(RenderCommand* cmd) {
-    if (g_render_buffer.is_full) return;
-    g_render_buffer.commands[g_render_buffer.command_count++] = *cmd;
-    g_render_buffer.is_full = g_render_buffer.command_count == g_render_buffer.command_count_max;
+static u32 AlignRenderSize(u32 size) {
+    return (size + RENDER_COMMAND_ALIGNMENT - 1) & ~(RENDER_COMMAND_ALIGNMENT - 1);
+}
+
+static void* AddRenderCommand(RenderCommandType type, u32 data_size) {
+    if (g_render_buffer.is_full) return nullptr;
+
+    u32 size = AlignRenderSize((u32)sizeof(RenderCommand) + data_size);
+    if (g_render_buffer.command_size + size > g_render_buffer.command_size_max) {
+        g_render_buffer.is_full = true;
+        return nullptr;
+    }
+
+    RenderCommand* cmd = (RenderCommand*)(g_render_buffer.commands + g_render_buffer.command_size);
+    cmd->type = type;
+    cmd->size = size;
+    g_render_buffer.command_size += size;
+    g_render_buffer.command_count++;
+    return cmd + 1;
+}
+
+template <typename T>
+static T* AddRenderCommand(RenderCommandType type) {
+    return static_cast<T*>(AddRenderCommand(type, sizeof(T)));
+}
+
+static void AddRenderCommand(RenderCommandType type) {
+    AddRenderCommand(type, 0);
+}
+
+static u8* AllocFrameData(u32 size) {
+    if (g_render_buffer.is_full) return nullptr;
+
+    u32 aligned_size = AlignRenderSize(size);
+    if (g_render_buffer.frame_data_size + aligned_size > g_render_buffer.frame_data_size_max) {
+        g_render_buffer.is_full = true;
+        return nullptr;
+    }
+
+    u8* data = g_render_buffer.frame_data + g_render_buffer.frame_data_size;
+    g_render_buffer.frame_data_size += aligned_size;
+    return data;
+}
+
+// Reserves frame data and the command referencing it together so a full buffer never
+// leaves a command pointing at unallocated data.
+static Mat3* AddBindSkeletonCommand(int bone_count) {
+    assert(bone_count >= 0 && bone_count <= MAX_BONES);
+    Mat3* bones = (Mat3*)AllocFrameData(sizeof(Mat3) * bone_count);
+    if (!bones) return nullptr;
+
+    BindSkeletonData* cmd = AddRenderCommand<BindSkeletonData>(RENDER_COMMAND_TYPE_BIND_SKELETON);
+    if (!cmd) return nullptr;
+
+    cmd->bones = bones;
+    cmd->bone_count = bone_count;
+    g_render_buffer.skeleton_bones = bones;
+    g_render_buffer.skeleton_bone_count = bone_count;
+    return bones;
+}
+
+static void AddBindUserDataCommand(RenderCommandType type, const void* data, size_t size) {
+    assert(size <= MAX_UNIFORM_BUFFER_SIZE);
+    u8* copy = AllocFrameData((u32)size);
+    if (!copy) return;
+
+    BindUserData* cmd = AddRenderCommand<BindUserData>(type);
+    if (!cmd) return;
+
+    memcpy(copy, data, size);
+    cmd->data = copy;
+    cmd->size = (u32)size;
+}
+
+static void SetInstance(
+    PlatformInstance& instance,
+    const Mat3& transform,
+    float depth,
+    const Color& color,
+    const Color& emission,
+    const Vec2Int& color_offset) {
+    instance.transform[0] = transform.m[0]; instance.transform[1] = transform.m[3]; instance.transform[2] = transform.m[6];
+    instance.transform[3] = transform.m[1]; instance.transform[4] = transform.m[4]; instance.transform[5] = transform.m[7];
+    instance.transform[6] = transform.m[2]; instance.transform[7] = transform.m[5]; instance.transform[8] = transform.m[8];
+    instance.depth = depth;
+    instance.color_offset = ToVec2(color_offset);
+    instance.color = color;
+    instance.emission = emission;
+}
+
+static Mat3 GetInstanceTransform(const PlatformInstance& instance) {
+    Mat3 transform;
+    transform.m[0] = instance.transform[0]; transform.m[3] = instance.transform[1]; transform.m[6] = instance.transform[2];
+    transform.m[1] = instance.transform[3]; transform.m[4] = instance.transform[4]; transform.m[7] = instance.transform[5];
+    transform.m[2] = instance.transform[6]; transform.m[5] = instance.transform[7]; transform.m[8] = instance.transform[8];
+    return transform;
 }
 
 void ClearRenderCommands() {
+    for (int i = 0; i < g_render_buffer.glyph_stream_count; i++)
+        g_render_buffer.glyph_streams[i].quad_count = 0;
+
+    g_render_buffer.glyph_stream_count = 0;
+    g_render_buffer.frame_glyph_count = 0;
+    g_render_buffer.command_size = 0;
     g_render_buffer.command_count = 0;
+    g_render_buffer.frame_data_size = 0;
     g_render_buffer.is_full = false;
+    g_render_buffer.cull_enabled = false;
+    g_render_buffer.skeleton_bones = nullptr;
+    g_render_buffer.skeleton_bone_count = 0;
+    g_render_buffer.stats = {};
 }
 
 void BindIdentitySkeleton() {
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_BIND_SKELETON };
-    cmd.data.bind_skeleton.bone_count = MAX_BONES;
+    Mat3* bones = AddBindSkeletonCommand(MAX_BONES);
+    if (!bones) return;
+
     for (int i = 0; i < MAX_BONES; ++i)
-        cmd.data.bind_skeleton.bones[i] = MAT3_IDENTITY;
-    AddRenderCommand(&cmd);
+        bones[i] = MAT3_IDENTITY;
+
+    // Identity bones never move a vertex so culling can use the mesh bounds directly
+    g_render_buffer.skeleton_bones = nullptr;
+    g_render_buffer.skeleton_bone_count = 0;
 }
 
 void BindSkeleton(const Mat3* bind_poses, int bind_pose_stride, Mat3* bones, int bone_stride, int bone_count) {
@@ -118,61 +299,100 @@ void BindSkeleton(const Mat3* bind_poses, int bind_pose_stride, Mat3* bones, int
     assert(bone_stride >= (int)sizeof(Mat3));
     assert(bind_pose_stride >= (int)sizeof(Mat3));
 
+    Mat3* dst = AddBindSkeletonCommand(bone_count);
+    if (!dst) return;
+
     const u8* bind_pose_bytes = (const u8*)bind_poses;
     const u8* bone_bytes = (const u8*)bones;
-
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_BIND_SKELETON };
-    cmd.data.bind_skeleton.bone_count = bone_count;
     for (int i = 0; i < bone_count; ++i, bind_pose_bytes += bind_pose_stride, bone_bytes += bone_stride) {
         const Mat3& bind_pose = *((Mat3*)bind_pose_bytes);
         const Mat3& bone = *((Mat3*)bone_bytes);
         Mat3 transform = bone * bind_pose;
-        memcpy(&cmd.data.bind_skeleton.bones[i], &transform, sizeof(Mat3));
+        memcpy(&dst[i], &transform, sizeof(Mat3));
     }
-
-    AddRenderCommand(&cmd);
 }
 
 void BindSkeleton(const Mat3* bones, int bone_count, int stride) {
     assert(stride == 0 || stride >= (int)sizeof(Mat3));
 
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_BIND_SKELETON };
-    cmd.data.bind_skeleton.bone_count = bone_count;
+    Mat3* dst = AddBindSkeletonCommand(bone_count);
+    if (!dst) return;
+
     if (stride == 0 || stride == sizeof(Mat3)) {
-        memcpy(cmd.data.bind_skeleton.bones, bones, sizeof(Mat3) * bone_count);
+        memcpy(dst, bones, sizeof(Mat3) * bone_count);
     } else {
         for (int i = 0; i < bone_count; ++i) {
-            memcpy(&cmd.data.bind_skeleton.bones[i], (const u8*)bones + i * stride, sizeof(Mat3));
+            memcpy(&dst[i], (const u8*)bones + i * stride, sizeof(Mat3));
         }
     }
-    AddRenderCommand(&cmd);
 }
 
 void BindDefaultTexture(int texture_index) {
-    RenderCommand cmd = {
-        .type = RENDER_COMMAND_TYPE_BIND_DEFAULT_TEXTURE,
-        .data = {
-            .bind_default_texture = {
-                .index = texture_index}} };
-    AddRenderCommand(&cmd);
+    BindDefaultTextureData* cmd = AddRenderCommand<BindDefaultTextureData>(RENDER_COMMAND_TYPE_BIND_DEFAULT_TEXTURE);
+    if (!cmd) return;
+    cmd->index = texture_index;
 }
 
 void BindCamera(Camera* camera) {
-    RenderCommand cmd = {
-        .type = RENDER_COMMAND_TYPE_BIND_CAMERA,
-        .data = {
-            .bind_camera = {
-                .viewport = GetViewport(camera),
-                .view_matrix = GetViewMatrix(camera)
-            }
-        }
-    };
-    AddRenderCommand(&cmd);
+    FlushGlyphs();
+
+    BindCameraData* cmd = AddRenderCommand<BindCameraData>(RENDER_COMMAND_TYPE_BIND_CAMERA);
+    if (!cmd) return;
+    cmd->viewport = GetViewport(camera);
+    cmd->view_matrix = GetViewMatrix(camera);
+
+    // The view maps the visible area to the -1..1 clip square, so the cull bounds are that
+    // square taken back through the inverse view, which also covers rotated cameras.
+    g_render_buffer.cull_bounds = TransformBounds(Inverse(cmd->view_matrix), Bounds2{ -VEC2_ONE, VEC2_ONE });
+    g_render_buffer.cull_enabled = true;
+}
+
+bool IsVisible(const Bounds2& world_bounds) {
+    if (!g_render_buffer.cull_enabled)
+        return true;
+
+    return Intersects(g_render_buffer.cull_bounds, world_bounds);
+}
+
+bool GetCullBounds(Bounds2* bounds) {
+    *bounds = g_render_buffer.cull_bounds;
+    return g_render_buffer.cull_enabled;
+}
+
+void AddCulledDraws(int count) {
+    g_render_buffer.stats.culled_count += count;
+}
+
+const RenderStats& GetRenderStats() {
+    return g_render_buffer.last_stats;
+}
+
+// Skinned vertices are a weighted blend of the vertex moved by each bone, which always lies
+// inside the union of the bounds moved by every bone.  The unskinned bounds are included for
+// shaders that ignore the skeleton.
+static Bounds2 GetDrawBounds(Mesh* mesh, const Mat3& transform) {
+    Bounds2 bounds = GetBounds(mesh);
+    Bounds2 world_bounds = TransformBounds(transform, bounds);
+    for (int i = 0; i < g_render_buffer.skeleton_bone_count; i++)
+        world_bounds = Union(world_bounds, TransformBounds(transform * g_render_buffer.skeleton_bones[i], bounds));
+    return world_bounds;
+}
+
+static bool IsCulled(Mesh* mesh, const Mat3& transform) {
+    if (!g_render_buffer.cull_enabled || g_render_buffer.current_displaced)
+        return false;
+
+    if (IsVisible(GetDrawBounds(mesh, transform)))
+        return false;
+
+    g_render_buffer.stats.culled_count++;
+    return true;
 }
 
 void BindShader(Shader* shader) {
     g_render_buffer.current_shader = shader;
     g_render_buffer.current_material = nullptr;
+    g_render_buffer.current_displaced = false;
 }
 
 void BindTexture(Texture* texture) {
@@ -185,6 +405,7 @@ void BindMaterial(Material* material) {
     g_render_buffer.current_material = material;
     g_render_buffer.current_texture = nullptr;
     g_render_buffer.current_shader = nullptr;
+    g_render_buffer.current_displaced = false;
 }
 
 void BindDepth(float depth, float depth_scale) {
@@ -204,24 +425,15 @@ void BindTransform(const Vec3& position, const Vec2& rotation, const Vec2& scale
     g_render_buffer.current_depth_scale = 1.0f;
 }
 
+// Vertex user data can push vertices outside the mesh bounds, so culling stays off until
+// the next shader or material bind.
 void BindVertexUserData(const void* data, size_t size) {
-    assert(size <= MAX_UNIFORM_BUFFER_SIZE);
-
-    RenderCommand cmd = {
-        .type = RENDER_COMMAND_TYPE_BIND_VERTEX_USER,
-    };
-    memcpy(cmd.data.bind_user_data.data, data, size);
-    AddRenderCommand(&cmd);
+    AddBindUserDataCommand(RENDER_COMMAND_TYPE_BIND_VERTEX_USER, data, size);
+    g_render_buffer.current_displaced = true;
 }
 
 void BindFragmentUserData(const void* data, size_t size) {
-    assert(size <= MAX_UNIFORM_BUFFER_SIZE);
-
-    RenderCommand cmd = {
-        .type = RENDER_COMMAND_TYPE_BIND_FRAGMENT_USER,
-    };
-    memcpy(cmd.data.bind_user_data.data, data, size);
-    AddRenderCommand(&cmd);
+    AddBindUserDataCommand(RENDER_COMMAND_TYPE_BIND_FRAGMENT_USER, data, size);
 }
 
 void BindTransform(Transform& transform) {
@@ -262,18 +474,18 @@ void BindColor(Color color, const Vec2Int& color_uv_offset, Color emission) {
 
 // Clipping - deferred via command buffer
 void BeginClip() {
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_BEGIN_CLIP };
-    AddRenderCommand(&cmd);
+    FlushGlyphs();
+    AddRenderCommand(RENDER_COMMAND_TYPE_BEGIN_CLIP);
 }
 
 void EndClipWrite() {
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_END_CLIP_WRITE };
-    AddRenderCommand(&cmd);
+    FlushGlyphs();
+    AddRenderCommand(RENDER_COMMAND_TYPE_END_CLIP_WRITE);
 }
 
 void EndClip() {
-    RenderCommand cmd = { .type = RENDER_COMMAND_TYPE_END_CLIP };
-    AddRenderCommand(&cmd);
+    FlushGlyphs();
+    AddRenderCommand(RENDER_COMMAND_TYPE_END_CLIP);
 }
 
 void DrawMesh(Mesh* mesh, const Mat3& transform, Animator& animator, int bone_index) {
@@ -317,99 +529,504 @@ void DrawMesh(Mesh* mesh) {
 
     assert(IsUploaded(mesh));
 
-    RenderCommand cmd = {
-        .type = RENDER_COMMAND_TYPE_DRAW_MESH,
-        .data = {
-            .draw_mesh = {
-                .mesh = mesh,
-                .material = g_render_buffer.current_material,
-                .texture = g_render_buffer.current_texture,
-                .shader = g_render_buffer.current_shader,
-                .transform = g_render_buffer.current_transform,
-                .depth = g_render_buffer.current_depth,
-                .depth_scale = g_render_buffer.current_depth_scale,
-                .color = g_render_buffer.current_color,
-                .emission = g_render_buffer.current_emission,
-                .color_offset = g_render_buffer.current_color_offset,
-            }
-        }
+    if (IsCulled(mesh, g_render_buffer.current_transform))
+        return;
+
+    // Text added before this mesh has to be drawn before it to keep painter's order
+    FlushGlyphs();
+
+    DrawMeshData* cmd = AddRenderCommand<DrawMeshData>(RENDER_COMMAND_TYPE_DRAW_MESH);
+    if (!cmd) return;
+
+    g_render_buffer.stats.draw_count++;
+
+    *cmd = {
+        .mesh = mesh,
+        .material = g_render_buffer.current_material,
+        .texture = g_render_buffer.current_texture,
+        .shader = g_render_buffer.current_shader,
+        .transform = g_render_buffer.current_transform,
+        .depth = g_render_buffer.current_depth,
+        .depth_scale = g_render_buffer.current_depth_scale,
+        .color = g_render_buffer.current_color,
+        .emission = g_render_buffer.current_emission,
+        .color_offset = g_render_buffer.current_color_offset,
     };
+}
+
+void DrawMeshInstanced(Mesh* mesh, const InstanceData* instances, int count) {
+    if (!mesh || count <= 0) return;
+    if (GetVertexCount(mesh) == 0 || GetIndexCount(mesh) == 0) return;
 
-    AddRenderCommand(&cmd);
+    if (!IsUploaded(mesh))
+        UploadMesh(mesh);
+
+    assert(IsUploaded(mesh));
+
+    // Count the visible instances first so only those take frame data
+    int visible_count = count;
+    if (g_render_buffer.cull_enabled && !g_render_buffer.current_displaced) {
+        visible_count = 0;
+        for (int i = 0; i < count; i++)
+            if (IsVisible(GetDrawBounds(mesh, instances[i].transform)))
+                visible_count++;
+
+        g_render_buffer.stats.culled_count += count - visible_count;
+        if (visible_count == 0)
+            return;
+    }
+
+    FlushGlyphs();
+
+    PlatformInstance* dst = (PlatformInstance*)AllocFrameData(sizeof(PlatformInstance) * visible_count);
+    if (!dst) return;
+
+    DrawMeshInstancedData* cmd = AddRenderCommand<DrawMeshInstancedData>(RENDER_COMMAND_TYPE_DRAW_MESH_INSTANCED);
+    if (!cmd) return;
+
+    g_render_buffer.stats.draw_count += visible_count;
+
+    PlatformInstance* instance = dst;
+    for (int i = 0; i < count; i++) {
+        const InstanceData& src = instances[i];
+        if (visible_count != count && !IsVisible(GetDrawBounds(mesh, src.transform)))
+            continue;
+
+        SetInstance(*instance++, src.transform, src.depth, ToLinear(src.color), ToLinear(src.emission), src.color_offset);
+    }
+
+    *cmd = {
+        .mesh = mesh,
+        .material = g_render_buffer.current_material,
+        .texture = g_render_buffer.current_texture,
+        .shader = g_render_buffer.current_shader,
+        .depth_scale = g_render_buffer.current_depth_scale,
+        .instances = dst,
+        .instance_count = visible_count,
+    };
+}
+
+// @glyphs
+static GlyphStream* GetGlyphStream(Material* material) {
+    for (int i = 0; i < g_render_buffer.glyph_stream_count; i++)
+        if (g_render_buffer.glyph_streams[i].material == material)
+            return &g_render_buffer.glyph_streams[i];
+
+    if (g_render_buffer.glyph_stream_count == MAX_GLYPH_STREAMS)
+        FlushGlyphs();
+
+    GlyphStream* stream = &g_render_buffer.glyph_streams[g_render_buffer.glyph_stream_count++];
+    stream->material = material;
+    stream->quad_count = 0;
+    return stream;
+}
+
+// Copies the pending quads into the frame's glyph storage and records one draw for them
+static void FlushGlyphStream(GlyphStream* stream) {
+    int quad_count = stream->quad_count;
+    stream->quad_count = 0;
+    if (quad_count == 0)
+        return;
+
+    if (g_render_buffer.frame_glyph_count + quad_count > g_render_buffer.frame_glyph_count_max) {
+        LogWarning("glyph stream full, dropping %d glyphs", quad_count);
+        return;
+    }
+
+    DrawGlyphsData* cmd = AddRenderCommand<DrawGlyphsData>(RENDER_COMMAND_TYPE_DRAW_GLYPHS);
+    if (!cmd) return;
+
+    GlyphVertex* dst = g_render_buffer.frame_glyphs + g_render_buffer.frame_glyph_count * 4;
+    g_render_buffer.frame_glyph_count += quad_count;
+    memcpy(dst, stream->vertices, quad_count * 4 * sizeof(GlyphVertex));
+
+    g_render_buffer.stats.draw_count++;
+
+    *cmd = {
+        .material = stream->material,
+        .vertices = dst,
+        .quad_count = quad_count,
+        .depth = stream->depth,
+        .depth_scale = stream->depth_scale,
+    };
+}
+
+// Glyphs are not culled here, callers test the text bounds with IsVisible
+GlyphVertex* AddGlyphs(Material* material, int quad_count) {
+    assert(material);
+    if (quad_count <= 0) return nullptr;
+
+    GlyphStream* stream = GetGlyphStream(material);
+    if (stream->quad_count > 0 &&
+        (stream->depth != g_render_buffer.current_depth || stream->depth_scale != g_render_buffer.current_depth_scale))
+        FlushGlyphStream(stream);
+
+    stream->depth = g_render_buffer.current_depth;
+    stream->depth_scale = g_render_buffer.current_depth_scale;
+
+    int required = stream->quad_count + quad_count;
+    if (required > stream->quad_capacity) {
+        int capacity = Max(Max(stream->quad_capacity * 2, required), MIN_GLYPH_STREAM_CAPACITY);
+        u32 size = (u32)(capacity * 4 * sizeof(GlyphVertex));
+        stream->vertices = static_cast<GlyphVertex*>(stream->vertices
+            ? Realloc(stream->vertices, size)
+            : Alloc(ALLOCATOR_DEFAULT, size));
+        stream->quad_capacity = capacity;
+    }
+
+    GlyphVertex* vertices = stream->vertices + stream->quad_count * 4;
+    stream->quad_count = required;
+    return vertices;
+}
+
+void FlushGlyphs() {
+    for (int i = 0; i < g_render_buffer.glyph_stream_count; i++)
+        FlushGlyphStream(&g_render_buffer.glyph_streams[i]);
+
+    g_render_buffer.glyph_stream_count = 0;
+}
+
+void EnableRenderSort(bool enabled) {
+    g_render_buffer.sort_enabled = enabled;
+}
+
+bool IsRenderSortEnabled() {
+    return g_render_buffer.sort_enabled;
+}
+
+static u32 GetSortableDepth(float depth) {
+    u32 bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000) ? ~bits : bits | 0x80000000;
+}
+
+static u64 GetSortBits(const void* ptr) {
+    // Collisions only cost batching, never correctness, since the sort is stable
+    u64 value = (u64)(uintptr_t)ptr;
+    return ((value >> 4) * 0x9E3779B97F4A7C15ull) >> 56;
+}
+
+static u64 GetSortKey(const DrawMeshData* draw) {
+    return
+        ((u64)GetSortableDepth(draw->depth) << 32) |
+        (GetSortBits(draw->shader) << 24) |
+        (GetSortBits(draw->material) << 16) |
+        (GetSortBits(draw->texture) << 8) |
+        GetSortBits(draw->mesh);
+}
+
+// Draws without a material or shader inherit whatever was bound before them, so they
+// act as barriers rather than being moved or merged.
+static bool IsBatchable(RenderCommand* command) {
+    if (command->type != RENDER_COMMAND_TYPE_DRAW_MESH)
+        return false;
+
+    DrawMeshData* draw = (DrawMeshData*)(command + 1);
+    return draw->material != nullptr || (draw->shader != nullptr && draw->texture != nullptr);
+}
+
+static bool IsSameBatch(const DrawMeshData* a, const DrawMeshData* b) {
+    return
+        a->mesh == b->mesh &&
+        a->material == b->material &&
+        a->shader == b->shader &&
+        a->texture == b->texture &&
+        a->depth_scale == b->depth_scale;
+}
+
+// Stable LSD radix sort, skipping any byte that is the same across the whole run
+static RenderSortItem* SortRenderItems(RenderSortItem* items, RenderSortItem* temp, int count) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        int counts[256] = {};
+        for (int i = 0; i < count; i++)
+            counts[(items[i].key >> shift) & 0xFF]++;
+
+        if (counts[(items[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        int offset = 0;
+        for (int i = 0; i < 256; i++) {
+            int c = counts[i];
+            counts[i] = offset;
+            offset += c;
+        }
+
+        for (int i = 0; i < count; i++)
+            temp[counts[(items[i].key >> shift) & 0xFF]++] = items[i];
+
+        RenderSortItem* swap = items;
+        items = temp;
+        temp = swap;
+    }
+
+    return items;
+}
+
+static void BindRenderState(Material* material, Shader* shader, Texture* texture, RenderState& state) {
+    if (material && material != state.material) {
+        BindMaterialInternal(material);
+        state.material = material;
+        state.shader = nullptr;
+        state.texture = nullptr;
+        state.instanced = IsInstanced(GetShader(material));
+    }
+
+    if (shader && shader != state.shader) {
+        BindShaderInternal(shader);
+        state.shader = shader;
+        state.material = nullptr;
+        state.instanced = IsInstanced(shader);
+    }
+
+    // Only bind loose texture if no material (material handles its own textures)
+    if (texture && !material && texture != state.texture) {
+        BindTextureInternal(texture, 0);
+        state.texture = texture;
+        state.material = nullptr;
+    }
+}
+
+static void BindRenderMesh(Mesh* mesh, RenderState& state) {
+    if (mesh == state.mesh)
+        return;
+
+    BindMeshInternal(mesh);
+    state.mesh = mesh;
+}
+
+// Instanced shaders read depth scale and the depth range from the object buffer and
+// everything else from the instance stream.
+static void DrawInstances(Mesh* mesh, float depth_scale, const PlatformInstance* instances, int count, RenderState& state) {
+    PlatformBindTransform(MAT3_IDENTITY, 0.0f, depth_scale);
+    BindRenderMesh(mesh, state);
+    PlatformDrawIndexedInstanced(GetIndexCount(mesh), instances, (u32)count);
+}
+
+static void ExecuteDrawMesh(DrawMeshData* draw_mesh, RenderState& state) {
+    BindRenderState(draw_mesh->material, draw_mesh->shader, draw_mesh->texture, state);
+
+    if (state.instanced) {
+        PlatformInstance instance;
+        SetInstance(instance, draw_mesh->transform, draw_mesh->depth, draw_mesh->color, draw_mesh->emission, draw_mesh->color_offset);
+        DrawInstances(draw_mesh->mesh, draw_mesh->depth_scale, &instance, 1, state);
+        return;
+    }
+
+    if (!state.has_color ||
+        state.color != draw_mesh->color ||
+        state.emission != draw_mesh->emission ||
+        state.color_offset != draw_mesh->color_offset) {
+        PlatformBindColor(
+            draw_mesh->color,
+            ToVec2(draw_mesh->color_offset),
+            draw_mesh->emission);
+        state.color = draw_mesh->color;
+        state.emission = draw_mesh->emission;
+        state.color_offset = draw_mesh->color_offset;
+        state.has_color = true;
+    }
+
+    PlatformBindTransform(
+        draw_mesh->transform,
+        draw_mesh->depth,
+        draw_mesh->depth_scale);
+
+    BindRenderMesh(draw_mesh->mesh, state);
+    PlatformDrawIndexed(GetIndexCount(draw_mesh->mesh));
+}
+
+// Glyph positions are already in world space and carry their own color
+static void ExecuteDrawGlyphs(DrawGlyphsData* draw, RenderState& state) {
+    BindRenderState(draw->material, nullptr, nullptr, state);
+
+    if (!state.has_color ||
+        state.color != COLOR_WHITE ||
+        state.emission != COLOR_TRANSPARENT ||
+        state.color_offset != VEC2INT_ZERO) {
+        PlatformBindColor(COLOR_WHITE, VEC2_ZERO, COLOR_TRANSPARENT);
+        state.color = COLOR_WHITE;
+        state.emission = COLOR_TRANSPARENT;
+        state.color_offset = VEC2INT_ZERO;
+        state.has_color = true;
+    }
+
+    PlatformBindTransform(MAT3_IDENTITY, draw->depth, draw->depth_scale);
+    PlatformDrawGlyphs(draw->vertices, (u32)draw->quad_count);
+
+    // The glyph stream replaced the bound vertex and index buffers
+    state.mesh = nullptr;
+}
+
+static void ExecuteDrawMeshInstanced(DrawMeshInstancedData* draw, RenderState& state) {
+    BindRenderState(draw->material, draw->shader, draw->texture, state);
+
+    if (state.instanced) {
+        DrawInstances(draw->mesh, draw->depth_scale, draw->instances, draw->instance_count, state);
+        return;
+    }
+
+    // Shader cannot read the instance stream, draw each instance on its own
+    BindRenderMesh(draw->mesh, state);
+    u16 index_count = GetIndexCount(draw->mesh);
+    for (int i = 0; i < draw->instance_count; i++) {
+        const PlatformInstance& instance = draw->instances[i];
+        PlatformBindColor(instance.color, instance.color_offset, instance.emission);
+        PlatformBindTransform(GetInstanceTransform(instance), instance.depth, draw->depth_scale);
+        PlatformDrawIndexed(index_count);
+    }
+
+    state.has_color = false;
+}
+
+// Executes a run of batchable draws, merging adjacent draws of the same batch into a
+// single instanced draw when the shader supports it.
+static void ExecuteDrawMeshes(u8* commands, RenderSortItem* items, int count, RenderState& state) {
+    PlatformInstance* instances = g_render_buffer.batch_instances;
+    for (int i = 0; i < count;) {
+        DrawMeshData* first = (DrawMeshData*)((RenderCommand*)(commands + items[i].offset) + 1);
+        BindRenderState(first->material, first->shader, first->texture, state);
+
+        if (!state.instanced) {
+            ExecuteDrawMesh(first, state);
+            i++;
+            continue;
+        }
+
+        int instance_count = 0;
+        for (; i < count && instance_count < MAX_BATCH_INSTANCES; i++) {
+            DrawMeshData* draw = (DrawMeshData*)((RenderCommand*)(commands + items[i].offset) + 1);
+            if (!IsSameBatch(first, draw))
+                break;
+
+            SetInstance(instances[instance_count++], draw->transform, draw->depth, draw->color, draw->emission, draw->color_offset);
+        }
+
+        DrawInstances(first->mesh, first->depth_scale, instances, instance_count, state);
+    }
+}
+
+static void ExecuteRenderCommand(RenderCommand* command, RenderState& state) {
+    void* data = command + 1;
+    switch (command->type)
+    {
+    case RENDER_COMMAND_TYPE_BIND_VERTEX_USER: {
+        BindUserData* user = (BindUserData*)data;
+        PlatformBindVertexUserData(user->data, user->size);
+        state.material = nullptr;
+        break;
+    }
+
+    case RENDER_COMMAND_TYPE_BIND_FRAGMENT_USER: {
+        BindUserData* user = (BindUserData*)data;
+        PlatformBindFragmentUserData(user->data, user->size);
+        state.material = nullptr;
+        break;
+    }
+
+    case RENDER_COMMAND_TYPE_BIND_CAMERA: {
+        BindCameraData* bind_camera = (BindCameraData*)data;
+        PlatformSetViewport(bind_camera->viewport);
+        PlatformBindCamera(bind_camera->view_matrix);
+        break;
+    }
+
+    case RENDER_COMMAND_TYPE_DRAW_MESH:
+        ExecuteDrawMesh((DrawMeshData*)data, state);
+        break;
+
+    case RENDER_COMMAND_TYPE_DRAW_MESH_INSTANCED:
+        ExecuteDrawMeshInstanced((DrawMeshInstancedData*)data, state);
+        break;
+
+    case RENDER_COMMAND_TYPE_DRAW_GLYPHS:
+        ExecuteDrawGlyphs((DrawGlyphsData*)data, state);
+        break;
+
+    case RENDER_COMMAND_TYPE_BIND_DEFAULT_TEXTURE:
+        BindTextureInternal(TEXTURE_WHITE, ((BindDefaultTextureData*)data)->index);
+        state.material = nullptr;
+        state.texture = nullptr;
+        break;
+
+    case RENDER_COMMAND_TYPE_BIND_SKELETON: {
+        BindSkeletonData* bind_skeleton = (BindSkeletonData*)data;
+        PlatformBindSkeleton(bind_skeleton->bones, (u8)bind_skeleton->bone_count);
+        break;
+    }
+
+    case RENDER_COMMAND_TYPE_BEGIN_CLIP:
+        PlatformBeginClip();
+        break;
+
+    case RENDER_COMMAND_TYPE_END_CLIP_WRITE:
+        PlatformEndClipWrite();
+        break;
+
+    case RENDER_COMMAND_TYPE_END_CLIP:
+        PlatformEndClip();
+        break;
+    }
 }
 
 void ExecuteRenderCommands() {
-    RenderCommand* commands = g_render_buffer.commands;
-    int command_count = g_render_buffer.command_count;
-    
-    for (int command_index=0; command_index < command_count; ++command_index) {
-        RenderCommand* command = commands + command_index;
-        switch (command->type)
-        {
-        case RENDER_COMMAND_TYPE_BIND_VERTEX_USER:
-            PlatformBindVertexUserData(command->data.bind_user_data.data, MAX_UNIFORM_BUFFER_SIZE);
-            break;
-
-        case RENDER_COMMAND_TYPE_BIND_FRAGMENT_USER:
-            PlatformBindFragmentUserData(command->data.bind_user_data.data, MAX_UNIFORM_BUFFER_SIZE);
-            break;
-
-        case RENDER_COMMAND_TYPE_BIND_CAMERA:
-            PlatformSetViewport(command->data.bind_camera.viewport);
-            PlatformBindCamera(command->data.bind_camera.view_matrix);
-            break;
-
-        case RENDER_COMMAND_TYPE_DRAW_MESH:
-            PlatformBindColor(
-                command->data.draw_mesh.color,
-                ToVec2(command->data.draw_mesh.color_offset),
-                command->data.draw_mesh.emission);
-            PlatformBindTransform(
-                command->data.draw_mesh.transform,
-                command->data.draw_mesh.depth,
-                command->data.draw_mesh.depth_scale);
-            if (command->data.draw_mesh.material)
-                BindMaterialInternal(command->data.draw_mesh.material);
-            if (command->data.draw_mesh.shader)
-                BindShaderInternal(command->data.draw_mesh.shader);
-            // Only bind loose texture if no material (material handles its own textures)
-            if (command->data.draw_mesh.texture && !command->data.draw_mesh.material)
-                BindTextureInternal(command->data.draw_mesh.texture, 0);
-
-            RenderMesh(command->data.draw_mesh.mesh);
-            break;
-
-        case RENDER_COMMAND_TYPE_BIND_DEFAULT_TEXTURE:
-            BindTextureInternal(TEXTURE_WHITE, command->data.bind_default_texture.index);
-            break;
-
-        case RENDER_COMMAND_TYPE_BIND_SKELETON:
-            PlatformBindSkeleton(command->data.bind_skeleton.bones, (u8)command->data.bind_skeleton.bone_count);
-            break;
-
-        case RENDER_COMMAND_TYPE_BEGIN_CLIP:
-            PlatformBeginClip();
-            break;
-
-        case RENDER_COMMAND_TYPE_END_CLIP_WRITE:
-            PlatformEndClipWrite();
-            break;
-
-        case RENDER_COMMAND_TYPE_END_CLIP:
-            PlatformEndClip();
-            break;
+    FlushGlyphs();
+
+    u8* commands = g_render_buffer.commands;
+    u32 command_size = g_render_buffer.command_size;
+    bool sort_enabled = g_render_buffer.sort_enabled;
+    RenderState state = {};
+
+    u32 offset = 0;
+    while (offset < command_size) {
+        RenderCommand* command = (RenderCommand*)(commands + offset);
+        if (!IsBatchable(command)) {
+            ExecuteRenderCommand(command, state);
+            offset += command->size;
+            continue;
+        }
+
+        int item_count = 0;
+        RenderSortItem* items = g_render_buffer.sort_items;
+        while (offset < command_size) {
+            command = (RenderCommand*)(commands + offset);
+            if (!IsBatchable(command))
+                break;
+
+            items[item_count++] = { sort_enabled ? GetSortKey((DrawMeshData*)(command + 1)) : 0, offset };
+            offset += command->size;
         }
+
+        if (sort_enabled)
+            items = SortRenderItems(items, g_render_buffer.sort_temp, item_count);
+
+        ExecuteDrawMeshes(commands, items, item_count, state);
     }
 
+    g_render_buffer.last_stats = g_render_buffer.stats;
+    g_render_buffer.last_stats.command_count = g_render_buffer.command_count;
     ClearRenderCommands();
 }
 
 void InitRenderBuffer(const RendererTraits* traits) {
-    g_render_buffer.command_count_max = traits->max_frame_commands;
-    g_render_buffer.commands = static_cast<RenderCommand*>(Alloc(ALLOCATOR_DEFAULT, traits->max_frame_commands * sizeof(RenderCommand)));
+    // Size the stream so max_frame_commands draws fit, the largest fixed size command
+    g_render_buffer.command_size_max = traits->max_frame_commands * AlignRenderSize(sizeof(RenderCommand) + sizeof(DrawMeshData));
+    g_render_buffer.commands = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, g_render_buffer.command_size_max));
+    g_render_buffer.frame_data_size_max = traits->frame_data_memory_size;
+    g_render_buffer.frame_data = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, g_render_buffer.frame_data_size_max));
+    g_render_buffer.sort_items = static_cast<RenderSortItem*>(Alloc(ALLOCATOR_DEFAULT, traits->max_frame_commands * sizeof(RenderSortItem) * 2));
+    g_render_buffer.sort_temp = g_render_buffer.sort_items + traits->max_frame_commands;
+    g_render_buffer.batch_instances = static_cast<PlatformInstance*>(Alloc(ALLOCATOR_DEFAULT, MAX_BATCH_INSTANCES * sizeof(PlatformInstance)));
+    g_render_buffer.frame_glyph_count_max = traits->max_frame_glyphs;
+    g_render_buffer.frame_glyphs = static_cast<GlyphVertex*>(Alloc(ALLOCATOR_DEFAULT, traits->max_frame_glyphs * 4 * sizeof(GlyphVertex)));
 }
 
 void ShutdownRenderBuffer() {
     Free(g_render_buffer.commands);
+    Free(g_render_buffer.frame_data);
+    Free(g_render_buffer.sort_items);
+    Free(g_render_buffer.batch_instances);
+    Free(g_render_buffer.frame_glyphs);
+    for (GlyphStream& stream : g_render_buffer.glyph_streams)
+        Free(stream.vertices);
     g_render_buffer = {};
 }
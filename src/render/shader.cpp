@@ -10,31 +10,28 @@ int SHADER_COUNT = 0;
 struct ShaderImpl : Shader {
     PlatformShader* platform;
     ShaderFlags flags;
+    u8* pending_source;         // Vertex then fragment source from an async load, waiting for UploadShader
+    u32 pending_vertex_length;
+    u32 pending_fragment_length;
 };
 
 void ShaderDestructor(void* p) {
     ShaderImpl* impl = static_cast<ShaderImpl*>(p);
     PlatformFree(impl->platform);
+    Free(impl->pending_source);
 }
 
 static bool LoadShaderInternal(ShaderImpl* impl, Stream* stream, const AssetHeader& header, const Name** name_table) {
     (void)name_table;
     (void)header;
 
-    auto vertex_length = ReadU32(stream);
-    char* vertex = static_cast<char *>(Alloc(ALLOCATOR_DEFAULT, vertex_length));
-    if (!vertex)
-        return false;
-
-    ReadBytes(stream, vertex, vertex_length);
-
+    // The platform compiles or copies the source before returning so it is read in place
+    u32 vertex_length = ReadU32(stream);
+    const u8* vertex = ReadInPlace(stream, vertex_length);
     u32 fragment_length = ReadU32(stream);
-    char* fragment = static_cast<char*>(Alloc(ALLOCATOR_DEFAULT, fragment_length));
-    if (!fragment) {
-        Free(vertex);
+    const u8* fragment = ReadInPlace(stream, fragment_length);
+    if (!vertex || !fragment)
         return false;
-    }
-    ReadBytes(stream, fragment, fragment_length);
 
     impl->flags = static_cast<ShaderFlags>(ReadU8(stream));
 
@@ -48,13 +45,34 @@ static bool LoadShaderInternal(ShaderImpl* impl, Stream* stream, const AssetHead
         }
     }
 
+    // Off the main thread the sources are kept and compiled later by UploadShader
+    if (!IsMainThread()) {
+        impl->pending_source = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, vertex_length + fragment_length));
+        impl->pending_vertex_length = vertex_length;
+        impl->pending_fragment_length = fragment_length;
+        memcpy(impl->pending_source, vertex, vertex_length);
+        memcpy(impl->pending_source + vertex_length, fragment, fragment_length);
+        return true;
+    }
+
     impl->platform = PlatformCreateShader(
         vertex, vertex_length,
         fragment, fragment_length,
         impl->flags, impl->name->value);
 
-    Free(vertex);
-    Free(fragment);
+    return impl->platform != nullptr;
+}
+
+bool UploadShader(Asset* asset) {
+    ShaderImpl* impl = static_cast<ShaderImpl*>(asset);
+    if (impl->pending_source) {
+        impl->platform = PlatformCreateShader(
+            impl->pending_source, impl->pending_vertex_length,
+            impl->pending_source + impl->pending_vertex_length, impl->pending_fragment_length,
+            impl->flags, impl->name->value);
+        Free(impl->pending_source);
+        impl->pending_source = nullptr;
+    }
 
     return impl->platform != nullptr;
 }
@@ -84,6 +102,10 @@ void BindShaderInternal(Shader* shader) {
     PlatformBindShader(static_cast<ShaderImpl*>(shader)->platform);
 }
 
+bool IsInstanced(Shader* shader) {
+    return shader && (static_cast<ShaderImpl*>(shader)->flags & SHADER_FLAGS_INSTANCED) != 0;
+}
+
 #if !defined(NOZ_BUILTIN_ASSETS)
 
 void ReloadShader(Asset* asset, Stream* stream, const AssetHeader& header, const Name** name_table) {
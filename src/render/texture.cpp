@@ -18,6 +18,7 @@ struct TextureImpl : Texture {
     Vec2Int size;
     bool is_array = false;
     int layer_count = 1;
+    u8* pending_data = nullptr;     // Pixels parsed by an async load, waiting for UploadTexture
 };
 
 struct AtlasImpl : Atlas {
@@ -45,9 +46,21 @@ int GetBytesPerPixel(TextureFormat format) {
     }
 }
 
+bool IsBlockCompressed(TextureFormat format) {
+    return format == TEXTURE_FORMAT_BC1 || format == TEXTURE_FORMAT_BC3 || format == TEXTURE_FORMAT_ETC2;
+}
+
+u32 GetTextureDataSize(TextureFormat format, int width, int height) {
+    if (!IsBlockCompressed(format))
+        return (u32)(width * height * GetBytesPerPixel(format));
+
+    u32 block_size = format == TEXTURE_FORMAT_BC1 ? 8 : 16;
+    return (u32)((width + 3) / 4) * (u32)((height + 3) / 4) * block_size;
+}
+
 static void CreateTexture(
     TextureImpl* impl,
-    void* data,
+    const void* data,
     size_t width,
     size_t height,
     TextureFormat format,
@@ -59,6 +72,40 @@ static void CreateTexture(
 
     impl->size = { static_cast<i32>(width), static_cast<i32>(height) };
     impl->format = format;
+
+    if (IsBlockCompressed(format)) {
+        if (PlatformIsTextureFormatSupported(format)) {
+            impl->platform_texture = PlatformCreateCompressedTexture(
+                data,
+                GetTextureDataSize(format, (int)width, (int)height),
+                width,
+                height,
+                format,
+                impl->sampler_options,
+                name->value);
+            if (impl->platform_texture)
+                return;
+        }
+
+        // Backend can't sample the format, expand to RGBA8 on the CPU.  The decoded image
+        // is several times the size of the blocks so it doesn't come from scratch memory.
+        u8* rgba = (u8*)Alloc(ALLOCATOR_DEFAULT, width * height * 4);
+        if (!rgba)
+            return;
+
+        DecodeTexture(format, (const u8*)data, (int)width, (int)height, rgba);
+        impl->format = TEXTURE_FORMAT_RGBA8;
+        impl->platform_texture = PlatformCreateTexture(
+            rgba,
+            width,
+            height,
+            GetBytesPerPixel(TEXTURE_FORMAT_RGBA8),
+            impl->sampler_options,
+            name->value);
+        Free(rgba);
+        return;
+    }
+
     impl->platform_texture = PlatformCreateTexture(
         data,
         width,
@@ -95,7 +142,7 @@ Texture* CreateTexture(Allocator* allocator, int width, int height, TextureForma
 
 Texture* CreateTexture(
     Allocator* allocator,
-    void* data,
+    const void* data,
     size_t width,
     size_t height,
     TextureFormat format,
@@ -142,20 +189,49 @@ SamplerOptions GetSamplerOptions(Texture* texture)
     return static_cast<TextureImpl*>(texture)->sampler_options;
 }
 
+// Off the main thread the pixels are copied out of the stream, expanding block formats the
+// backend can't sample on the worker, and the texture is created later by UploadTexture
+static void LoadPendingTexture(TextureImpl* impl, const u8* data) {
+    u32 data_size = GetTextureDataSize(impl->format, impl->size.x, impl->size.y);
+    if (IsBlockCompressed(impl->format) && !PlatformIsTextureFormatSupported(impl->format)) {
+        impl->pending_data = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, impl->size.x * impl->size.y * 4));
+        DecodeTexture(impl->format, data, impl->size.x, impl->size.y, impl->pending_data);
+        impl->format = TEXTURE_FORMAT_RGBA8;
+        return;
+    }
+
+    impl->pending_data = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, data_size));
+    memcpy(impl->pending_data, data, data_size);
+}
+
 static void LoadTextureInternal(TextureImpl* impl, Stream* stream, const Name* name) {
+    impl->name = name;
     impl->format = (TextureFormat)ReadU8(stream);
     impl->sampler_options.filter  = (TextureFilter)ReadU8(stream);
     impl->sampler_options.clamp = (TextureClamp)ReadU8(stream);
     impl->size.x = ReadU32(stream);
     impl->size.y = ReadU32(stream);
 
-    const int channels = GetBytesPerPixel(impl->format);
-    const u32 data_size = impl->size.x * impl->size.y * channels;
-    if (const auto texture_data = (u8*)Alloc(ALLOCATOR_SCRATCH, data_size)) {
-        ReadBytes(stream, texture_data, data_size);
+    const u32 data_size = GetTextureDataSize(impl->format, impl->size.x, impl->size.y);
+    const u8* texture_data = ReadInPlace(stream, data_size);
+    if (!texture_data)
+        return;
+
+    if (IsMainThread())
         CreateTexture(impl, texture_data, impl->size.x, impl->size.y, impl->format, GetName(name->value));
-        Free(texture_data);
+    else
+        LoadPendingTexture(impl, texture_data);
+}
+
+bool UploadTexture(Asset* asset) {
+    TextureImpl* impl = static_cast<TextureImpl*>(asset);
+    if (impl->pending_data) {
+        CreateTexture(impl, impl->pending_data, impl->size.x, impl->size.y, impl->format, GetName(impl->name->value));
+        Free(impl->pending_data);
+        impl->pending_data = nullptr;
     }
+
+    return impl->platform_texture != nullptr;
 }
 
 Asset* LoadTexture(Allocator* allocator, Stream* stream, AssetHeader* header, const Name* name, const Name** name_table) {
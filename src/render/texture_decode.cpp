@@ -0,0 +1,301 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+// CPU decoders for the block compressed texture formats, used when the render backend
+// cannot sample a format directly.  Every format stores 4x4 pixel blocks in row major order.
+
+#include "../internal.h"
+
+static const int g_etc1_modifiers[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+};
+
+static const int g_etc2_distances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static const int g_eac_modifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}
+};
+
+static u8 ClampByte(int value) {
+    return (u8)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+static u64 ReadBigEndian64(const u8* src) {
+    u64 value = 0;
+    for (int i = 0; i < 8; i++)
+        value = (value << 8) | src[i];
+    return value;
+}
+
+static void DecodeColor565(u16 value, u8* rgb) {
+    u8 r = (value >> 11) & 0x1F;
+    u8 g = (value >> 5) & 0x3F;
+    u8 b = value & 0x1F;
+    rgb[0] = (u8)((r << 3) | (r >> 2));
+    rgb[1] = (u8)((g << 2) | (g >> 4));
+    rgb[2] = (u8)((b << 3) | (b >> 2));
+}
+
+// BC1 color block, BC3 always uses the four color palette regardless of endpoint order
+static void DecodeBC1Block(const u8* src, u8* out, bool four_color) {
+    u16 c0 = (u16)(src[0] | (src[1] << 8));
+    u16 c1 = (u16)(src[2] | (src[3] << 8));
+    u32 indices = (u32)src[4] | ((u32)src[5] << 8) | ((u32)src[6] << 16) | ((u32)src[7] << 24);
+
+    u8 palette[4][4];
+    DecodeColor565(c0, palette[0]);
+    DecodeColor565(c1, palette[1]);
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+
+    if (four_color || c0 > c1) {
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (u8)((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = (u8)((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+        palette[2][3] = 255;
+        palette[3][3] = 255;
+    } else {
+        for (int c = 0; c < 3; c++)
+            palette[2][c] = (u8)((palette[0][c] + palette[1][c]) / 2);
+        palette[2][3] = 255;
+        palette[3][0] = palette[3][1] = palette[3][2] = palette[3][3] = 0;
+    }
+
+    for (int i = 0; i < 16; i++)
+        memcpy(out + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+}
+
+static void DecodeBC3AlphaBlock(const u8* src, u8* out) {
+    u8 a0 = src[0];
+    u8 a1 = src[1];
+    u64 indices = 0;
+    for (int i = 0; i < 6; i++)
+        indices |= (u64)src[2 + i] << (i * 8);
+
+    u8 palette[8];
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int i = 1; i < 7; i++)
+            palette[i + 1] = (u8)(((7 - i) * a0 + i * a1) / 7);
+    } else {
+        for (int i = 1; i < 5; i++)
+            palette[i + 1] = (u8)(((5 - i) * a0 + i * a1) / 5);
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (int i = 0; i < 16; i++)
+        out[i * 4 + 3] = palette[(indices >> (i * 3)) & 7];
+}
+
+static void WriteETCPixels(u64 block, const u8 paint[4][3], u8* out) {
+    for (int i = 0; i < 16; i++) {
+        // Pixel indices are stored column major, most significant bits in the upper half
+        int x = i / 4;
+        int y = i % 4;
+        int index = (int)(((block >> (16 + i)) & 1) << 1 | ((block >> i) & 1));
+        u8* pixel = out + (y * 4 + x) * 4;
+        pixel[0] = paint[index][0];
+        pixel[1] = paint[index][1];
+        pixel[2] = paint[index][2];
+    }
+}
+
+static void DecodeETC2ColorBlock(const u8* src, u8* out) {
+    u64 block = ReadBigEndian64(src);
+    bool diff = (block >> 33) & 1;
+
+    int r = (int)(block >> 59) & 0x1F;
+    int g = (int)(block >> 51) & 0x1F;
+    int b = (int)(block >> 43) & 0x1F;
+    int dr = ((int)(block >> 56) & 7) ^ 4;
+    int dg = ((int)(block >> 48) & 7) ^ 4;
+    int db = ((int)(block >> 40) & 7) ^ 4;
+    dr -= 4;
+    dg -= 4;
+    db -= 4;
+
+    if (diff && (r + dr < 0 || r + dr > 31)) {
+        // T mode
+        int r1 = (int)((((block >> 59) & 3) << 2) | ((block >> 56) & 3));
+        int g1 = (int)(block >> 52) & 0xF;
+        int b1 = (int)(block >> 48) & 0xF;
+        int r2 = (int)(block >> 44) & 0xF;
+        int g2 = (int)(block >> 40) & 0xF;
+        int b2 = (int)(block >> 36) & 0xF;
+        int d = g_etc2_distances[(((block >> 34) & 3) << 1) | ((block >> 32) & 1)];
+
+        u8 base1[3] = { (u8)(r1 * 17), (u8)(g1 * 17), (u8)(b1 * 17) };
+        u8 base2[3] = { (u8)(r2 * 17), (u8)(g2 * 17), (u8)(b2 * 17) };
+        u8 paint[4][3];
+        for (int c = 0; c < 3; c++) {
+            paint[0][c] = base1[c];
+            paint[1][c] = ClampByte(base2[c] + d);
+            paint[2][c] = base2[c];
+            paint[3][c] = ClampByte(base2[c] - d);
+        }
+        WriteETCPixels(block, paint, out);
+        return;
+    }
+
+    if (diff && (g + dg < 0 || g + dg > 31)) {
+        // H mode
+        int r1 = (int)(block >> 59) & 0xF;
+        int g1 = (int)((((block >> 56) & 7) << 1) | ((block >> 52) & 1));
+        int b1 = (int)((((block >> 51) & 1) << 3) | ((block >> 47) & 7));
+        int r2 = (int)(block >> 43) & 0xF;
+        int g2 = (int)(block >> 39) & 0xF;
+        int b2 = (int)(block >> 35) & 0xF;
+        int base1 = (r1 << 8) | (g1 << 4) | b1;
+        int base2 = (r2 << 8) | (g2 << 4) | b2;
+        int d = g_etc2_distances[(((block >> 34) & 1) << 2) | (((block >> 32) & 1) << 1) | (base1 >= base2 ? 1 : 0)];
+
+        u8 c1[3] = { (u8)(r1 * 17), (u8)(g1 * 17), (u8)(b1 * 17) };
+        u8 c2[3] = { (u8)(r2 * 17), (u8)(g2 * 17), (u8)(b2 * 17) };
+        u8 paint[4][3];
+        for (int c = 0; c < 3; c++) {
+            paint[0][c] = ClampByte(c1[c] + d);
+            paint[1][c] = ClampByte(c1[c] - d);
+            paint[2][c] = ClampByte(c2[c] + d);
+            paint[3][c] = ClampByte(c2[c] - d);
+        }
+        WriteETCPixels(block, paint, out);
+        return;
+    }
+
+    if (diff && (b + db < 0 || b + db > 31)) {
+        // Planar mode
+        int ro = (int)(block >> 57) & 0x3F;
+        int go = (int)((((block >> 56) & 1) << 6) | ((block >> 49) & 0x3F));
+        int bo = (int)((((block >> 48) & 1) << 5) | (((block >> 43) & 3) << 3) | ((block >> 39) & 7));
+        int rh = (int)((((block >> 34) & 0x1F) << 1) | ((block >> 32) & 1));
+        int gh = (int)(block >> 25) & 0x7F;
+        int bh = (int)(block >> 19) & 0x3F;
+        int rv = (int)(block >> 13) & 0x3F;
+        int gv = (int)(block >> 6) & 0x7F;
+        int bv = (int)block & 0x3F;
+
+        ro = (ro << 2) | (ro >> 4); rh = (rh << 2) | (rh >> 4); rv = (rv << 2) | (rv >> 4);
+        go = (go << 1) | (go >> 6); gh = (gh << 1) | (gh >> 6); gv = (gv << 1) | (gv >> 6);
+        bo = (bo << 2) | (bo >> 4); bh = (bh << 2) | (bh >> 4); bv = (bv << 2) | (bv >> 4);
+
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                u8* pixel = out + (y * 4 + x) * 4;
+                pixel[0] = ClampByte((x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2);
+                pixel[1] = ClampByte((x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2);
+                pixel[2] = ClampByte((x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+            }
+        }
+        return;
+    }
+
+    // Individual or differential mode, two sub blocks with their own base color and table
+    u8 base[2][3];
+    if (diff) {
+        int r2 = r + dr;
+        int g2 = g + dg;
+        int b2 = b + db;
+        base[0][0] = (u8)((r << 3) | (r >> 2));
+        base[0][1] = (u8)((g << 3) | (g >> 2));
+        base[0][2] = (u8)((b << 3) | (b >> 2));
+        base[1][0] = (u8)((r2 << 3) | (r2 >> 2));
+        base[1][1] = (u8)((g2 << 3) | (g2 >> 2));
+        base[1][2] = (u8)((b2 << 3) | (b2 >> 2));
+    } else {
+        base[0][0] = (u8)(((block >> 60) & 0xF) * 17);
+        base[1][0] = (u8)(((block >> 56) & 0xF) * 17);
+        base[0][1] = (u8)(((block >> 52) & 0xF) * 17);
+        base[1][1] = (u8)(((block >> 48) & 0xF) * 17);
+        base[0][2] = (u8)(((block >> 44) & 0xF) * 17);
+        base[1][2] = (u8)(((block >> 40) & 0xF) * 17);
+    }
+
+    int table[2] = { (int)(block >> 37) & 7, (int)(block >> 34) & 7 };
+    bool flip = (block >> 32) & 1;
+
+    for (int i = 0; i < 16; i++) {
+        int x = i / 4;
+        int y = i % 4;
+        int sub = flip ? (y >= 2) : (x >= 2);
+        int msb = (int)(block >> (16 + i)) & 1;
+        int lsb = (int)(block >> i) & 1;
+        int modifier = g_etc1_modifiers[table[sub]][lsb];
+        if (msb)
+            modifier = -modifier;
+
+        u8* pixel = out + (y * 4 + x) * 4;
+        pixel[0] = ClampByte(base[sub][0] + modifier);
+        pixel[1] = ClampByte(base[sub][1] + modifier);
+        pixel[2] = ClampByte(base[sub][2] + modifier);
+    }
+}
+
+static void DecodeEACAlphaBlock(const u8* src, u8* out) {
+    u64 block = ReadBigEndian64(src);
+    int base = (int)(block >> 56) & 0xFF;
+    int multiplier = (int)(block >> 52) & 0xF;
+    const int* modifiers = g_eac_modifiers[(block >> 48) & 0xF];
+
+    for (int i = 0; i < 16; i++) {
+        int x = i / 4;
+        int y = i % 4;
+        int index = (int)(block >> (45 - i * 3)) & 7;
+        out[(y * 4 + x) * 4 + 3] = ClampByte(base + modifiers[index] * multiplier);
+    }
+}
+
+void DecodeTexture(TextureFormat format, const u8* data, int width, int height, u8* rgba) {
+    assert(IsBlockCompressed(format));
+    assert(data);
+    assert(rgba);
+
+    const int block_size = format == TEXTURE_FORMAT_BC1 ? 8 : 16;
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+
+    u8 block[16 * 4];
+    for (int by = 0; by < blocks_y; by++) {
+        for (int bx = 0; bx < blocks_x; bx++, data += block_size) {
+            switch (format) {
+            case TEXTURE_FORMAT_BC1:
+                DecodeBC1Block(data, block, false);
+                break;
+            case TEXTURE_FORMAT_BC3:
+                DecodeBC1Block(data + 8, block, true);
+                DecodeBC3AlphaBlock(data, block);
+                break;
+            case TEXTURE_FORMAT_ETC2:
+                DecodeETC2ColorBlock(data + 8, block);
+                DecodeEACAlphaBlock(data, block);
+                break;
+            default:
+                break;
+            }
+
+            // Edge blocks may hang past the end of the image
+            int copy_width = Min(4, width - bx * 4);
+            int copy_height = Min(4, height - by * 4);
+            for (int y = 0; y < copy_height; y++)
+                memcpy(rgba + ((by * 4 + y) * width + bx * 4) * 4, block + y * 16, copy_width * 4);
+        }
+    }
+}
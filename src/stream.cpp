@@ -14,6 +14,7 @@ struct StreamImpl : Stream {
     u32 capacity;
     u32 position;
     bool free_data;
+    bool read_only;
     StreamEndianess endianess;
 };
 
@@ -64,6 +65,25 @@ Stream* CreateStream(Allocator* allocator, u8* data, u32 size) {
     return impl;
 }
 
+Stream* CreateReadOnlyStream(Allocator* allocator, const u8* data, u32 size) {
+    assert(data);
+
+    StreamImpl* impl = static_cast<StreamImpl *>(Alloc(allocator, sizeof(StreamImpl), StreamDestructor));
+    if (!impl)
+        return nullptr;
+
+    impl->capacity = size;
+    impl->data = const_cast<u8*>(data);
+    impl->size = size;
+    impl->position = 0;
+    impl->read_only = true;
+    return impl;
+}
+
+bool IsReadOnly(Stream* stream) {
+    return static_cast<StreamImpl*>(stream)->read_only;
+}
+
 Stream* LoadStream(Allocator* allocator, const u8* data, u32 size) {
     StreamImpl* impl = static_cast<StreamImpl*>(CreateStream(allocator, size));
     EnsureCapacity(impl, size);
@@ -342,6 +362,21 @@ int ReadBytes(Stream* stream, void* dest, u32 size) {
     return static_cast<int>(size);
 }
 
+// Returns a pointer into the stream data and skips past it, or nullptr if the stream is short
+const u8* ReadInPlace(Stream* stream, u32 count) {
+    if (!stream) return nullptr;
+
+    StreamImpl* impl = static_cast<StreamImpl*>(stream);
+    if (count > impl->size - impl->position) {
+        impl->position = impl->size;
+        return nullptr;
+    }
+
+    const u8* data = impl->data + impl->position;
+    impl->position += count;
+    return data;
+}
+
 void WriteU8(Stream* stream, u8 value) {
     WriteBytes(stream, &value, sizeof(u8));
 }
@@ -443,6 +478,10 @@ void WriteBytes(Stream* stream, const void* data, u32 size) {
     if (!stream || !data || size == 0) return;
 
     StreamImpl* impl = static_cast<StreamImpl*>(stream);
+    if (impl->read_only) {
+        LogError("[STREAM] Write to read only stream");
+        return;
+    }
 
     // Sanity checks for corruption
     if (impl->position > impl->capacity || impl->size > impl->capacity) {
@@ -481,7 +520,7 @@ void WriteColor(Stream* stream, Color value) {
 }
 
 static void Resize(StreamImpl* impl, u32 new_capacity) {
-    if (new_capacity < impl->capacity)
+    if (new_capacity < impl->capacity || impl->read_only)
         return;
 
     u8* new_data = static_cast<u8*>(Realloc(impl->data, new_capacity));
@@ -12,6 +12,18 @@
 #include <thread>
 
 namespace noz {
+
+constexpr i32 TASK_INDEX_NONE = -1;
+constexpr i32 TASK_SIGNAL_BUSY = -2;    // dependent is being signaled right now
+constexpr i32 TASK_SIGNAL_DONE = -3;    // dependent was signaled (or there was none)
+constexpr i32 TASK_SPIN_COUNT = 64;
+
+enum TaskQueueType {
+    TASK_QUEUE_FRAME,
+    TASK_QUEUE_REGULAR,
+    TASK_QUEUE_COUNT
+};
+
 struct TaskImpl {
     std::atomic<TaskState> state{TASK_STATE_FREE};
     TaskRunFunc run_func;
@@ -23,11 +35,20 @@ struct TaskImpl {
     i32 dependency_next;
     i32 dependency_count;
     i32 dependent;
-    u64 start_frame;
-    int generation;
+    std::atomic<i32> dependent_signal{TASK_INDEX_NONE};
+    std::atomic<i32> unfinished{0};     // unfinished dependencies + 1 while being created
+    std::atomic<bool> busy{false};      // sitting in a queue or being run by a thread
+    std::atomic<i32> next_free{TASK_INDEX_NONE};
+    i32 next_retired;
+    std::atomic_flag child_lock;
+    i32 child_head;
+    i32 child_prev;
+    i32 child_next;
+    bool child_linked;
+    std::atomic<int> generation{0};
     bool is_virtual;
     bool is_frame_task;
-    u64 frame_id;
+    bool is_detached;                   // internal helper, freed by the thread that ran it
 
 #if defined(TASK_DEBUG)
     String128 name;
@@ -37,26 +58,44 @@ struct TaskImpl {
 #endif
 };
 
+// Chase-Lev work stealing deque.  The owning thread pushes and pops at the bottom,
+// every other thread steals from the top.  A task is in at most one queue at a time
+// so the queues never need to grow.
+struct TaskQueue {
+    alignas(64) std::atomic<i64> top{0};
+    alignas(64) std::atomic<i64> bottom{0};
+    std::atomic<i32>* items;
+    i64 mask;
+};
+
 struct TaskWorker {
     std::thread thread;
-    std::atomic<bool> running{false};
-    std::atomic<TaskImpl*> current_task{nullptr};
-    std::condition_variable cv;
-    std::mutex cv_mutex;
+    TaskQueue queues[TASK_QUEUE_COUNT];
 };
 
 struct TaskSystem {
     TaskImpl* tasks;
     i32 max_tasks;
     i32 max_frame_tasks;
-    TaskWorker* workers;
+    TaskWorker* workers;                // worker_count workers followed by the main thread
     i32 worker_count;
-    std::mutex mutex;
+    std::atomic<u64> free_list[TASK_QUEUE_COUNT];
+    std::atomic<i32> retired{TASK_INDEX_NONE};
+    i32* retained;
+    i32 retained_count;
+    std::mutex inject_mutex;
+    i32* inject;
+    i32 inject_head;
+    i32 inject_count;
+    std::atomic<i32> inject_size{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    std::atomic<i32> sleeping_count{0};
+    std::atomic<i32> queued_count{0};
+    std::atomic<i32> active_count{0};
     std::atomic<bool> running{false};
-    std::atomic<bool> tasks_completed{false};
     std::atomic<i32> pending_frame_tasks{0};
-    u64 current_frame;
-    u32 next_generation;
+    std::atomic<u32> next_generation;
 };
 
 void UpdateTasks();
@@ -64,14 +103,13 @@ void InitTasks(const ApplicationTraits& traits);
 void ShutdownTasks();
 
 static TaskSystem g_tasks = {};
+static thread_local i32 t_queue_owner = TASK_INDEX_NONE;
 } // namespace noz
 
-static bool AreAllDependenciesReady(noz::TaskImpl& impl);
-
 using namespace noz;
 
 static TaskImpl* GetTask(Task handle) {
-    if (handle.generation == 0 || handle.id >= g_tasks.max_tasks)
+    if (handle.generation == 0 || handle.id < 0 || handle.id >= g_tasks.max_tasks)
         return nullptr;
 
     TaskImpl& task = g_tasks.tasks[handle.id];
@@ -89,136 +127,483 @@ inline int GetTaskIndex(TaskImpl* impl) {
     return static_cast<int>(impl - g_tasks.tasks);
 }
 
-static Task CreateTaskInternal(
-    TaskRunFunc run_func,
-    TaskCompleteFunc complete_func,
-    TaskDestroyFunc destroy_func,
-    const Task* deps,
-    i32 dep_count,
-    const char* name
-) {
-    (void) name;
+// @queue
+static void InitQueue(TaskQueue& queue, i32 min_capacity) {
+    i32 capacity = 1;
+    while (capacity < min_capacity)
+        capacity <<= 1;
 
-    std::lock_guard lock(g_tasks.mutex);
+    queue.items = new std::atomic<i32>[capacity];
+    queue.mask = capacity - 1;
+    queue.top = 0;
+    queue.bottom = 0;
+}
 
-    // Skip frame task reserved slots (start from max_frame_tasks)
-    for (i32 task_index = g_tasks.max_frame_tasks; task_index < g_tasks.max_tasks; task_index++) {
-        TaskImpl& impl = g_tasks.tasks[task_index];
-        TaskState expected = TASK_STATE_FREE;
-        if (!impl.state.compare_exchange_strong(expected, TASK_STATE_PENDING))
-            continue;
+static void PushQueue(TaskQueue& queue, i32 task_index) {
+    i64 bottom = queue.bottom.load(std::memory_order_relaxed);
+    assert(bottom - queue.top.load(std::memory_order_acquire) <= queue.mask);
+    queue.items[bottom & queue.mask].store(task_index, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+static i32 PopQueue(TaskQueue& queue) {
+    i64 bottom = queue.bottom.load(std::memory_order_relaxed) - 1;
+    queue.bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    i64 top = queue.top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return TASK_INDEX_NONE;
+    }
+
+    i32 task_index = queue.items[bottom & queue.mask].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // Last item, race the stealers for it
+        if (!queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            task_index = TASK_INDEX_NONE;
+        queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return task_index;
+}
+
+static i32 StealQueue(TaskQueue& queue) {
+    i64 top = queue.top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    i64 bottom = queue.bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return TASK_INDEX_NONE;
+
+    i32 task_index = queue.items[top & queue.mask].load(std::memory_order_relaxed);
+    if (!queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return TASK_INDEX_NONE;
+
+    return task_index;
+}
+
+static void WakeWorker() {
+    if (g_tasks.sleeping_count.load() == 0)
+        return;
 
-        impl.generation = ++g_tasks.next_generation;
-        impl.run_func = std::move(run_func);
-        impl.complete_func = std::move(complete_func);
-        impl.destroy_func = std::move(destroy_func);
-        impl.parent = nullptr;
-        impl.result = nullptr;
-        impl.start_frame = g_tasks.current_frame;
-        impl.is_virtual = false;
-        impl.is_frame_task = false;
-        impl.frame_id = 0;
-        impl.dependent = -1;
+    std::lock_guard lock(g_tasks.sleep_mutex);
+    g_tasks.sleep_cv.notify_one();
+}
+
+// Queue a task whose dependencies are all satisfied.  Worker threads and the main thread
+// push to their own deque, any other thread goes through the shared inject queue.
+static void ScheduleTask(TaskImpl* impl) {
+    impl->busy.store(true);
+    if (impl->state.load() != TASK_STATE_PENDING) {
+        impl->busy.store(false);
+        return;
+    }
 
 #if defined(TASK_DEBUG)
-        impl.debug_start_time = GetRealTime();
-        Set(impl.name, name);
-#endif
-#if defined(TASK_DEBUG_VERBOSE)
-        LogInfo("[TASK] QUEUED   : %3d: %s", task_index, impl.name);
+    impl->debug_queue_time = GetRealTime();
 #endif
 
-        impl.dependency_head = -1;
-        impl.dependency_next = -1;
-        impl.dependency_count = 0;
+    i32 task_index = GetTaskIndex(impl);
+    if (t_queue_owner != TASK_INDEX_NONE) {
+        TaskWorker& owner = g_tasks.workers[t_queue_owner];
+        PushQueue(owner.queues[impl->is_frame_task || impl->is_detached ? TASK_QUEUE_FRAME : TASK_QUEUE_REGULAR], task_index);
+    } else {
+        std::lock_guard lock(g_tasks.inject_mutex);
+        g_tasks.inject[(g_tasks.inject_head + g_tasks.inject_count) % g_tasks.max_tasks] = task_index;
+        g_tasks.inject_count++;
+        g_tasks.inject_size.store(g_tasks.inject_count);
+    }
 
-        if (dep_count > 0) {
-#ifndef NDEBUG
-            for (i32 j = 0; j < dep_count; j++)
-                assert(deps[j].id < g_tasks.max_tasks && "Invalid dependency handle");
-#endif
+    g_tasks.queued_count.fetch_add(1);
+    WakeWorker();
+}
+
+static TaskImpl* TakeQueuedTask(i32 owner_index, bool frame_only) {
+    i32 owner_count = g_tasks.worker_count + 1;
+    for (i32 queue_type = 0; queue_type < (frame_only ? 1 : TASK_QUEUE_COUNT); queue_type++) {
+        i32 task_index = PopQueue(g_tasks.workers[owner_index].queues[queue_type]);
+        for (i32 i = 1; task_index == TASK_INDEX_NONE && i < owner_count; i++)
+            task_index = StealQueue(g_tasks.workers[(owner_index + i) % owner_count].queues[queue_type]);
+
+        if (task_index != TASK_INDEX_NONE) {
+            g_tasks.queued_count.fetch_sub(1);
+            return &g_tasks.tasks[task_index];
+        }
+    }
+
+    if (frame_only || g_tasks.inject_size.load() == 0)
+        return nullptr;
+
+    std::lock_guard lock(g_tasks.inject_mutex);
+    if (g_tasks.inject_count == 0)
+        return nullptr;
+
+    i32 task_index = g_tasks.inject[g_tasks.inject_head];
+    g_tasks.inject_head = (g_tasks.inject_head + 1) % g_tasks.max_tasks;
+    g_tasks.inject_count--;
+    g_tasks.inject_size.store(g_tasks.inject_count);
+    g_tasks.queued_count.fetch_sub(1);
+    return &g_tasks.tasks[task_index];
+}
+
+// @free_list
+static TaskImpl* AllocTask(TaskQueueType type) {
+    std::atomic<u64>& head = g_tasks.free_list[type];
+    u64 current = head.load(std::memory_order_acquire);
+    while (true) {
+        i32 task_index = static_cast<i32>(static_cast<u32>(current));
+        if (task_index == TASK_INDEX_NONE)
+            return nullptr;
+
+        i32 next = g_tasks.tasks[task_index].next_free.load(std::memory_order_relaxed);
+        u64 tag = (current >> 32) + 1;
+        if (head.compare_exchange_weak(current, (tag << 32) | static_cast<u32>(next), std::memory_order_acq_rel, std::memory_order_acquire))
+            return &g_tasks.tasks[task_index];
+    }
+}
+
+static void FreeTask(TaskImpl* impl) {
+    std::atomic<u64>& head = g_tasks.free_list[impl->is_frame_task ? TASK_QUEUE_FRAME : TASK_QUEUE_REGULAR];
+    u64 current = head.load(std::memory_order_relaxed);
+    while (true) {
+        impl->next_free.store(static_cast<i32>(static_cast<u32>(current)), std::memory_order_relaxed);
+        u64 tag = (current >> 32) + 1;
+        if (head.compare_exchange_weak(current, (tag << 32) | static_cast<u32>(GetTaskIndex(impl)), std::memory_order_release, std::memory_order_relaxed))
+            return;
+    }
+}
+
+// Hand a finished (complete or cancelled) task to the main thread for callbacks and cleanup
+static void RetireTask(TaskImpl* impl) {
+    i32 task_index = GetTaskIndex(impl);
+    i32 head = g_tasks.retired.load(std::memory_order_relaxed);
+    do {
+        impl->next_retired = head;
+    } while (!g_tasks.retired.compare_exchange_weak(head, task_index, std::memory_order_release, std::memory_order_relaxed));
+}
+
+static void FinishTask(TaskImpl* impl) {
+    g_tasks.active_count.fetch_sub(1);
+    if (impl->is_frame_task)
+        g_tasks.pending_frame_tasks.fetch_sub(1);
+    RetireTask(impl);
+}
+
+static bool CancelTaskState(TaskImpl* impl) {
+    TaskState expected = TASK_STATE_PENDING;
+    if (!impl->state.compare_exchange_strong(expected, TASK_STATE_CANCELED)) {
+        expected = TASK_STATE_RUNNING;
+        if (!impl->state.compare_exchange_strong(expected, TASK_STATE_CANCELED))
+            return false;
+    }
+
+    FinishTask(impl);
+    return true;
+}
+
+// @children
+static void LockChildren(TaskImpl* impl) {
+    while (impl->child_lock.test_and_set(std::memory_order_acquire))
+        ThreadYield();
+}
+
+static void UnlockChildren(TaskImpl* impl) {
+    impl->child_lock.clear(std::memory_order_release);
+}
+
+static void UnlinkChild(TaskImpl* impl) {
+    if (!impl->parent)
+        return;
+
+    TaskImpl& parent = g_tasks.tasks[impl->parent.id];
+    LockChildren(&parent);
+    if (impl->child_linked && impl->parent.id == GetTaskIndex(&parent)) {
+        if (impl->child_prev != TASK_INDEX_NONE)
+            g_tasks.tasks[impl->child_prev].child_next = impl->child_next;
+        else
+            parent.child_head = impl->child_next;
+
+        if (impl->child_next != TASK_INDEX_NONE)
+            g_tasks.tasks[impl->child_next].child_prev = impl->child_prev;
+
+        impl->child_linked = false;
+    }
+    UnlockChildren(&parent);
+}
+
+static void LinkChild(TaskImpl* impl, Task parent_handle) {
+    UnlinkChild(impl);
+    impl->parent = parent_handle;
+
+    TaskImpl* parent = GetTask(parent_handle);
+    if (!parent)
+        return;
+
+    LockChildren(parent);
+    if (parent->generation == parent_handle.generation) {
+        i32 task_index = GetTaskIndex(impl);
+        impl->child_prev = TASK_INDEX_NONE;
+        impl->child_next = parent->child_head;
+        if (parent->child_head != TASK_INDEX_NONE)
+            g_tasks.tasks[parent->child_head].child_prev = task_index;
+        parent->child_head = task_index;
+        impl->child_linked = true;
+    }
+    UnlockChildren(parent);
+}
+
+// Detach all children, cancelling them when the parent itself was cancelled
+static void ReleaseChildren(TaskImpl* impl, bool cancel) {
+    LockChildren(impl);
+    i32 child_index = impl->child_head;
+    while (child_index != TASK_INDEX_NONE) {
+        TaskImpl& child = g_tasks.tasks[child_index];
+        child_index = child.child_next;
+        if (cancel)
+            CancelTaskState(&child);
+        child.parent = nullptr;
+        child.child_linked = false;
+    }
+    impl->child_head = TASK_INDEX_NONE;
+    impl->generation = 0;
+    UnlockChildren(impl);
+}
+
+// @dependency
+static void SignalDependent(TaskImpl* impl) {
+    i32 dependent_index = impl->dependent_signal.exchange(TASK_SIGNAL_BUSY);
+    if (dependent_index >= 0) {
+        TaskImpl& dependent = g_tasks.tasks[dependent_index];
+        if (dependent.unfinished.fetch_sub(1) == 1)
+            ScheduleTask(&dependent);
+    }
+    impl->dependent_signal.store(TASK_SIGNAL_DONE);
+}
+
+// Returns true if the dependency will signal the dependent when it finishes
+static bool LinkDependency(TaskImpl* impl, TaskImpl* dep, bool wait) {
+    assert(dep->dependent == TASK_INDEX_NONE && "Task is already a dependency of another task");
+    assert(dep->dependency_next == TASK_INDEX_NONE);
+
+    i32 task_index = GetTaskIndex(impl);
+    dep->dependent = task_index;
+    dep->dependency_next = impl->dependency_head;
+    impl->dependency_head = GetTaskIndex(dep);
+    impl->dependency_count++;
+
+    if (!wait)
+        return false;
+
+    i32 expected = TASK_INDEX_NONE;
+    return dep->dependent_signal.compare_exchange_strong(expected, task_index);
+}
+
+static bool HasActiveDependents(TaskImpl* impl) {
+    if (impl->dependent == TASK_INDEX_NONE) return false;
+    TaskImpl* dependent = &g_tasks.tasks[impl->dependent];
+    return dependent->state.load() != TASK_STATE_FREE;
+}
+
+static void ClearDependencyChain(TaskImpl* impl) {
+    i32 task_index = GetTaskIndex(impl);
+    i32 dep_idx = impl->dependency_head;
+    while (dep_idx >= 0) {
+        TaskImpl& dep = g_tasks.tasks[dep_idx];
+        assert(dep.dependent == task_index);
 
-            for (i32 dep_index=0; dep_index < dep_count; dep_index++) {
-                if (deps[dep_index].generation == 0) continue;
-                int dep_id = deps[dep_index].id;
-                TaskImpl& dep = g_tasks.tasks[dep_id];
-                assert(dep.dependent == -1 && "Task is already a dependency of another task");
-                assert(dep.dependency_next == -1);
+        // Stop the dependency from signaling a slot that is about to be reused
+        i32 expected = task_index;
+        if (!dep.dependent_signal.compare_exchange_strong(expected, TASK_INDEX_NONE))
+            while (dep.dependent_signal.load() == TASK_SIGNAL_BUSY)
+                ThreadYield();
 
-                dep.dependent = task_index;
-                dep.dependency_next = impl.dependency_head;
-                impl.dependency_head = dep_id;
-                impl.dependency_count++;
+        i32 next = dep.dependency_next;
+        dep.dependency_next = TASK_INDEX_NONE;
+        dep.dependent = TASK_INDEX_NONE;
+        dep_idx = next;
+    }
+
+    impl->dependency_head = TASK_INDEX_NONE;
+    impl->dependency_next = TASK_INDEX_NONE;
+    impl->dependency_count = 0;
+}
 
+// @run
+// Detached tasks have no handle, dependencies or callbacks so they skip the retire list
+static void FreeDetachedTask(TaskImpl* impl) {
+    impl->run_func = nullptr;
+    impl->generation = 0;
+    impl->busy.store(false);
+    impl->state.store(TASK_STATE_FREE);
+    g_tasks.active_count.fetch_sub(1);
+    FreeTask(impl);
+}
+
+static void RunTask(TaskImpl* impl) {
+    TaskState expected = TASK_STATE_PENDING;
+    if (impl->state.compare_exchange_strong(expected, TASK_STATE_RUNNING)) {
+#if defined(TASK_DEBUG)
+        impl->debug_start_time = GetRealTime();
+#endif
 #if defined(TASK_DEBUG_VERBOSE)
-                if (dep_index == 0)
-                    LogInfo("       DEPENDS  : %3d: %s", dep_id, dep.name);
-                else
-                    LogInfo("                : %3d: %s", dep_id, dep.name);
+        LogInfo("[TASK] RUN_BEGIN: %3d : 0x%llx: %s", GetTaskIndex(impl), GetThreadId(), impl->name);
 #endif
+        if (impl->run_func) {
+            try {
+                impl->result = impl->run_func(GetHandle(impl));
+            } catch (std::exception& e) {
+                LogInfo("[TASK] exception: %s", e.what());
+            } catch (...) {
+                LogInfo("[TASK] exception: ???");
             }
+        }
 
-#ifndef NDEBUG
-            // todo: validate the dependency chain
-            int validate_dep_id = impl.dependency_head;
-            int validate_dep_count = 0;
-            while (validate_dep_id != -1) {
-                TaskImpl& dep = g_tasks.tasks[validate_dep_id];
-                assert(dep.dependent == task_index);
-                validate_dep_id = dep.dependency_next;
-                validate_dep_count++;
-            }
-            assert(validate_dep_count == impl.dependency_count);
+#if defined(TASK_DEBUG)
+        impl->debug_end_time = GetRealTime();
+#endif
+#if defined(TASK_DEBUG_VERBOSE)
+        LogInfo(
+            "[TASK] RUN_END  : %3d : 0x%llx: %s (%dms)", GetTaskIndex(impl), GetThreadId(), impl->name,
+            static_cast<int>((impl->debug_end_time - impl->debug_start_time) * 1000.0f)
+        );
 #endif
+
+        expected = TASK_STATE_RUNNING;
+        if (impl->state.compare_exchange_strong(expected, TASK_STATE_COMPLETE)) {
+            if (impl->is_detached) {
+                FreeDetachedTask(impl);
+                return;
+            }
+
+            SignalDependent(impl);
+            FinishTask(impl);
         }
+    }
+
+    impl->busy.store(false);
+}
+
+// @create
+static TaskImpl* CreateTaskSlot(TaskQueueType type, TaskState state) {
+    TaskImpl* impl = AllocTask(type);
+    if (!impl)
+        return nullptr;
 
-        return {task_index, impl.generation};
+    u32 generation = g_tasks.next_generation.fetch_add(1) + 1;
+    if (generation == 0 || generation > INT32_MAX) {
+        g_tasks.next_generation.store(1);
+        generation = 1;
     }
 
-    return nullptr;
+    impl->generation = static_cast<int>(generation);
+    impl->result = nullptr;
+    impl->parent = nullptr;
+    impl->dependency_head = TASK_INDEX_NONE;
+    impl->dependency_next = TASK_INDEX_NONE;
+    impl->dependency_count = 0;
+    impl->dependent = TASK_INDEX_NONE;
+    impl->dependent_signal.store(TASK_INDEX_NONE);
+    impl->unfinished.store(1);
+    impl->busy.store(false);
+    impl->child_head = TASK_INDEX_NONE;
+    impl->child_prev = TASK_INDEX_NONE;
+    impl->child_next = TASK_INDEX_NONE;
+    impl->child_linked = false;
+    impl->is_virtual = false;
+    impl->is_frame_task = type == TASK_QUEUE_FRAME;
+    impl->is_detached = false;
+    impl->state.store(state);
+    g_tasks.active_count.fetch_add(1);
+
+    return impl;
 }
 
-static Task CreateVirtualTask(TaskDestroyFunc destroy_func, const char* name) {
+static void LinkDependencies(TaskImpl* impl, const Task* deps, i32 dep_count) {
+    for (i32 dep_index = 0; dep_index < dep_count; dep_index++) {
+        TaskImpl* dep = GetTask(deps[dep_index]);
+        if (!dep)
+            continue;
+
+        if (LinkDependency(impl, dep, true))
+            impl->unfinished.fetch_add(1);
+
+#if defined(TASK_DEBUG_VERBOSE)
+        if (dep_index == 0)
+            LogInfo("       DEPENDS  : %3d: %s", GetTaskIndex(dep), dep->name);
+        else
+            LogInfo("                : %3d: %s", GetTaskIndex(dep), dep->name);
+#endif
+    }
+}
+
+static Task CreateTaskInternal(
+    TaskRunFunc run_func,
+    TaskCompleteFunc complete_func,
+    TaskDestroyFunc destroy_func,
+    Task parent,
+    const Task* deps,
+    i32 dep_count,
+    const char* name
+) {
     (void) name;
 
-    std::lock_guard lock(g_tasks.mutex);
+    TaskImpl* impl = CreateTaskSlot(TASK_QUEUE_REGULAR, TASK_STATE_PENDING);
+    if (!impl)
+        return nullptr;
 
-    // Skip frame task reserved slots (start from max_frame_tasks)
-    for (i32 task_index = g_tasks.max_frame_tasks; task_index < g_tasks.max_tasks; task_index++) {
-        TaskImpl& task = g_tasks.tasks[task_index];
-        TaskState expected = TASK_STATE_FREE;
-        if (!task.state.compare_exchange_strong(expected, TASK_STATE_RUNNING))
-            continue;
+    impl->run_func = std::move(run_func);
+    impl->complete_func = std::move(complete_func);
+    impl->destroy_func = std::move(destroy_func);
+
+#if defined(TASK_DEBUG)
+    impl->debug_start_time = GetRealTime();
+    Set(impl->name, name);
+#endif
+#if defined(TASK_DEBUG_VERBOSE)
+    LogInfo("[TASK] QUEUED   : %3d: %s", GetTaskIndex(impl), impl->name);
+#endif
+
+    if (parent)
+        LinkChild(impl, parent);
 
-        task.generation = ++g_tasks.next_generation;
-        task.run_func = nullptr;
-        task.complete_func = nullptr;
-        task.destroy_func = std::move(destroy_func);
-        task.dependency_head = -1;
-        task.dependency_next = -1;
-        task.parent = nullptr;
-        task.result = nullptr;
-        task.start_frame = g_tasks.current_frame;
-        task.is_virtual = true;
-        task.is_frame_task = false;
-        task.frame_id = 0;
+    LinkDependencies(impl, deps, dep_count);
+
+    Task handle = GetHandle(impl);
+
+    // Release the creation guard, whoever drops the count to zero queues the task
+    if (impl->unfinished.fetch_sub(1) == 1)
+        ScheduleTask(impl);
+
+    return handle;
+}
+
+static Task CreateVirtualTask(TaskDestroyFunc destroy_func, Task parent, const char* name) {
+    (void) name;
+
+    TaskImpl* impl = CreateTaskSlot(TASK_QUEUE_REGULAR, TASK_STATE_RUNNING);
+    if (!impl)
+        return nullptr;
+
+    impl->run_func = nullptr;
+    impl->complete_func = nullptr;
+    impl->destroy_func = std::move(destroy_func);
+    impl->is_virtual = true;
 
 #if defined(TASK_DEBUG)
-        Set(task.name, name);
-        task.debug_queue_time = GetRealTime();
-        task.debug_start_time = task.debug_queue_time;
-        task.debug_end_time = task.debug_queue_time;
+    Set(impl->name, name);
+    impl->debug_queue_time = GetRealTime();
+    impl->debug_start_time = impl->debug_queue_time;
+    impl->debug_end_time = impl->debug_queue_time;
 #endif
 
-        return {task_index, task.generation};
-    }
+    if (parent)
+        LinkChild(impl, parent);
 
-    return nullptr;
+    return GetHandle(impl);
 }
 
 Task noz::CreateTask(const TaskConfig& config) {
-    Task result;
-
 #if defined(TASK_DEBUG)
     assert(config.name);
 #endif
@@ -228,23 +613,20 @@ Task noz::CreateTask(const TaskConfig& config) {
         return TASK_NULL;
 
     if (config.run)
-        result = CreateTaskInternal(
+        return CreateTaskInternal(
             config.run,
             config.complete,
             config.destroy,
+            config.parent,
             config.dependencies,
             config.dependency_count,
             config.name
         );
-    else
-        result = CreateVirtualTask(
-            config.destroy,
-            config.name);
-
-    if (result && config.parent)
-        SetParent(result, config.parent);
 
-    return result;
+    return CreateVirtualTask(
+        config.destroy,
+        config.parent,
+        config.name);
 }
 
 Task noz::CreateFrameTask(const FrameTaskConfig& config) {
@@ -252,57 +634,32 @@ Task noz::CreateFrameTask(const FrameTaskConfig& config) {
     assert(config.name && "Frame tasks require a name in debug mode");
 #endif
 
-    std::lock_guard lock(g_tasks.mutex);
-
-    // Allocate from reserved frame task slots only (indices 0 to max_frame_tasks-1)
-    for (i32 task_index = 0; task_index < g_tasks.max_frame_tasks; task_index++) {
-        TaskImpl& impl = g_tasks.tasks[task_index];
-        TaskState expected = TASK_STATE_FREE;
-        if (!impl.state.compare_exchange_strong(expected, TASK_STATE_PENDING))
-            continue;
+    TaskImpl* impl = CreateTaskSlot(TASK_QUEUE_FRAME, TASK_STATE_PENDING);
+    if (!impl) {
+        // No free frame task slots - this is a programming error
+        LogError("[TASK] No free frame task slots! Increase max_frame_tasks (current: %d)", g_tasks.max_frame_tasks);
+        return TASK_NULL;
+    }
 
-        impl.generation = ++g_tasks.next_generation;
-        impl.run_func = config.run;
-        impl.complete_func = nullptr;  // Frame tasks have no completion callback
-        impl.destroy_func = config.destroy;
-        impl.parent = nullptr;
-        impl.result = nullptr;
-        impl.start_frame = g_tasks.current_frame;
-        impl.is_virtual = false;
-        impl.is_frame_task = true;
-        impl.frame_id = g_tasks.current_frame;
-        impl.dependent = -1;
-        impl.dependency_head = -1;
-        impl.dependency_next = -1;
-        impl.dependency_count = 0;
+    impl->run_func = config.run;
+    impl->complete_func = nullptr;  // Frame tasks have no completion callback
+    impl->destroy_func = config.destroy;
 
 #if defined(TASK_DEBUG)
-        impl.debug_queue_time = GetRealTime();
-        Set(impl.name, config.name);
+    impl->debug_queue_time = GetRealTime();
+    Set(impl->name, config.name);
 #endif
 
-        // Handle dependencies
-        if (config.dependency_count > 0 && config.dependencies) {
-            for (i32 dep_index = 0; dep_index < config.dependency_count; dep_index++) {
-                if (config.dependencies[dep_index].generation == 0) continue;
-                int dep_id = config.dependencies[dep_index].id;
-                TaskImpl& dep = g_tasks.tasks[dep_id];
-                assert(dep.dependent == -1 && "Task is already a dependency of another task");
-                dep.dependent = task_index;
-                dep.dependency_next = impl.dependency_head;
-                impl.dependency_head = dep_id;
-                impl.dependency_count++;
-            }
-        }
+    g_tasks.pending_frame_tasks.fetch_add(1);
 
-        g_tasks.pending_frame_tasks.fetch_add(1);
+    if (config.dependencies)
+        LinkDependencies(impl, config.dependencies, config.dependency_count);
 
-        return {task_index, impl.generation};
-    }
+    Task handle = GetHandle(impl);
+    if (impl->unfinished.fetch_sub(1) == 1)
+        ScheduleTask(impl);
 
-    // No free frame task slots - this is a programming error
-    LogError("[TASK] No free frame task slots! Increase max_frame_tasks (current: %d)", g_tasks.max_frame_tasks);
-    return TASK_NULL;
+    return handle;
 }
 
 bool noz::HasPendingFrameTasks() {
@@ -317,67 +674,13 @@ void noz::WaitForFrameTasks() {
     f64 wait_start = GetRealTime();
 #endif
 
-    u64 target_frame = g_tasks.current_frame;
-
-    while (true) {
-        // Check if all frame tasks for this frame are done
-        bool all_done = true;
-        for (i32 i = 0; i < g_tasks.max_frame_tasks; i++) {
-            TaskImpl& impl = g_tasks.tasks[i];
-            if (!impl.is_frame_task || impl.frame_id != target_frame)
-                continue;
-
-            TaskState state = impl.state.load();
-            if (state == TASK_STATE_PENDING || state == TASK_STATE_RUNNING) {
-                all_done = false;
-                break;
-            }
-        }
-
-        if (all_done)
-            break;
-
-        // Try to help execute pending frame tasks on main thread
-        TaskImpl* pending = nullptr;
-        {
-            std::lock_guard lock(g_tasks.mutex);
-            for (i32 i = 0; i < g_tasks.max_frame_tasks; i++) {
-                TaskImpl& impl = g_tasks.tasks[i];
-                if (impl.is_frame_task && impl.frame_id == target_frame &&
-                    impl.state.load() == TASK_STATE_PENDING &&
-                    AreAllDependenciesReady(impl)) {
-                    TaskState expected = TASK_STATE_PENDING;
-                    if (impl.state.compare_exchange_strong(expected, TASK_STATE_RUNNING)) {
-                        pending = &impl;
-                        break;
-                    }
-                }
-            }
-        }
-
-        if (pending) {
-            // Execute on main thread
-#if defined(TASK_DEBUG)
-            pending->debug_start_time = GetRealTime();
-#endif
-            if (pending->run_func) {
-                try {
-                    pending->result = pending->run_func(GetHandle(pending));
-                } catch (std::exception& e) {
-                    LogInfo("[TASK] exception: %s", e.what());
-                } catch (...) {
-                    LogInfo("[TASK] exception: ???");
-                }
-            }
-#if defined(TASK_DEBUG)
-            pending->debug_end_time = GetRealTime();
-#endif
-            pending->state.store(TASK_STATE_COMPLETE);
-            g_tasks.pending_frame_tasks.fetch_sub(1);
-            g_tasks.tasks_completed.store(true);
-        } else {
+    // Help execute frame tasks on the calling thread while waiting
+    while (g_tasks.pending_frame_tasks.load() > 0) {
+        TaskImpl* impl = t_queue_owner != TASK_INDEX_NONE ? TakeQueuedTask(t_queue_owner, true) : nullptr;
+        if (impl)
+            RunTask(impl);
+        else
             ThreadYield();
-        }
     }
 
 #if defined(TASK_DEBUG)
@@ -389,69 +692,49 @@ void noz::WaitForFrameTasks() {
 }
 
 bool noz::HasPendingTasks() {
-    for (i32 i = 0; i < g_tasks.max_tasks; i++) {
-        TaskState state = g_tasks.tasks[i].state.load();
-        if (state == TASK_STATE_PENDING || state == TASK_STATE_RUNNING)
-            return true;
-    }
-    return false;
+    return g_tasks.active_count.load() > 0;
 }
 
 void noz::WaitForAllTasks() {
     while (HasPendingTasks()) {
         UpdateTasks();
-        ThreadYield();
+
+        TaskImpl* impl = t_queue_owner != TASK_INDEX_NONE ? TakeQueuedTask(t_queue_owner, false) : nullptr;
+        if (impl)
+            RunTask(impl);
+        else
+            ThreadYield();
     }
 }
 
 void noz::Complete(Task task, void* result) {
-    if (task.generation == 0)
-        return;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     if (!impl || !impl->is_virtual)
         return;
 
     impl->result = result;
-    impl->state.store(TASK_STATE_COMPLETE);
-    g_tasks.tasks_completed.store(true);
+
+    TaskState expected = TASK_STATE_RUNNING;
+    if (!impl->state.compare_exchange_strong(expected, TASK_STATE_COMPLETE))
+        return;
 
 #if defined(TASK_DEBUG)
     impl->debug_start_time = impl->debug_end_time = GetRealTime();
 #endif
 
-#if defined(TASK_DEBUG)
-    LogInfo(
-        "[TASK] COMPLETE : %3d: %s (total_time=%dms  run_time=%dms  queue_time=%dms)",
-        GetTaskIndex(impl),
-        impl->name,
-        GetMilliseconds(GetRealTime() - impl->debug_queue_time),
-        GetMilliseconds(impl->debug_end_time - impl->debug_start_time),
-        GetMilliseconds(impl->debug_start_time - impl->debug_queue_time)
-    );
-#endif
+    SignalDependent(impl);
+    FinishTask(impl);
 }
 
 void* noz::GetResult(Task task) {
-    if (task.generation == 0)
-        return nullptr;
-
-    if (task.id >= g_tasks.max_tasks)
-        return nullptr;
-
-    TaskImpl& impl = g_tasks.tasks[task.id];
-    if (impl.generation != task.generation)
+    TaskImpl* impl = GetTask(task);
+    if (!impl)
         return nullptr;
 
-    return impl.result;
+    return impl->result;
 }
 
 void* noz::ReleaseResult(Task task) {
-    if (task.generation == 0)
-        return nullptr;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     if (!impl)
         return nullptr;
@@ -486,9 +769,6 @@ Task noz::GetDependencyAt(Task task, int index) {
 }
 
 Task noz::GetParent(Task task) {
-    if (task.generation == 0)
-        return nullptr;
-
     TaskImpl* impl = GetTask(task);
     if (!impl)
         return nullptr;
@@ -497,28 +777,16 @@ Task noz::GetParent(Task task) {
 }
 
 void noz::SetParent(Task task, Task parent) {
-    if (task.generation == 0)
-        return;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     if (impl)
-        impl->parent = parent;
+        LinkChild(impl, parent);
 }
 
 bool noz::IsValid(Task task) {
-    if (task.generation == 0)
-        return false;
-
-    std::lock_guard lock(g_tasks.mutex);
     return GetTask(task) != nullptr;
 }
 
 bool noz::IsComplete(Task task) {
-    if (task.generation == 0)
-        return true;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     if (!impl)
         return true;
@@ -528,142 +796,26 @@ bool noz::IsComplete(Task task) {
 }
 
 bool noz::IsCancelled(Task task) {
-    if (task.generation == 0)
-        return true;
-
-    if (task.id >= g_tasks.max_tasks)
-        return true;
-
-    // No lock - this is called frequently from worker thread
-    TaskImpl& impl = g_tasks.tasks[task.id];
-    if (impl.generation != task.generation)
+    TaskImpl* impl = GetTask(task);
+    if (!impl)
         return true;
 
-    if (impl.state.load() == TASK_STATE_CANCELED)
+    if (impl->state.load() == TASK_STATE_CANCELED)
         return true;
 
     // Check parent chain - if parent is cancelled, we're cancelled too
-    if (impl.parent)
-        return IsCancelled(impl.parent);
+    if (impl->parent)
+        return IsCancelled(impl->parent);
 
     return false;
 }
 
 void noz::Cancel(Task task) {
-    if (!IsValid(task))
-        return;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     if (!impl)
         return;
 
-    TaskState expected = TASK_STATE_PENDING;
-    if (impl->state.compare_exchange_strong(expected, TASK_STATE_CANCELED))
-        return;
-
-    expected = TASK_STATE_RUNNING;
-    impl->state.compare_exchange_strong(expected, TASK_STATE_CANCELED);
-}
-
-static bool AreAllDependenciesReady(TaskImpl& impl) {
-    i32 dependency_index = impl.dependency_head;
-    while (dependency_index >= 0) {
-        TaskImpl& dep = g_tasks.tasks[dependency_index];
-        assert(dep.dependent == GetTaskIndex(&impl));
-        TaskState dep_state = dep.state.load();
-        if (dep_state != TASK_STATE_COMPLETE && dep_state != TASK_STATE_WAIT_DEPENDENT) return false;
-        dependency_index = dep.dependency_next;
-    }
-    return true;
-}
-
-static TaskImpl* FindOldestPendingTask() {
-    // Priority 1: Frame tasks from current frame (always scheduled first)
-    for (i32 i = 0; i < g_tasks.max_frame_tasks; i++) {
-        TaskImpl& impl = g_tasks.tasks[i];
-        if (impl.state.load() == TASK_STATE_PENDING &&
-            impl.is_frame_task &&
-            impl.frame_id == g_tasks.current_frame) {
-            if (AreAllDependenciesReady(impl))
-                return &impl;
-        }
-    }
-
-    // Priority 2: Regular tasks (oldest first, skip frame task reserved slots)
-    TaskImpl* oldest = nullptr;
-    u64 oldest_frame = UINT64_MAX;
-
-    for (i32 i = g_tasks.max_frame_tasks; i < g_tasks.max_tasks; i++) {
-        TaskImpl& impl = g_tasks.tasks[i];
-        if (impl.state.load() == TASK_STATE_PENDING) {
-            if (!AreAllDependenciesReady(impl)) continue;
-
-            if (impl.start_frame < oldest_frame) {
-                oldest_frame = impl.start_frame;
-                oldest = &impl;
-            }
-        }
-    }
-
-    return oldest;
-}
-
-static TaskWorker* FindIdleWorker() {
-    for (i32 i = 0; i < g_tasks.worker_count; i++) {
-        TaskWorker& worker = g_tasks.workers[i];
-        if (worker.current_task.load() == nullptr)
-            return &worker;
-    }
-    return nullptr;
-}
-
-static bool HasActiveDependents(TaskImpl* impl) {
-    if (impl->dependent == -1) return false;
-    TaskImpl* dependent = &g_tasks.tasks[impl->dependent];
-    return dependent->state.load() != TASK_STATE_FREE;
-}
-
-static void ClearDependencyChain(TaskImpl* impl) {
-    i32 dep_idx = impl->dependency_head;
-    while (dep_idx >= 0) {
-        TaskImpl& dep = g_tasks.tasks[dep_idx];
-        assert(dep.dependent == GetTaskIndex(impl));
-        i32 next = dep.dependency_next;
-        dep.dependency_next = -1;
-        dep.dependent = -1;
-        dep_idx = next;
-    }
-
-    impl->dependency_head = -1;
-    impl->dependency_next = -1;
-    impl->dependency_count = 0;
-}
-
-// Cancel all children of a task (called when parent is cancelled)
-static void CancelChildren(Task handle) {
-    for (i32 i = 0; i < g_tasks.max_tasks; i++) {
-        TaskImpl& task = g_tasks.tasks[i];
-        if (task.parent.id != handle.id || task.parent.generation != handle.generation)
-            continue;
-
-        TaskState state = task.state.load();
-        if (state == TASK_STATE_PENDING) {
-            task.state.store(TASK_STATE_CANCELED);
-        } else if (state == TASK_STATE_RUNNING) {
-            task.state.store(TASK_STATE_CANCELED);
-        }
-        task.parent = nullptr;
-    }
-}
-
-static void ClearChildrenParent(TaskImpl* impl) {
-    int task_index = GetTaskIndex(impl);
-    for (i32 i = 0; i < g_tasks.max_tasks; i++) {
-        TaskImpl& task = g_tasks.tasks[i];
-        if (task.parent.id == task_index && task.parent.generation == impl->generation)
-            task.parent = nullptr;
-    }
+    CancelTaskState(impl);
 }
 
 #if defined(TASK_DEBUG_VERBOSE)
@@ -681,9 +833,10 @@ static const char* GetStateName(TaskImpl& impl) {
 #endif
 
 static void DestroyTask(TaskImpl* impl) {
-    ClearChildrenParent(impl);
+    // Propagate cancellation to children, otherwise just detach them
+    ReleaseChildren(impl, impl->state.load() == TASK_STATE_CANCELED);
+    UnlinkChild(impl);
 
-    // Call destructor before freeing
     if (impl->destroy_func) {
 #if defined(TASK_DEBUG_VERBOSE)
         LogInfo("[TASK] DESTROY: %s: %3d: %s", GetStateName(*impl), GetTaskIndex(impl), impl->name);
@@ -703,137 +856,81 @@ static void DestroyTask(TaskImpl* impl) {
     impl->complete_func = nullptr;
     impl->destroy_func = nullptr;
     impl->result = nullptr;
-    impl->dependency_head = -1;
-    impl->dependency_next = -1;
-    impl->dependent = -1;
-    impl->generation = 0;
+    impl->parent = nullptr;
+    impl->dependent = TASK_INDEX_NONE;
     impl->state.store(TASK_STATE_FREE);
+    FreeTask(impl);
 }
 
 void noz::UpdateTasks() {
-    // Clean up previous frame's completed frame tasks before incrementing frame
-    for (i32 i = 0; i < g_tasks.max_frame_tasks; i++) {
-        TaskImpl& impl = g_tasks.tasks[i];
-        if (impl.is_frame_task &&
-            impl.frame_id < g_tasks.current_frame &&
-            impl.state.load() == TASK_STATE_COMPLETE) {
-            DestroyTask(&impl);
-        }
+    // Take the retired list and flip it so callbacks run in completion order
+    i32 task_index = g_tasks.retired.exchange(TASK_INDEX_NONE, std::memory_order_acquire);
+    i32 ordered = TASK_INDEX_NONE;
+    while (task_index != TASK_INDEX_NONE) {
+        TaskImpl& impl = g_tasks.tasks[task_index];
+        i32 next = impl.next_retired;
+        impl.next_retired = ordered;
+        ordered = task_index;
+        task_index = next;
     }
 
-    g_tasks.current_frame++;
-
-#if defined(TASK_DEBUG_VERBOSE)
-    static u64 debug_print_frame = 0;
-    debug_print_frame++;
-    bool should_print = (debug_print_frame % 300) == 0;
-#endif
-
-    if (g_tasks.tasks_completed.exchange(false)) {
-        for (i32 task_index=0; task_index < g_tasks.max_tasks; task_index++) {
-            TaskImpl& impl = g_tasks.tasks[task_index];
-            TaskState state = impl.state.load();
-
-            if (state == TASK_STATE_COMPLETE) {
-                Task handle = GetHandle(&impl);
-
-#if defined(TASK_DEBUG_VERBOSE)
-                f64 elapsed_time = GetRealTime() - impl.debug_start_time;
-                LogInfo("[TASK] DONE     : %3d: %s (%dms)",
-                    task_index,
-                    impl.name,
-                    static_cast<int>(elapsed_time * 1000.0f)
-                );
-#endif
-
-                if (impl.complete_func) {
-                    try {
-                        impl.complete_func(handle, impl.result);
-                    } catch (std::exception& e) {
-                        LogInfo("[TASK] exception: %s", e.what());
-                    } catch (...) {
-                        LogInfo("[TASK] exception: ???");
-                    }
-                }
+    for (task_index = ordered; task_index != TASK_INDEX_NONE; ) {
+        TaskImpl& impl = g_tasks.tasks[task_index];
+        i32 next = impl.next_retired;
 
+        if (impl.state.load() == TASK_STATE_COMPLETE) {
 #if defined(TASK_DEBUG)
-                LogInfo(
-                    "[TASK] COMPLETE : %3d: %s (total_time=%dms  run_time=%dms  queue_time=%dms)",
-                    GetTaskIndex(&impl),
-                    impl.name,
-                    GetMilliseconds(GetRealTime() - impl.debug_queue_time),
-                    GetMilliseconds(impl.debug_end_time - impl.debug_start_time),
-                    GetMilliseconds(impl.debug_start_time - impl.debug_queue_time)
-                );
+            LogInfo(
+                "[TASK] COMPLETE : %3d: %s (total_time=%dms  run_time=%dms  queue_time=%dms)",
+                task_index,
+                impl.name,
+                GetMilliseconds(GetRealTime() - impl.debug_queue_time),
+                GetMilliseconds(impl.debug_end_time - impl.debug_start_time),
+                GetMilliseconds(impl.debug_start_time - impl.debug_queue_time)
+            );
 #endif
 
-                if (HasActiveDependents(&impl)) {
-                    impl.state.store(TASK_STATE_WAIT_DEPENDENT);
-                    continue;
+            if (impl.complete_func) {
+                try {
+                    impl.complete_func(GetHandle(&impl), impl.result);
+                } catch (std::exception& e) {
+                    LogInfo("[TASK] exception: %s", e.what());
+                } catch (...) {
+                    LogInfo("[TASK] exception: ???");
                 }
-
-                DestroyTask(&impl);
-
-            } else if (state == TASK_STATE_CANCELED) {
-                Task handle = GetHandle(&impl);
-
-                if (HasActiveDependents(&impl))
-                    continue;
-
-                // Propagate cancellation to children before freeing
-                CancelChildren(handle);
-
-                DestroyTask(&impl);
             }
-        }
-    }
 
-    // Always check WAIT_DEPENDENT tasks - they need cleanup even when no new tasks complete
-    // This fixes a bug where WAIT_DEPENDENT tasks could get stuck if their dependent was
-    // destroyed but no other tasks completed in subsequent frames
-    for (i32 task_index=0; task_index < g_tasks.max_tasks; task_index++) {
-        TaskImpl& impl = g_tasks.tasks[task_index];
-        if (impl.state.load() == TASK_STATE_WAIT_DEPENDENT) {
-            if (!HasActiveDependents(&impl)) {
-                DestroyTask(&impl);
-            }
+            impl.state.store(TASK_STATE_WAIT_DEPENDENT);
         }
-    }
-
-    // Assign pending tasks to idle workers
-    std::lock_guard lock(g_tasks.mutex);
 
-    while (true) {
-        TaskWorker* worker = FindIdleWorker();
-        if (!worker)
-            break;
+        assert(g_tasks.retained_count < g_tasks.max_tasks);
+        g_tasks.retained[g_tasks.retained_count++] = task_index;
+        task_index = next;
+    }
 
-        TaskImpl* task = FindOldestPendingTask();
-        if (!task)
-            break;
+    // Finished tasks stay around while a worker still holds them or their dependent is alive,
+    // destroying a dependent can release its dependencies so sweep until nothing changes.
+    for (bool destroyed = true; destroyed; ) {
+        destroyed = false;
+        for (i32 i = 0; i < g_tasks.retained_count; ) {
+            TaskImpl& impl = g_tasks.tasks[g_tasks.retained[i]];
+            if (impl.busy.load() || HasActiveDependents(&impl)) {
+                i++;
+                continue;
+            }
 
-        task->state.store(TASK_STATE_RUNNING);
-        worker->current_task.store(task);
-        worker->cv.notify_one();
+            DestroyTask(&impl);
+            g_tasks.retained[i] = g_tasks.retained[--g_tasks.retained_count];
+            destroyed = true;
+        }
     }
 
 #if defined(TASK_DEBUG_VERBOSE)
-    if (should_print) {
-        int pending_count = 0;
-        int running_count = 0;
-        int wait_dependent = 0;
-        for (i32 i = 0; i < g_tasks.max_tasks; i++) {
-            TaskImpl& task = g_tasks.tasks[i];
-            if (task.state == TASK_STATE_PENDING)
-                pending_count++;
-            else if (task.state == TASK_STATE_RUNNING)
-                running_count++;
-            else if (task.state == TASK_STATE_WAIT_DEPENDENT)
-                wait_dependent++;
-        }
-
-        LogInfo("[TASK] UPDATE   : running=%d  pending=%d", running_count, pending_count);
-        for (i32 task_index=0; task_index < g_tasks.max_tasks; task_index++) {
+    static u64 debug_print_frame = 0;
+    debug_print_frame++;
+    if ((debug_print_frame % 300) == 0) {
+        LogInfo("[TASK] UPDATE   : active=%d  queued=%d", g_tasks.active_count.load(), g_tasks.queued_count.load());
+        for (task_index=0; task_index < g_tasks.max_tasks; task_index++) {
             TaskImpl& impl = g_tasks.tasks[task_index];
             if (impl.state == TASK_STATE_FREE)
                 continue;
@@ -860,82 +957,29 @@ void noz::UpdateTasks() {
 #endif
 }
 
-static void WorkerProc(TaskWorker* worker, int worker_index) {
+static void WorkerProc(int worker_index) {
     char name[32];
     snprintf(name, sizeof(name), "task_worker_%d", worker_index);
     SetThreadName(name);
 
-    worker->running = true;
-
-    while (worker->running) {
-        TaskImpl* impl = nullptr;
+    t_queue_owner = worker_index;
 
-        {
-            std::unique_lock lock(worker->cv_mutex);
-            worker->cv.wait(lock, [worker] { return worker->current_task.load() != nullptr || !worker->running; });
-
-            if (!worker->running)
-                break;
-
-            impl = worker->current_task.load();
+    while (g_tasks.running) {
+        TaskImpl* impl = TakeQueuedTask(worker_index, false);
+        for (i32 spin = 0; !impl && spin < TASK_SPIN_COUNT && g_tasks.running; spin++) {
+            ThreadYield();
+            impl = TakeQueuedTask(worker_index, false);
         }
 
         if (impl) {
-#if defined(TASK_DEBUG_VERBOSE)
-            LogInfo("[TASK] WORKER_WORK: %s: %3d : %s", name, GetTaskIndex(impl), impl->name);
-#endif
-
-            TaskState expected = TASK_STATE_RUNNING;
-            if (impl->state.load() == expected && impl->run_func) {
-#if defined (TASK_DEBUG)
-                impl->debug_start_time = GetRealTime();
-#endif
-#if defined(TASK_DEBUG_VERBOSE)
-                LogInfo("[TASK] RUN_BEGIN: %3d : 0x%llx: %s", GetTaskIndex(impl), GetThreadId(), impl->name);
-#endif
-                try {
-                    impl->result = impl->run_func(GetHandle(impl));
-                } catch (std::exception& e) {
-                    LogInfo("[TASK] exception: %s", e.what());
-                } catch (...) {
-                    LogInfo("[TASK] exception: ???");
-                }
-
-#if defined(TASK_DEBUG)
-                impl->debug_end_time = GetRealTime();
-#endif
-#if defined(TASK_DEBUG_VERBOSE)
-                LogInfo(
-                    "[TASK] RUN_END  : %3d : 0x%llx: %s (%dms)", GetTaskIndex(impl), GetThreadId(), impl->name,
-                    static_cast<int>((impl->debug_end_time - impl->debug_start_time) * 1000.0f)
-                );
-#endif
-            } else {
-#if defined(TASK_DEBUG)
-                impl->debug_start_time = GetRealTime();
-                impl->debug_end_time = impl->debug_start_time;
-#endif
-            }
-
-            expected = TASK_STATE_RUNNING;
-            if (impl->state.compare_exchange_strong(expected, TASK_STATE_COMPLETE)) {
-                g_tasks.tasks_completed.store(true);
-                // Decrement frame task counter if this was a frame task
-                if (impl->is_frame_task) {
-                    g_tasks.pending_frame_tasks.fetch_sub(1);
-                }
-            }
-
-#if defined(TASK_DEBUG_VERBOSE)
-            LogInfo("[TASK] WORKER_DONE: %s: %3d : %s", name, GetTaskIndex(impl), impl->name);
-#endif
-        } else {
-#if defined(TASK_DEBUG_VERBOSE)
-            LogInfo("[TASK] WORKER_WORK: nullptr");
-#endif
+            RunTask(impl);
+            continue;
         }
 
-        worker->current_task.store(nullptr);
+        std::unique_lock lock(g_tasks.sleep_mutex);
+        g_tasks.sleeping_count.fetch_add(1);
+        g_tasks.sleep_cv.wait(lock, [] { return g_tasks.queued_count.load() > 0 || !g_tasks.running; });
+        g_tasks.sleeping_count.fetch_sub(1);
     }
 }
 
@@ -951,40 +995,53 @@ void noz::InitTasks(const ApplicationTraits& traits) {
     g_tasks.max_tasks = max_tasks;
     g_tasks.max_frame_tasks = max_frame_tasks;
     g_tasks.tasks = new TaskImpl[max_tasks];
+    g_tasks.retained = new i32[max_tasks];
+    g_tasks.retained_count = 0;
+    g_tasks.inject = new i32[max_tasks];
+    g_tasks.inject_head = 0;
+    g_tasks.inject_count = 0;
     g_tasks.worker_count = worker_count;
-    g_tasks.workers = new TaskWorker[worker_count];
+    g_tasks.workers = new TaskWorker[worker_count + 1];
     g_tasks.running = true;
-    g_tasks.current_frame = 0;
     g_tasks.next_generation = 0;
     g_tasks.pending_frame_tasks = 0;
+    g_tasks.active_count = 0;
+    g_tasks.queued_count = 0;
+    g_tasks.retired = TASK_INDEX_NONE;
 
+    // Frame tasks use the reserved slots [0, max_frame_tasks), regular tasks the rest
     for (i32 i = 0; i < max_tasks; i++) {
         TaskImpl& impl = g_tasks.tasks[i];
-        impl.state = TASK_STATE_FREE;
         impl.generation = 0;
-        impl.destroy_func = nullptr;
         impl.dependency_count = 0;
-        impl.dependency_head = -1;
-        impl.dependency_next = -1;
-        impl.dependent = -1;
-        impl.is_frame_task = false;
-        impl.frame_id = 0;
+        impl.dependency_head = TASK_INDEX_NONE;
+        impl.dependency_next = TASK_INDEX_NONE;
+        impl.dependent = TASK_INDEX_NONE;
+        impl.child_head = TASK_INDEX_NONE;
+        impl.is_frame_task = i < max_frame_tasks;
+        impl.next_free = (i + 1 == max_frame_tasks || i + 1 == max_tasks) ? TASK_INDEX_NONE : i + 1;
     }
 
-    for (i32 i = 0; i < worker_count; i++) {
-        g_tasks.workers[i].running = false;
-        g_tasks.workers[i].current_task = nullptr;
-        g_tasks.workers[i].thread = std::thread(WorkerProc, &g_tasks.workers[i], i);
+    g_tasks.free_list[TASK_QUEUE_FRAME] = static_cast<u32>(max_frame_tasks > 0 ? 0 : TASK_INDEX_NONE);
+    g_tasks.free_list[TASK_QUEUE_REGULAR] = static_cast<u32>(max_frame_tasks < max_tasks ? max_frame_tasks : TASK_INDEX_NONE);
+
+    for (i32 i = 0; i <= worker_count; i++) {
+        InitQueue(g_tasks.workers[i].queues[TASK_QUEUE_FRAME], max_tasks);
+        InitQueue(g_tasks.workers[i].queues[TASK_QUEUE_REGULAR], max_tasks - max_frame_tasks);
     }
+
+    // The main thread owns the last queue
+    t_queue_owner = worker_count;
+
+    for (i32 i = 0; i < worker_count; i++)
+        g_tasks.workers[i].thread = std::thread(WorkerProc, i);
 }
 
 void noz::ShutdownTasks() {
-    g_tasks.running = false;
-
-    for (i32 i = 0; i < g_tasks.worker_count; i++) {
-        TaskWorker& worker = g_tasks.workers[i];
-        worker.running = false;
-        worker.cv.notify_one();
+    {
+        std::lock_guard lock(g_tasks.sleep_mutex);
+        g_tasks.running = false;
+        g_tasks.sleep_cv.notify_all();
     }
 
     for (i32 i = 0; i < g_tasks.worker_count; i++) {
@@ -992,28 +1049,124 @@ void noz::ShutdownTasks() {
             g_tasks.workers[i].thread.join();
     }
 
+    for (i32 i = 0; i <= g_tasks.worker_count; i++)
+        for (TaskQueue& queue : g_tasks.workers[i].queues)
+            delete[] queue.items;
+
+    t_queue_owner = TASK_INDEX_NONE;
+
     delete[] g_tasks.workers;
     g_tasks.workers = nullptr;
 
     delete[] g_tasks.tasks;
     g_tasks.tasks = nullptr;
 
+    delete[] g_tasks.retained;
+    g_tasks.retained = nullptr;
+
+    delete[] g_tasks.inject;
+    g_tasks.inject = nullptr;
+
     LogInfo("Task system shutdown");
 }
 
 void noz::AddDependency(Task task, Task dependency) {
-    if (!IsValid(task))
-        return;
-
-    std::lock_guard lock(g_tasks.mutex);
     TaskImpl* impl = GetTask(task);
     TaskImpl* dep = GetTask(dependency);
     if (!impl || !dep)
         return;
 
-    assert(dep->dependency_next == -1 && "Task is already a dependency of another task");
-    dep->dependency_next = impl->dependency_head;
-    dep->dependent = task.id;
-    impl->dependency_head = dependency.id;
-    impl->dependency_count++;
+    // Only holds the task back if it has not been queued yet
+    i32 unfinished = impl->unfinished.load();
+    while (unfinished > 0 && !impl->unfinished.compare_exchange_weak(unfinished, unfinished + 1)) {}
+
+    bool counted = unfinished > 0;
+    if (!LinkDependency(impl, dep, counted) && counted && impl->unfinished.fetch_sub(1) == 1)
+        ScheduleTask(impl);
+}
+
+// @parallel
+struct ParallelJob {
+    const ParallelForFunc* func;
+    i32 begin;
+    i32 end;
+    i32 grain;
+    i32 chunk_count;
+    std::atomic<i32> next_chunk{0};
+    std::atomic<i32> remaining{0};
+    std::atomic<i32> refs{1};           // caller + helpers that may still touch the job
+};
+
+static void ReleaseParallelJob(ParallelJob* job) {
+    if (job->refs.fetch_sub(1) == 1)
+        delete job;
+}
+
+static void RunParallelChunks(ParallelJob* job) {
+    while (true) {
+        i32 chunk = job->next_chunk.fetch_add(1);
+        if (chunk >= job->chunk_count)
+            return;
+
+        i32 chunk_begin = job->begin + chunk * job->grain;
+        i32 chunk_end = Min(chunk_begin + job->grain, job->end);
+        (*job->func)(chunk_begin, chunk_end);
+        job->remaining.fetch_sub(1);
+    }
+}
+
+void noz::ParallelFor(int begin, int end, int grain, const ParallelForFunc& func) {
+    if (end <= begin)
+        return;
+
+    grain = Max(grain, 1);
+    i32 chunk_count = (end - begin + grain - 1) / grain;
+    if (chunk_count == 1 || g_tasks.worker_count == 0 || !g_tasks.running) {
+        for (i32 chunk_begin = begin; chunk_begin < end; chunk_begin += grain)
+            func(chunk_begin, Min(chunk_begin + grain, end));
+        return;
+    }
+
+    ParallelJob* job = new ParallelJob;
+    job->func = &func;
+    job->begin = begin;
+    job->end = end;
+    job->grain = grain;
+    job->chunk_count = chunk_count;
+    job->remaining = chunk_count;
+
+    // Helpers that start after the range is exhausted just drop their reference
+    i32 helper_count = Min(chunk_count - 1, g_tasks.worker_count);
+    for (i32 i = 0; i < helper_count; i++) {
+        TaskImpl* impl = CreateTaskSlot(TASK_QUEUE_REGULAR, TASK_STATE_PENDING);
+        if (!impl)
+            break;
+
+        job->refs.fetch_add(1);
+        impl->is_detached = true;
+        impl->run_func = [job](Task) -> void* {
+            RunParallelChunks(job);
+            ReleaseParallelJob(job);
+            return TASK_NO_RESULT;
+        };
+
+#if defined(TASK_DEBUG)
+        Set(impl->name, "parallel_for");
+#endif
+
+        impl->unfinished.store(0);
+        ScheduleTask(impl);
+    }
+
+    RunParallelChunks(job);
+
+    while (job->remaining.load() > 0) {
+        TaskImpl* impl = t_queue_owner != TASK_INDEX_NONE ? TakeQueuedTask(t_queue_owner, true) : nullptr;
+        if (impl)
+            RunTask(impl);
+        else
+            ThreadYield();
+    }
+
+    ReleaseParallelJob(job);
 }
@@ -54,6 +54,18 @@ Bounds2 MeasureText(const Text& text, Font* font, float font_size, int start, in
     return Bounds2{Vec2{xmin, 0.0f}, Vec2{xmax, GetLineHeight(font) * font_size}};
 }
 
+static noz::Rect GetGlyphRect(const FontGlyph* glyph, float x, float y, float scale) {
+    // Y increases downward, so the rect y is the TOP of the glyph
+    // bearing.y is distance from baseline to glyph bottom
+    // To align baseline at y, glyph top should be at: y + bearing.y - glyph_height
+    return {
+        x + glyph->bearing.x * scale,
+        y + glyph->bearing.y * scale - glyph->size.y * scale,
+        glyph->size.x * scale,
+        glyph->size.y * scale
+    };
+}
+
 static void AddGlyph(
     MeshBuilder* builder,
     const FontGlyph* glyph,
@@ -61,19 +73,13 @@ static void AddGlyph(
     float y,
     float scale,
     int& vertex_offset) {
-    auto glyph_x = x + glyph->bearing.x * scale;
-    // Y increases downward, so glyph_y is the TOP of the glyph
-    // bearing.y is distance from baseline to glyph bottom
-    // To align baseline at y, glyph top should be at: y + bearing.y - glyph_height
-    auto glyph_y = y + glyph->bearing.y * scale - glyph->size.y * scale;
-    auto glyph_width = glyph->size.x * scale;
-    auto glyph_height = glyph->size.y * scale;
+    noz::Rect r = GetGlyphRect(glyph, x, y, scale);
 
     // Add vertices for this glyph quad
-    AddVertex(builder, Vec2{glyph_x, glyph_y}, {glyph->uv_min.x, glyph->uv_min.y});
-    AddVertex(builder, Vec2{glyph_x + glyph_width, glyph_y}, {glyph->uv_max.x, glyph->uv_min.y});
-    AddVertex(builder, Vec2{glyph_x + glyph_width, glyph_y + glyph_height}, {glyph->uv_max.x, glyph->uv_max.y});
-    AddVertex(builder, Vec2{glyph_x, glyph_y + glyph_height}, {glyph->uv_min.x, glyph->uv_max.y});
+    AddVertex(builder, Vec2{r.x, r.y}, {glyph->uv_min.x, glyph->uv_min.y});
+    AddVertex(builder, Vec2{r.x + r.width, r.y}, {glyph->uv_max.x, glyph->uv_min.y});
+    AddVertex(builder, Vec2{r.x + r.width, r.y + r.height}, {glyph->uv_max.x, glyph->uv_max.y});
+    AddVertex(builder, Vec2{r.x, r.y + r.height}, {glyph->uv_min.x, glyph->uv_max.y});
 
     // Add indices for this glyph quad
     AddTriangle(builder, (u16)vertex_offset, (u16)vertex_offset + 1, (u16)vertex_offset + 2);
@@ -82,7 +88,10 @@ static void AddGlyph(
     vertex_offset += 4;
 }
 
-static void CreateTextMesh(Allocator* allocator, TextMeshImpl* impl, const TextRequest& request) {
+// Walks the glyphs of a single line of text, calling add with each visible glyph and the pen
+// position on the baseline.  Returns the size of the text.
+template <typename AddGlyphFunc>
+static Vec2 LayoutText(const TextRequest& request, AddGlyphFunc add) {
     auto& text = request.text;
     float font_size = (float)request.font_size;
 
@@ -104,7 +113,6 @@ static void CreateTextMesh(Allocator* allocator, TextMeshImpl* impl, const TextR
 
     // Generate vertices for the text
     float current_x = 0.0f;
-    int vertex_offset = 0;
 
     // Position baseline within the line height bounds
     // The baseline should be positioned from the top of the text bounds
@@ -115,14 +123,13 @@ static void CreateTextMesh(Allocator* allocator, TextMeshImpl* impl, const TextR
     // if (!IsEmpty(text))
     //     current_x = -GetGlyph(request.font, text.value[0])->bearing.x * font_size;
 
-    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, (u16)text.length * 4, (u16)text.length * 6);
     for (size_t i = 0; i < text.length; ++i)
     {
         char ch = text.value[i];
         auto glyph = GetGlyph(request.font, ch);
 
         if (glyph->uv_max.x > glyph->uv_min.x && glyph->uv_max.y > glyph->uv_min.y)
-            AddGlyph(builder, glyph, current_x, baseline_y, font_size, vertex_offset);
+            add(glyph, current_x, baseline_y, font_size);
 
         current_x += glyph->advance * font_size;
 
@@ -131,12 +138,40 @@ static void CreateTextMesh(Allocator* allocator, TextMeshImpl* impl, const TextR
             current_x += GetKerning(request.font, ch, text.value[i + 1]) * font_size;
     }
 
-    // Create mesh from builder data
-    auto mesh = CreateMesh(allocator, builder, nullptr);
+    return { total_width, total_height };
+}
 
-    impl->mesh = mesh;
+static void CreateTextMesh(Allocator* allocator, TextMeshImpl* impl, const TextRequest& request) {
+    int vertex_offset = 0;
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, (u16)request.text.length * 4, (u16)request.text.length * 6);
+    Vec2 size = LayoutText(request, [builder, &vertex_offset](const FontGlyph* glyph, float x, float y, float scale) {
+        AddGlyph(builder, glyph, x, y, scale, vertex_offset);
+    });
+
+    // Create mesh from builder data
+    impl->mesh = CreateMesh(allocator, builder, nullptr);
     impl->material = GetMaterial(request.font);
-    impl->size = { total_width, total_height };
+    impl->size = size;
+}
+
+int BuildTextGlyphs(const TextRequest& request, GlyphVertex* vertices, Vec2* size) {
+    assert(request.font);
+    assert(vertices);
+
+    int quad_count = 0;
+    Vec2 text_size = LayoutText(request, [vertices, &quad_count](const FontGlyph* glyph, float x, float y, float scale) {
+        noz::Rect r = GetGlyphRect(glyph, x, y, scale);
+        GlyphVertex* v = vertices + quad_count++ * 4;
+        v[0] = { Vec2{r.x, r.y}, Vec2{glyph->uv_min.x, glyph->uv_min.y}, color32_white };
+        v[1] = { Vec2{r.x + r.width, r.y}, Vec2{glyph->uv_max.x, glyph->uv_min.y}, color32_white };
+        v[2] = { Vec2{r.x + r.width, r.y + r.height}, Vec2{glyph->uv_max.x, glyph->uv_max.y}, color32_white };
+        v[3] = { Vec2{r.x, r.y + r.height}, Vec2{glyph->uv_min.x, glyph->uv_max.y}, color32_white };
+    });
+
+    if (size)
+        *size = text_size;
+
+    return quad_count;
 }
 
 Mesh* GetMesh(TextMesh* tm)
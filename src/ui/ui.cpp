@@ -6,7 +6,11 @@
 
 constexpr int MAX_ELEMENTS = 4096;
 constexpr int MAX_ELEMENT_STACK = 128;
-constexpr int MAX_TEXT_MESHES = 4096;
+constexpr int MAX_CACHED_TEXTS = 4096;
+constexpr int TEXT_INDEX_CAPACITY = MAX_CACHED_TEXTS * 2;
+constexpr int TEXT_RECYCLE_BUCKETS = 32;
+constexpr u64 TEXT_MAX_UNUSED_FRAMES = 120;
+constexpr u64 TEXT_SWEEP_INTERVAL = 30;
 constexpr int MAX_POPUPS = 4;
 constexpr int MAX_FOCUS_STACK = 16;
 
@@ -72,10 +76,17 @@ constexpr AlignInfo g_align_info[] = {
 
 static_assert(sizeof(g_align_info) / sizeof(AlignInfo) == ALIGN_COUNT);
 
-struct CachedTextMesh {
-    TextMesh* text_mesh;
+struct CachedText {
+    GlyphVertex* vertices;      // Text space glyph quads, appended to the font's glyph stream when drawn
+    Material* material;
+    Vec2 size;
     u64 hash;
-    int last_frame;
+    u64 last_frame;
+    CachedText* next_recycled;
+    u16 text_length;
+    u16 quad_count;
+    u16 quad_capacity;
+    bool recycled;              // Out of the index, kept only so the next string can reuse its vertices
 };
 
 struct ElementState {
@@ -98,6 +109,30 @@ struct Element {
     Vec2 measured_size;
     Mat3 local_to_world;
     Mat3 world_to_local;
+    u64 hash;               // Everything measure and layout read from this element and its subtree
+    u64 transform_hash;     // Transform styles and scroll offsets of this element and its subtree
+    bool volatile_layout;   // Subtree measures against state outside the hash (scenes, world canvases)
+    bool layout_reused;     // Rect was restored from the last frame rather than laid out
+};
+
+// Results of the last frame for an element index, a subtree whose hash and available size
+// match last frame's entry at the same index restores these instead of measuring again.
+struct ElementCache {
+    u64 hash;
+    u64 transform_hash;
+    u16 next_sibling_index;
+    Vec2 available_size;
+    Vec2 measured_size;
+    Vec2 expanded_available_size;   // Content pass of an Expanded, run before its flex size is known
+    Vec2 expanded_measured_size;
+    bool has_expanded_measure;
+    float content_height;
+    Vec2 layout_size;
+    noz::Rect layout_rect;  // Rect as LayoutElement returned it, before the parent offsets it
+    noz::Rect rect;
+    Mat3 parent_transform;
+    Mat3 local_to_world;
+    Mat3 world_to_local;
 };
 
 struct CanvasElement : Element {
@@ -121,7 +156,7 @@ struct ExpandedElement : Element {
 
 struct LabelElement : Element {
     LabelStyle style;
-    CachedTextMesh* cached_mesh = nullptr;
+    CachedText* cached_text = nullptr;
 };
 
 struct ImageElement : Element {
@@ -194,7 +229,17 @@ struct UI {
     Vec2 ortho_size;
     Vec2Int ref_size;
     InputSet* input;
-    PoolAllocator* text_mesh_allocator;
+    PoolAllocator* text_allocator;
+    Map text_index;
+    u64* text_keys;
+    CachedText** text_values;
+    u8* text_ctrl;
+    CachedText* recycled_texts[TEXT_RECYCLE_BUCKETS];
+    u64 last_text_sweep;
+    ElementCache* element_cache;
+    ElementCache* last_element_cache;
+    u16 last_element_count;
+    UIStats stats;
     float depth;
     Text password_mask;
     CanvasId current_canvas_id;
@@ -344,10 +389,171 @@ Vec2 GetUISize() {
     return g_ui.ortho_size;
 }
 
+const UIStats& GetUIStats() {
+    return g_ui.stats;
+}
+
 static float GetUIScale() {
     return ToVec2(GetScreenSize()).y / g_ui.ortho_size.y;
 }
 
+// @layout_cache
+static int GetNextElementIndex(const Element* e) {
+    return e->child_count > 0 ? e->next_sibling_index : e->index + 1;
+}
+
+// Order dependent multiply fold, a full Hash call per element and child would cost more than
+// the layout it saves on the small elements most trees are made of
+static u64 CombineLayoutHash(u64 hash, u64 value) {
+    hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+}
+
+template <size_t N>
+static u64 HashLayoutValues(const float (&values)[N]) {
+    u64 hash = 0;
+    for (size_t i = 0; i < N; i++) {
+        u32 bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        hash = CombineLayoutHash(hash, bits);
+    }
+    return hash;
+}
+
+// Only what measure and layout read goes in, so recoloring an element keeps its cached layout
+static u64 GetLayoutHash(Element* e) {
+    switch (e->type) {
+    case ELEMENT_TYPE_CONTAINER:
+    case ELEMENT_TYPE_ROW:
+    case ELEMENT_TYPE_COLUMN: {
+        const ContainerStyle& style = static_cast<ContainerElement*>(e)->style;
+        float values[] = {
+            style.width, style.min_width, style.height, style.min_height, static_cast<float>(style.align),
+            style.margin.top, style.margin.left, style.margin.bottom, style.margin.right,
+            style.padding.top, style.padding.left, style.padding.bottom, style.padding.right,
+            style.border.width, style.spacing
+        };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_LABEL: {
+        LabelElement* label = static_cast<LabelElement*>(e);
+        return label->cached_text ? label->cached_text->hash : 0;
+    }
+
+    case ELEMENT_TYPE_IMAGE: {
+        ImageElement* image = static_cast<ImageElement*>(e);
+        Vec2 size = VEC2_ZERO;
+        if (image->mesh)
+            size = GetSize(image->mesh);
+        else if (image->texture)
+            size = ToVec2(GetSize(image->texture));
+        float values[] = { size.x, size.y, image->style.scale, image->mesh ? 1.0f : 0.0f };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_SPACER: {
+        SpacerElement* spacer = static_cast<SpacerElement*>(e);
+        float values[] = { spacer->size.x, spacer->size.y };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_EXPANDED: {
+        ExpandedElement* expanded = static_cast<ExpandedElement*>(e);
+        float values[] = { expanded->style.flex, static_cast<float>(expanded->axis) };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_GRID: {
+        GridElement* grid = static_cast<GridElement*>(e);
+        float values[] = {
+            grid->style.spacing, static_cast<float>(grid->style.columns),
+            grid->style.cell.width, grid->style.cell.height,
+            static_cast<float>(grid->style.virtual_count), static_cast<float>(grid->start_row),
+            grid->style.virtual_cell_func ? 1.0f : 0.0f
+        };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_POPUP: {
+        PopupElement* popup = static_cast<PopupElement*>(e);
+        float values[] = {
+            static_cast<float>(popup->style.anchor), static_cast<float>(popup->style.align),
+            popup->style.margin.top, popup->style.margin.left,
+            g_ui.ortho_size.x, g_ui.ortho_size.y
+        };
+        return HashLayoutValues(values);
+    }
+
+    case ELEMENT_TYPE_CANVAS:
+        return static_cast<u64>(static_cast<CanvasElement*>(e)->style.type) + 1;
+
+    default:
+        return 0;
+    }
+}
+
+static u64 GetTransformHash(Element* e) {
+    if (e->type == ELEMENT_TYPE_TRANSFORM) {
+        const TransformStyle& style = static_cast<TransformElement*>(e)->style;
+        float values[] = {
+            style.origin.x, style.origin.y, style.translate.x, style.translate.y,
+            style.rotate, style.scale.x, style.scale.y
+        };
+        return HashLayoutValues(values);
+    }
+
+    if (e->type == ELEMENT_TYPE_SCROLLABLE) {
+        float values[] = { static_cast<ScrollableElement*>(e)->offset };
+        return HashLayoutValues(values);
+    }
+
+    return 0;
+}
+
+// Scenes update their camera while measuring and world canvases follow a camera, neither can
+// be restored from the last frame
+static bool IsVolatileLayout(Element* e) {
+    return e->type == ELEMENT_TYPE_SCENE ||
+        (e->type == ELEMENT_TYPE_CANVAS && static_cast<CanvasElement*>(e)->style.type == CANVAS_TYPE_WORLD);
+}
+
+// Called once an element and all of its children exist, leaves straight after creation and
+// containers as they pop.  Children have already folded in, the element's own inputs close it
+// out and the result folds into the parent still on the stack.
+static void CloseElement(Element* e) {
+    e->hash = CombineLayoutHash(CombineLayoutHash(e->hash, static_cast<u64>(e->type) + 1), GetLayoutHash(e));
+    e->transform_hash = CombineLayoutHash(CombineLayoutHash(e->transform_hash, static_cast<u64>(e->type) + 1), GetTransformHash(e));
+    e->volatile_layout |= IsVolatileLayout(e);
+
+    ElementCache& cache = g_ui.element_cache[e->index];
+    cache.hash = e->hash;
+    cache.transform_hash = e->transform_hash;
+    cache.next_sibling_index = static_cast<u16>(GetNextElementIndex(e));
+    cache.has_expanded_measure = false;
+
+    if (g_ui.element_stack_count == 0)
+        return;
+
+    Element* parent = g_ui.element_stack[g_ui.element_stack_count - 1];
+    parent->hash = CombineLayoutHash(parent->hash, e->hash);
+    parent->transform_hash = CombineLayoutHash(parent->transform_hash, e->transform_hash);
+    parent->volatile_layout |= e->volatile_layout;
+}
+
+// Last frame's entry for the element if it held the same subtree, the hash only covers the
+// subtree so the extent is compared as well to catch elements shifting between frames
+static const ElementCache* GetLastElementCache(const Element* e) {
+    if (e->volatile_layout || e->index >= g_ui.last_element_count)
+        return nullptr;
+
+    const ElementCache* last = g_ui.last_element_cache + e->index;
+    if (last->hash != e->hash || last->next_sibling_index != GetNextElementIndex(e))
+        return nullptr;
+
+    return last;
+}
+
 static void PushElement(Element* element) {
     if (g_ui.element_stack_count >= MAX_ELEMENT_STACK)
         return;
@@ -359,9 +565,12 @@ static void PopElement() {
     if (g_ui.element_stack_count == 0)
         return;
 
-    GetCurrentElement()->next_sibling_index = g_ui.element_count;
+    Element* e = GetCurrentElement();
+    e->next_sibling_index = g_ui.element_count;
 
     g_ui.element_stack_count--;
+
+    CloseElement(e);
 }
 
 static void EndElement(ElementType expected_type) {
@@ -567,60 +776,170 @@ void Spacer(float size) {
     SpacerElement* e = static_cast<SpacerElement*>(CreateElement(ELEMENT_TYPE_SPACER));
     e->size = {};
     e->size[parent->type == ELEMENT_TYPE_ROW ? 0 : 1] = size;
+    CloseElement(e);
 }
 
 
-static u64 GetMeshHash(const TextRequest& request) {
+static u64 GetTextHash(const TextRequest& request) {
     return Hash(Hash(request.text), reinterpret_cast<u64>(request.font), static_cast<u64>(request.font_size));
 }
 
-static CachedTextMesh* GetOrCreateTextMesh(const char* text, const LabelStyle& style) {
+// @text_cache
+// Label glyph layouts live on the CPU and are found through an index keyed on the request hash
+// and stamped with the frame they were last drawn in.  Layouts unused for TEXT_MAX_UNUSED_FRAMES
+// leave the index and wait in buckets by text length, so a new string of the same length lays
+// its glyphs out into the old vertices instead of allocating new ones.  Nothing here touches the
+// GPU, labels are drawn through the per frame glyph streams.
+static void FreeCachedText(CachedText* c) {
+    Free(c->vertices);
+    Free(c);
+}
+
+static void RecycleText(CachedText* c) {
+    // No vertices to hand on
+    if (!c->vertices) {
+        FreeCachedText(c);
+        return;
+    }
+
+    int bucket = Min(static_cast<int>(c->text_length), TEXT_RECYCLE_BUCKETS - 1);
+    c->hash = 0;
+    c->recycled = true;
+    c->last_frame = GetFrameIndex();
+    c->next_recycled = g_ui.recycled_texts[bucket];
+    g_ui.recycled_texts[bucket] = c;
+}
+
+static CachedText* PopRecycledText(int bucket) {
+    CachedText* c = g_ui.recycled_texts[bucket];
+    if (c)
+        g_ui.recycled_texts[bucket] = c->next_recycled;
+    return c;
+}
+
+// Recycles layouts unused for max_unused_frames and releases recycled layouts that nothing
+// reused in that time.  The index and buckets are rebuilt from the survivors as the pool is
+// walked, so the index never collects tombstones from the layouts that left it.
+static void SweepTexts(u64 max_unused_frames) {
+    struct SweepArgs {
+        u64 frame;
+        u64 max_unused_frames;
+    };
+
+    SweepArgs args = { GetFrameIndex(), max_unused_frames };
+    g_ui.last_text_sweep = args.frame;
+    memset(g_ui.recycled_texts, 0, sizeof(g_ui.recycled_texts));
+    Clear(g_ui.text_index);
+
+    Enumerate(g_ui.text_allocator, [](u32, void* item_ptr, void* user_data) {
+        CachedText* c = static_cast<CachedText*>(item_ptr);
+        SweepArgs* a = static_cast<SweepArgs*>(user_data);
+        bool expired = a->frame - c->last_frame >= a->max_unused_frames;
+
+        if (!c->recycled) {
+            if (expired)
+                RecycleText(c);
+            else
+                SetValue(g_ui.text_index, c->hash, &c);
+        } else if (expired) {
+            FreeCachedText(c);
+        } else {
+            int bucket = Min(static_cast<int>(c->text_length), TEXT_RECYCLE_BUCKETS - 1);
+            c->next_recycled = g_ui.recycled_texts[bucket];
+            g_ui.recycled_texts[bucket] = c;
+        }
+        return true;
+    }, &args);
+}
+
+// Frees a pool slot for a new layout, dropping a recycled layout of any length first and
+// recycling everything not drawn this frame if that is not enough
+static bool ReserveTextSlot() {
+    if (!IsFull(g_ui.text_allocator))
+        return true;
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int bucket = 0; bucket < TEXT_RECYCLE_BUCKETS; bucket++) {
+            if (CachedText* c = PopRecycledText(bucket)) {
+                FreeCachedText(c);
+                return true;
+            }
+        }
+
+        SweepTexts(1);
+        if (!IsFull(g_ui.text_allocator))
+            return true;
+    }
+
+    return false;
+}
+
+static CachedText* GetOrCreateText(const char* text, const LabelStyle& style) {
     TextRequest r = {};
     r.font = style.font;
     r.font_size = style.font_size;
     Set(r.text, text);
 
-    struct EnumArgs {
-        u64 hash;
-        CachedTextMesh* result;
-    };
-
-    EnumArgs args = { GetMeshHash(r), nullptr };
-    Enumerate(g_ui.text_mesh_allocator, [](u32, void* item_ptr, void* user_data) {
-        CachedTextMesh* c = static_cast<CachedTextMesh*>(item_ptr);
-        EnumArgs* a = static_cast<EnumArgs*>(user_data);
-        if (c->hash != a->hash)
-            return true;
+    u64 hash = GetTextHash(r);
+    u64 frame = GetFrameIndex();
+    if (CachedText** found = static_cast<CachedText**>(GetValue(g_ui.text_index, hash))) {
+        (*found)->last_frame = frame;
+        return *found;
+    }
 
-        a->result = c;
-        return false;
-    }, &args);
+    if (!r.font)
+        return nullptr;
 
-    if (!args.result) {
-        if (TextMesh* tm = CreateTextMesh(ALLOCATOR_DEFAULT, r)) {
-            args.result = static_cast<CachedTextMesh*>(Alloc(g_ui.text_mesh_allocator, sizeof(CachedTextMesh)));
-            args.result->hash = args.hash;
-            args.result->text_mesh = tm;
-            args.result->last_frame = 0;
+    CachedText* c = PopRecycledText(Min(r.text.length, TEXT_RECYCLE_BUCKETS - 1));
+    if (!c) {
+        if (!ReserveTextSlot()) {
+            LogWarning("[UI] text cache is full, label '%s' skipped", text);
+            return nullptr;
         }
+
+        c = static_cast<CachedText*>(Alloc(g_ui.text_allocator, sizeof(CachedText)));
+    }
+
+    if (r.text.length > c->quad_capacity) {
+        u32 size = static_cast<u32>(r.text.length * 4 * sizeof(GlyphVertex));
+        c->vertices = static_cast<GlyphVertex*>(c->vertices ? Realloc(c->vertices, size) : Alloc(ALLOCATOR_DEFAULT, size));
+        c->quad_capacity = static_cast<u16>(r.text.length);
+    }
+
+    if (c->vertices) {
+        c->quad_count = static_cast<u16>(BuildTextGlyphs(r, c->vertices, &c->size));
+    } else {
+        c->quad_count = 0;
+        c->size = MeasureText(r.text, r.font, static_cast<float>(r.font_size));
     }
 
-    return args.result;
+    c->material = GetMaterial(r.font);
+
+    c->hash = hash;
+    c->last_frame = frame;
+    c->next_recycled = nullptr;
+    c->text_length = static_cast<u16>(r.text.length);
+    c->recycled = false;
+    SetValue(g_ui.text_index, hash, &c);
+    return c;
 }
 
 void Label(const char* text, const LabelStyle& style) {
     LabelElement* label = static_cast<LabelElement*>(CreateElement(ELEMENT_TYPE_LABEL));
     label->style = style;
-    label->cached_mesh = GetOrCreateTextMesh(text, style);
+    label->cached_text = GetOrCreateText(text, style);
 
     if (!label->style.font)
         label->style.font = FONT_DEFAULT;
+
+    CloseElement(label);
 }
 
 void Image(Texture* texture, const ImageStyle& style) {
     ImageElement* image = static_cast<ImageElement*>(CreateElement(ELEMENT_TYPE_IMAGE));
     image->texture = texture;
     image->style = style;
+    CloseElement(image);
 }
 
 void Image(Mesh* mesh, const ImageStyle& style) {
@@ -629,6 +948,7 @@ void Image(Mesh* mesh, const ImageStyle& style) {
     image->style = style;
     if (!image->style.material)
         image->style.material = g_ui.image_element_material;
+    CloseElement(image);
 }
 
 void Image(Mesh* mesh, float time, const ImageStyle& style) {
@@ -638,6 +958,7 @@ void Image(Mesh* mesh, float time, const ImageStyle& style) {
     image->style = style;
     if (!image->style.material)
         image->style.material = g_ui.image_element_material;
+    CloseElement(image);
 }
 
 void Rectangle(const RectangleStyle& style) {
@@ -646,6 +967,7 @@ void Rectangle(const RectangleStyle& style) {
     e->style.width = style.width;
     e->style.height = style.height;
     e->style.color = style.color;
+    CloseElement(e);
 }
 
 bool TextBox(Text& text, const TextBoxStyle& style) {
@@ -662,6 +984,7 @@ bool TextBox(Text& text, const TextBoxStyle& style) {
         TextboxElement* textbox = static_cast<TextboxElement*>(CreateElement(ELEMENT_TYPE_TEXTBOX));
         textbox->id = id;
         textbox->style = style;
+        CloseElement(textbox);
         Set(g_ui.element_states[id].text, text);
 
         if (g_ui.focus_id == id)
@@ -712,6 +1035,7 @@ void Scene(const SceneStyle& style, void (*draw_scene)(void*)) {
     SceneElement* e = static_cast<SceneElement*>(CreateElement(ELEMENT_TYPE_SCENE));
     e->style = style;
     e->draw_scene = draw_scene;
+    CloseElement(e);
 }
 
 void BeginTransformed(const TransformStyle& style) {
@@ -778,16 +1102,45 @@ static int MeasureGrid(int element_index, const Vec2& available_size) {
     return element_index;
 }
 
+// Content pass of an Expanded child that is measured again at its flex size.  The element cache
+// holds the flex pass, so this pass keeps its own entry, otherwise both passes would miss every
+// frame.  On a hit only the Expanded itself is restored since the flex pass measures the subtree.
+static int MeasureExpandedContent(int element_index, const Vec2& available_size) {
+    Element* e = g_ui.elements[element_index];
+    ElementCache& cache = g_ui.element_cache[element_index];
+    const ElementCache* last = GetLastElementCache(e);
+    if (last && last->has_expanded_measure && last->expanded_available_size == available_size) {
+        e->measured_size = last->expanded_measured_size;
+    } else {
+        MeasureElement(element_index, available_size);
+    }
+
+    cache.expanded_available_size = available_size;
+    cache.expanded_measured_size = e->measured_size;
+    cache.has_expanded_measure = true;
+    return GetNextElementIndex(e);
+}
+
 static int MeasureRowColumnContent(int element_index, const Vec2& available_size, int axis, int cross_axis, Vec2& max_content_size) {
     ContainerElement* e = static_cast<ContainerElement*>(g_ui.elements[element_index++]);
     int child_element_index = element_index;
     float flex_total = 0.0f;
+    for (u16 i = 0, child_index = static_cast<u16>(element_index); i < e->child_count; i++) {
+        Element* child = g_ui.elements[child_index];
+        if (child->type == ELEMENT_TYPE_EXPANDED)
+            flex_total += static_cast<ExpandedElement*>(child)->style.flex;
+        child_index = static_cast<u16>(GetNextElementIndex(child));
+    }
+
+    bool has_flex = flex_total >= F32_EPSILON;
     for (u16 i = 0; i < e->child_count; i++) {
         Element* child = g_ui.elements[element_index];
         if (child->type == ELEMENT_TYPE_EXPANDED) {
             Vec2 child_available_size = {};
             child_available_size[cross_axis] = available_size[cross_axis];
-            element_index = MeasureElement(element_index, child_available_size);
+            element_index = has_flex
+                ? MeasureExpandedContent(element_index, child_available_size)
+                : MeasureElement(element_index, child_available_size);
         } else {
             element_index = MeasureElement(element_index, available_size);
         }
@@ -795,13 +1148,11 @@ static int MeasureRowColumnContent(int element_index, const Vec2& available_size
             max_content_size[cross_axis],
             child->measured_size[cross_axis]);
         max_content_size[axis] += child->measured_size[axis];
-        if (child->type == ELEMENT_TYPE_EXPANDED)
-            flex_total += static_cast<ExpandedElement*>(child)->style.flex;
     }
 
     float spacing = e->child_count > 1 ? e->style.spacing * (e->child_count - 1) : 0.0f;
 
-    if (flex_total >= F32_EPSILON) {
+    if (has_flex) {
         float flex_available = Max(0.0f, available_size[axis] - max_content_size[axis]) - spacing;
         max_content_size[axis] = Max(max_content_size[axis], available_size[axis]);
         Vec2 child_available_size = {};
@@ -813,7 +1164,7 @@ static int MeasureRowColumnContent(int element_index, const Vec2& available_size
                 child_available_size[axis] = expanded->style.flex / flex_total * flex_available;
                 MeasureElement(child_element_index, child_available_size);
             }
-            child_element_index = child->next_sibling_index;
+            child_element_index = GetNextElementIndex(child);
         }
     }
 
@@ -823,10 +1174,12 @@ static int MeasureRowColumnContent(int element_index, const Vec2& available_size
     return element_index;
 }
 
-static int MeasureElement(int element_index, const Vec2& available_size) {
+static int MeasureElementUncached(int element_index, const Vec2& available_size) {
     Element* e = g_ui.elements[element_index++];
     assert(e);
 
+    g_ui.stats.measured_count++;
+
     // @measure_container
     if (IsContainerType(e->type)) {
         ContainerElement* container = static_cast<ContainerElement*>(e);
@@ -896,10 +1249,8 @@ static int MeasureElement(int element_index, const Vec2& available_size) {
     // @measure_label
     } else if (e->type == ELEMENT_TYPE_LABEL) {
         LabelElement* l = static_cast<LabelElement*>(e);
-        if (l->cached_mesh && l->cached_mesh->text_mesh) {
-            Vec2 text_size = GetSize(l->cached_mesh->text_mesh);
-            e->measured_size = text_size;
-        }
+        if (l->cached_text)
+            e->measured_size = l->cached_text->size;
 
         assert(e->child_count == 0);
 
@@ -1022,7 +1373,40 @@ static int MeasureElement(int element_index, const Vec2& available_size) {
     return element_index;
 }
 
-static int LayoutElement(int element_index, const Vec2& size) {
+static int MeasureElement(int element_index, const Vec2& available_size) {
+    Element* e = g_ui.elements[element_index];
+    const ElementCache* last = GetLastElementCache(e);
+    if (last && last->available_size == available_size) {
+        int next_index = GetNextElementIndex(e);
+        for (int i = element_index; i < next_index; i++) {
+            Element* d = g_ui.elements[i];
+            const ElementCache& from = g_ui.last_element_cache[i];
+            ElementCache& to = g_ui.element_cache[i];
+            d->measured_size = from.measured_size;
+            if (d->type == ELEMENT_TYPE_SCROLLABLE)
+                static_cast<ScrollableElement*>(d)->content_height = from.content_height;
+            to.available_size = from.available_size;
+            to.measured_size = from.measured_size;
+            to.expanded_available_size = from.expanded_available_size;
+            to.expanded_measured_size = from.expanded_measured_size;
+            to.has_expanded_measure = from.has_expanded_measure;
+            to.content_height = from.content_height;
+        }
+        return next_index;
+    }
+
+    int next_index = MeasureElementUncached(element_index, available_size);
+
+    ElementCache& cache = g_ui.element_cache[element_index];
+    cache.available_size = available_size;
+    cache.measured_size = e->measured_size;
+    cache.content_height = e->type == ELEMENT_TYPE_SCROLLABLE
+        ? static_cast<ScrollableElement*>(e)->content_height
+        : 0.0f;
+    return next_index;
+}
+
+static int LayoutElementUncached(int element_index, const Vec2& size) {
     Element* e = g_ui.elements[element_index++];
     assert(e);
 
@@ -1187,7 +1571,39 @@ static int LayoutElement(int element_index, const Vec2& size) {
     return element_index;
 }
 
-static u32 CalculateTransforms(u32 element_index, const Mat3& parent_transform) {
+// Descendant rects come back final since parents only ever offset their direct children
+static int LayoutElement(int element_index, const Vec2& size) {
+    Element* e = g_ui.elements[element_index];
+    ElementCache& cache = g_ui.element_cache[element_index];
+    const ElementCache* last = GetLastElementCache(e);
+    if (last && last->layout_size == size && last->available_size == cache.available_size) {
+        int next_index = GetNextElementIndex(e);
+        e->rect = last->layout_rect;
+        e->layout_reused = true;
+        cache.layout_size = size;
+        cache.layout_rect = last->layout_rect;
+        for (int i = element_index + 1; i < next_index; i++) {
+            Element* d = g_ui.elements[i];
+            const ElementCache& from = g_ui.last_element_cache[i];
+            ElementCache& to = g_ui.element_cache[i];
+            d->rect = from.rect;
+            d->layout_reused = true;
+            to.layout_size = from.layout_size;
+            to.layout_rect = from.layout_rect;
+        }
+        return next_index;
+    }
+
+    int next_index = LayoutElementUncached(element_index, size);
+
+    cache.layout_size = size;
+    cache.layout_rect = e->rect;
+    return next_index;
+}
+
+static u32 CalculateTransforms(u32 element_index, const Mat3& parent_transform);
+
+static u32 CalculateTransformsUncached(u32 element_index, const Mat3& parent_transform) {
     Element* e = g_ui.elements[element_index++];
 
     if (e->type == ELEMENT_TYPE_TRANSFORM) {
@@ -1225,6 +1641,38 @@ static u32 CalculateTransforms(u32 element_index, const Mat3& parent_transform)
     return element_index;
 }
 
+static u32 CalculateTransforms(u32 element_index, const Mat3& parent_transform) {
+    Element* e = g_ui.elements[element_index];
+    ElementCache& cache = g_ui.element_cache[element_index];
+    const ElementCache* last = e->layout_reused ? GetLastElementCache(e) : nullptr;
+    if (last &&
+        last->transform_hash == e->transform_hash &&
+        memcmp(&last->rect, &e->rect, sizeof(e->rect)) == 0 &&
+        memcmp(&last->parent_transform, &parent_transform, sizeof(Mat3)) == 0) {
+        u32 next_index = static_cast<u32>(GetNextElementIndex(e));
+        for (u32 i = element_index; i < next_index; i++) {
+            Element* d = g_ui.elements[i];
+            const ElementCache& from = g_ui.last_element_cache[i];
+            ElementCache& to = g_ui.element_cache[i];
+            d->local_to_world = from.local_to_world;
+            d->world_to_local = from.world_to_local;
+            to.rect = from.rect;
+            to.parent_transform = from.parent_transform;
+            to.local_to_world = from.local_to_world;
+            to.world_to_local = from.world_to_local;
+        }
+        return next_index;
+    }
+
+    u32 next_index = CalculateTransformsUncached(element_index, parent_transform);
+
+    cache.rect = e->rect;
+    cache.parent_transform = parent_transform;
+    cache.local_to_world = e->local_to_world;
+    cache.world_to_local = e->world_to_local;
+    return next_index;
+}
+
 static void DrawCanvas(CanvasElement* canvas, const Mat3& transform){
     Update(g_ui.camera);
     BindCamera(g_ui.camera);
@@ -1292,6 +1740,18 @@ static void DrawContainer(ContainerElement* container, const Mat3& transform) {
     }
 }
 
+// Clipped children can never draw outside the clip rect, so a clip rect that misses the
+// camera lets the whole subtree be skipped.
+static bool IsClipVisible(Element* e, const Mat3& transform, float radius=0.0f) {
+    Bounds2 bounds = TransformBounds(transform * Scale(Vec2{e->rect.width, e->rect.height}), GetBounds(g_ui.element_mesh));
+    return IsVisible(Expand(bounds, radius));
+}
+
+static int SkipElement(Element* e, int element_index) {
+    AddCulledDraws(e->next_sibling_index - element_index);
+    return e->next_sibling_index;
+}
+
 static int DrawElement(int element_index, bool is_popup) {
     Element* e = g_ui.elements[element_index++];
     const Mat3& transform = e->local_to_world;
@@ -1299,10 +1759,10 @@ static int DrawElement(int element_index, bool is_popup) {
     // @render_label
     if (e->type == ELEMENT_TYPE_LABEL) {
         LabelElement* l = static_cast<LabelElement*>(e);
-        Mesh* mesh = l->cached_mesh ? GetMesh(l->cached_mesh->text_mesh) : nullptr;
-        if (mesh) {
+        CachedText* c = l->cached_text;
+        if (c && c->quad_count > 0) {
             const AlignInfo& align = g_align_info[l->style.align];
-            Vec2 text_size = GetSize(l->cached_mesh->text_mesh);
+            Vec2 text_size = c->size;
             Vec2 text_offset = VEC2_ZERO;
             if (align.has_x) text_offset.x = (e->rect.width - text_size.x) * align.x;
             if (align.has_y) text_offset.y = (e->rect.height - text_size.y) * align.y;
@@ -1328,10 +1788,23 @@ static int DrawElement(int element_index, bool is_popup) {
 
             Vec2 scale = snapped_ui_size / text_size;
 
-            BindTransform(Translate(snapped_ui_pos) * Scale(scale));
-            BindColor(l->style.color);
-            BindMaterial(l->style.material ? l->style.material : GetMaterial(l->cached_mesh->text_mesh));
-            DrawMesh(mesh);
+            // Glyphs go to the font's glyph stream already placed and colored, so changing text
+            // costs a layout on the CPU and never a mesh or buffer
+            GlyphVertex* vertices = nullptr;
+            if (!IsVisible(Bounds2{Min(snapped_ui_pos, snapped_ui_end), Max(snapped_ui_pos, snapped_ui_end)}))
+                AddCulledDraws(1);
+            else
+                vertices = AddGlyphs(l->style.material ? l->style.material : c->material, c->quad_count);
+
+            if (vertices) {
+                Color32 color = ToColor32(ToLinear(l->style.color));
+                const GlyphVertex* src = c->vertices;
+                for (int i = 0, vertex_count = c->quad_count * 4; i < vertex_count; i++) {
+                    vertices[i].position = snapped_ui_pos + src[i].position * scale;
+                    vertices[i].uv = src[i].uv;
+                    vertices[i].color = color;
+                }
+            }
         }
 
     // @render_image
@@ -1407,6 +1880,9 @@ static int DrawElement(int element_index, bool is_popup) {
 
         // Set up stencil clipping for children only
         if (container->style.clip) {
+            if (!IsClipVisible(e, transform, container->style.border.radius))
+                return SkipElement(e, element_index);
+
             BeginClip();
 
             // Draw container shape for stencil (writes to stencil, not color)
@@ -1487,6 +1963,9 @@ static int DrawElement(int element_index, bool is_popup) {
 
     // @render_scrollable
     } else if (e->type == ELEMENT_TYPE_SCROLLABLE) {
+        if (!IsClipVisible(e, transform))
+            return SkipElement(e, element_index);
+
         // Set up stencil clipping for scrollable content
         BeginClip();
 
@@ -1536,6 +2015,9 @@ void BeginUI(u32 ref_width, u32 ref_height) {
 
     Clear(g_ui.allocator);
 
+    if (GetFrameIndex() - g_ui.last_text_sweep >= TEXT_SWEEP_INTERVAL)
+        SweepTexts(TEXT_MAX_UNUSED_FRAMES);
+
     Vec2Int screen_size = GetScreenSize();
 
     f32 rw = static_cast<f32>(g_ui.ref_size.x);
@@ -1776,6 +2258,7 @@ static void HandleInput() {
 void EndUI() {
     UpdateDebugUI();
 
+    g_ui.stats = { .element_count = g_ui.element_count };
     for (int element_index=0; element_index < g_ui.element_count; )
         element_index = MeasureElement(element_index, g_ui.ortho_size);
     for (int element_index=0; element_index < g_ui.element_count; )
@@ -1783,18 +2266,27 @@ void EndUI() {
     for (int element_index=0; element_index < g_ui.element_count; )
         element_index = CalculateTransforms(element_index, MAT3_IDENTITY);
 
+    ElementCache* last_element_cache = g_ui.last_element_cache;
+    g_ui.last_element_cache = g_ui.element_cache;
+    g_ui.element_cache = last_element_cache;
+    g_ui.last_element_count = g_ui.element_count;
+
     HandleInput();
 }
 
+// Text is flushed after every canvas and popup so each layer's labels stay under the next layer
 void DrawUI() {
     BindDepth(g_ui.depth, 0);
-    for (u32 element_index = 0; element_index < g_ui.element_count; )
+    for (u32 element_index = 0; element_index < g_ui.element_count; ) {
         element_index = DrawElement(element_index, false);
+        FlushGlyphs();
+    }
 
     for (int popup_index=0; popup_index < g_ui.popup_count; popup_index++) {
         PopupElement* p = static_cast<PopupElement*>(g_ui.popups[popup_index]);
         for (u32 element_index = p->index; element_index < p->next_sibling_index; )
             element_index = DrawElement(element_index, true);
+        FlushGlyphs();
     }
 
     // cursor
@@ -1907,7 +2399,13 @@ void InitUI(const ApplicationTraits* traits) {
     g_ui.element_material = CreateMaterial(ALLOCATOR_DEFAULT, SHADER_UI);
     g_ui.image_element_material = CreateMaterial(ALLOCATOR_DEFAULT, SHADER_UI_IMAGE);
     g_ui.input = CreateInputSet(ALLOCATOR_DEFAULT);
-    g_ui.text_mesh_allocator = CreatePoolAllocator(sizeof(CachedTextMesh), MAX_TEXT_MESHES);
+    g_ui.text_allocator = CreatePoolAllocator(sizeof(CachedText), MAX_CACHED_TEXTS);
+    g_ui.text_keys = static_cast<u64*>(Alloc(ALLOCATOR_DEFAULT, sizeof(u64) * TEXT_INDEX_CAPACITY));
+    g_ui.text_values = static_cast<CachedText**>(Alloc(ALLOCATOR_DEFAULT, sizeof(CachedText*) * TEXT_INDEX_CAPACITY));
+    g_ui.text_ctrl = static_cast<u8*>(Alloc(ALLOCATOR_DEFAULT, GetMapCtrlSize(TEXT_INDEX_CAPACITY)));
+    Init(g_ui.text_index, g_ui.text_keys, g_ui.text_values, g_ui.text_ctrl, TEXT_INDEX_CAPACITY, sizeof(CachedText*));
+    g_ui.element_cache = static_cast<ElementCache*>(Alloc(ALLOCATOR_DEFAULT, sizeof(ElementCache) * MAX_ELEMENTS));
+    g_ui.last_element_cache = static_cast<ElementCache*>(Alloc(ALLOCATOR_DEFAULT, sizeof(ElementCache) * MAX_ELEMENTS));
     g_ui.depth = traits->ui_depth >= F32_MAX ? traits->renderer.max_depth - 0.01f : traits->ui_depth;
     g_ui.popup_count = 0;
     g_ui.close_popups = false;
@@ -1929,6 +2427,16 @@ void InitUI(const ApplicationTraits* traits) {
 }
 
 void ShutdownUI() {
+    Enumerate(g_ui.text_allocator, [](u32, void* item_ptr, void*) {
+        FreeCachedText(static_cast<CachedText*>(item_ptr));
+        return true;
+    });
+    Destroy(g_ui.text_allocator);
+    Free(g_ui.text_keys);
+    Free(g_ui.text_values);
+    Free(g_ui.text_ctrl);
+    Free(g_ui.element_cache);
+    Free(g_ui.last_element_cache);
     Destroy(g_ui.allocator);
     memset(&g_ui, 0, sizeof(g_ui));
 }
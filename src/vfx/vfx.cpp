@@ -35,13 +35,27 @@ static void LoadVfxInternal(VfxImpl* impl, Allocator* allocator, Stream* stream)
             particle_def->drag = ReadStruct<VfxFloat>(stream);
             particle_def->rotation = ReadStruct<VfxFloatCurve>(stream);
             particle_def->mesh_name = ReadName(stream);
-            particle_def->mesh = GetMesh(particle_def->mesh_name);
+            particle_def->mesh = nullptr;
 
             emitter_def->vfx = impl;
         }
     }
 }
 
+// Mesh lookups touch the main thread's asset tables, so async loads resolve them in the
+// upload phase instead of on the worker
+static void ResolveVfxMeshes(VfxImpl* impl) {
+    for (u32 i = 0; i < impl->emitter_count; ++i) {
+        VfxParticleDef* particle_def = &impl->emitters[i].particle_def;
+        particle_def->mesh = GetMesh(particle_def->mesh_name);
+    }
+}
+
+bool UploadVfx(Asset* asset) {
+    ResolveVfxMeshes(static_cast<VfxImpl*>(asset));
+    return true;
+}
+
 Bounds2 GetBounds(Vfx* vfx) {
     return static_cast<VfxImpl*>(vfx)->bounds;
 }
@@ -54,6 +68,8 @@ Asset* LoadVfx(Allocator* allocator, Stream* stream, AssetHeader* header, const
     VfxImpl* impl = static_cast<VfxImpl*>(vfx);
     impl->name = name;
     LoadVfxInternal(impl, allocator, stream);
+    if (IsMainThread())
+        ResolveVfxMeshes(impl);
     return vfx;
 }
 
@@ -73,6 +89,7 @@ void ReloadVfx(Asset* asset, Stream* stream, const AssetHeader& header, const Na
     VfxEmitterDef* old_emitters = impl->emitters;
 
     LoadVfxInternal(impl, ALLOCATOR_DEFAULT, stream);
+    ResolveVfxMeshes(impl);
 
     RestartVfx(impl);
 
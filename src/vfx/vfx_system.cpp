@@ -3,41 +3,55 @@
 //
 
 #include "vfx_internal.h"
+#include "../math/simd.h"
+
+// Particles live in fixed size chunks of structure of arrays streams.  Every chunk belongs to
+// a single emitter, so the curve types are uniform across a chunk and the update kernels run
+// four particles at a time without branching.  Particles are kept dense within an emitter by
+// moving its last particle into any hole left by a dead one.
 
-constexpr u16 MAX_PARTICLES = 4096;
-constexpr u16 MAX_EMITTERS = 2024;
-constexpr u16 MAX_INSTANCES = 256;
 constexpr u16 MAX_MESHES = 1;
+constexpr int VFX_CHUNK_SIZE = 32;
+constexpr int VFX_DRAW_BATCH_SIZE = VFX_CHUNK_SIZE * 8;
+
+static_assert(VFX_CHUNK_SIZE % 4 == 0, "chunk size must be a multiple of the SIMD width");
 
 enum VfxMesh {
     VFX_MESH_SQUARE
 };
 
-struct VfxParticle {
-    Vec2 position;
-    Vec2 velocity;
-    VfxCurveType rotation_curve;
-    float rotation_start;
-    float rotation_end;
-    VfxCurveType color_curve;
-    Color color_start;
-    Color color_end;
-    VfxCurveType size_curve;
-    float size_start;
-    float size_end;
-    VfxCurveType opacity_curve;
-    float opacity_start;
-    float opacity_end;
-    VfxCurveType speed_curve;
-    float speed_start;
-    float speed_end;
-    float lifetime;
-    float elapsed;
-    float rotation;
-    Vec2 gravity;
-    float drag;
-    Mesh* mesh;
-    u16 emitter_index;
+enum VfxStream {
+    VFX_STREAM_POSITION_X,
+    VFX_STREAM_POSITION_Y,
+    VFX_STREAM_VELOCITY_X,
+    VFX_STREAM_VELOCITY_Y,
+    VFX_STREAM_GRAVITY_X,
+    VFX_STREAM_GRAVITY_Y,
+    VFX_STREAM_DRAG,
+    VFX_STREAM_ELAPSED,
+    VFX_STREAM_LIFETIME,
+    VFX_STREAM_SPEED_START,
+    VFX_STREAM_SPEED_END,
+    VFX_STREAM_SIZE_START,
+    VFX_STREAM_SIZE_END,
+    VFX_STREAM_OPACITY_START,
+    VFX_STREAM_OPACITY_END,
+    VFX_STREAM_ROTATION_START,
+    VFX_STREAM_ROTATION_END,
+    VFX_STREAM_COLOR_START_R,
+    VFX_STREAM_COLOR_START_G,
+    VFX_STREAM_COLOR_START_B,
+    VFX_STREAM_COLOR_END_R,
+    VFX_STREAM_COLOR_END_G,
+    VFX_STREAM_COLOR_END_B,
+    VFX_STREAM_COUNT
+};
+
+struct VfxChunk {
+    float streams[VFX_STREAM_COUNT][VFX_CHUNK_SIZE];
+    VfxChunk* prev;
+    VfxChunk* next;
+    int count;
 };
 
 struct VfxEmitter {
@@ -49,6 +63,8 @@ struct VfxEmitter {
     bool active;
     u16 instance_index;
     int particle_count;
+    VfxChunk* first_chunk;
+    VfxChunk* last_chunk;
 };
 
 struct VfxInstance {
@@ -57,6 +73,9 @@ struct VfxInstance {
     float depth;
     int emitter_count;
     bool loop;
+    bool visible;
+    VfxPriority priority;
+    float emission_scale;
     u32 version;
 };
 
@@ -65,53 +84,71 @@ struct VfxSystem {
     Material* material;
 
     PoolAllocator* instance_pool;
-    bool instance_valid[MAX_INSTANCES];
+    bool* instance_valid;
+    u32 max_instances;
 
-    PoolAllocator* particle_pool;
-    bool particle_valid[MAX_PARTICLES];
+    PoolAllocator* chunk_pool;
+    u32 max_particles;
+    u32 particle_budget;
+    u32 particle_count;
 
     PoolAllocator* emitter_pool;
-    bool emitter_valid[MAX_EMITTERS];
+    bool* emitter_valid;
+    u32 max_emitters;
+
+    InstanceData* draw_instances;
+
+    Bounds2 view_bounds;
+    bool has_view;
+
+    VfxStats stats;
+    VfxStats last_stats;
+    float thinned;
 };
 
 static VfxSystem g_vfx = {};
 
 static VfxEmitter* CreateEmitter(VfxInstance* instance, const VfxEmitterDef& def);
-static VfxParticle* EmitParticle(VfxEmitter* e);
+static bool EmitParticle(VfxEmitter* e);
 
-static float EvaluateCurve(VfxCurveType curve, float t)
+// Expects t already clamped to 0..1
+static f32x4 EvaluateCurve4(VfxCurveType curve, f32x4 t)
 {
-    t = Max(0.0f, Min(1.0f, t));
-
+    f32x4 one = Set4(1.0f);
     switch (curve)
     {
-    case VFX_CURVE_TYPE_LINEAR:
-        return t;
-
     case VFX_CURVE_TYPE_EASE_IN:
-        return t * t;
-
-    case VFX_CURVE_TYPE_EASE_OUT:
-        return 1.0f - (1.0f - t) * (1.0f - t);
-
-    case VFX_CURVE_TYPE_EASE_IN_OUT:
-        if (t < 0.5f)
-            return 2.0f * t * t;
+    case VFX_CURVE_TYPE_QUADRATIC:
+        return Mul4(t, t);
 
-        return 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+    case VFX_CURVE_TYPE_EASE_OUT: {
+        f32x4 inv = Sub4(one, t);
+        return Sub4(one, Mul4(inv, inv));
+    }
 
-    case VFX_CURVE_TYPE_QUADRATIC:
-        return t * t;
+    case VFX_CURVE_TYPE_EASE_IN_OUT: {
+        f32x4 two = Set4(2.0f);
+        f32x4 inv = Sub4(one, t);
+        f32x4 in = Mul4(two, Mul4(t, t));
+        f32x4 out = Sub4(one, Mul4(two, Mul4(inv, inv)));
+        return Select4(out, in, Less4(t, Set4(0.5f)));
+    }
 
     case VFX_CURVE_TYPE_CUBIC:
-        return t * t * t;
-
-    case VFX_CURVE_TYPE_SINE:
-        return sinf(t * noz::PI * 0.5f);
+        return Mul4(t, Mul4(t, t));
+
+    case VFX_CURVE_TYPE_SINE: {
+        float lanes[4];
+        Store4(lanes, t);
+        for (int i=0; i<4; i++)
+            lanes[i] = sinf(lanes[i] * noz::PI * 0.5f);
+        return Load4(lanes);
+    }
 
+    case VFX_CURVE_TYPE_LINEAR:
     case VFX_CURVE_TYPE_CUSTOM:
     default:
-        return t; // Fallback to linear
+        return t;
     }
 }
 
@@ -126,8 +163,6 @@ static Vec2 GetRandom(const VfxVec2& range)
 
 static u16 GetIndex(VfxInstance* i) { return (u16)GetIndex(g_vfx.instance_pool, i); }
 static u16 GetIndex(VfxEmitter* e) { return (u16)GetIndex(g_vfx.emitter_pool, e); }
-static u16 GetIndex(VfxParticle* p) { return (u16)GetIndex(g_vfx.particle_pool, p); }
-static VfxParticle* GetParticle(int i) { return (VfxParticle*)GetAt(g_vfx.particle_pool, i); }
 static VfxEmitter* GetEmitter(int i) { return (VfxEmitter*)GetAt(g_vfx.emitter_pool, i); }
 static VfxHandle GetHandle(VfxInstance* instance) {
     return {
@@ -175,21 +210,65 @@ static VfxInstance* CreateInstance(Vfx* vfx, const Mat3& transform, float depth)
     return instance;
 }
 
-static void ParticleDestructor(void *ptr) {
-    VfxParticle* p = (VfxParticle*)ptr;
-    VfxEmitter* e = GetEmitter(p->emitter_index);
+// @chunk
+static VfxChunk* AddChunk(VfxEmitter* e) {
+    if (IsFull(g_vfx.chunk_pool))
+        return nullptr;
+
+    VfxChunk* chunk = static_cast<VfxChunk*>(Alloc(g_vfx.chunk_pool, sizeof(VfxChunk)));
+    assert(chunk);
+    chunk->count = 0;
+    chunk->next = nullptr;
+    chunk->prev = e->last_chunk;
+
+    if (e->last_chunk)
+        e->last_chunk->next = chunk;
+    else
+        e->first_chunk = chunk;
+
+    e->last_chunk = chunk;
+    return chunk;
+}
+
+static void RemoveLastChunk(VfxEmitter* e) {
+    VfxChunk* chunk = e->last_chunk;
+    assert(chunk);
+
+    e->last_chunk = chunk->prev;
+    if (e->last_chunk)
+        e->last_chunk->next = nullptr;
+    else
+        e->first_chunk = nullptr;
+
+    Free(chunk);
+}
+
+// Fill the hole at index with the last particle of the emitter so the streams stay dense
+static void RemoveParticle(VfxEmitter* e, VfxChunk* chunk, int index) {
+    VfxChunk* last = e->last_chunk;
+    int last_index = last->count - 1;
 
-    assert(e->particle_count > 0);
+    if (last != chunk || last_index != index)
+        for (int stream=0; stream<VFX_STREAM_COUNT; stream++)
+            chunk->streams[stream][index] = last->streams[stream][last_index];
+
+    last->count--;
     e->particle_count--;
-    g_vfx.particle_valid[GetIndex(p)] = false;
+    g_vfx.particle_count--;
+
+    if (last->count == 0)
+        RemoveLastChunk(e);
 }
 
-static VfxParticle* EmitParticle(VfxEmitter* e) {
-    if (IsFull(g_vfx.emitter_pool))
-        return nullptr;
+static bool EmitParticle(VfxEmitter* e) {
+    VfxChunk* chunk = e->last_chunk;
+    if (g_vfx.particle_count < g_vfx.max_particles && (!chunk || chunk->count == VFX_CHUNK_SIZE))
+        chunk = AddChunk(e);
 
-    VfxParticle* p = (VfxParticle*)Alloc(g_vfx.particle_pool, sizeof(VfxParticle), ParticleDestructor);
-    assert(p);
+    if (!chunk || chunk->count == VFX_CHUNK_SIZE || g_vfx.particle_count >= g_vfx.max_particles) {
+        g_vfx.stats.dropped_count++;
+        return false;
+    }
 
     VfxInstance* i = GetInstance(e);
     assert(i);
@@ -201,102 +280,220 @@ static VfxParticle* EmitParticle(VfxEmitter* e) {
         dir = { Cos(angle), Sin(angle) };
 
     const VfxParticleDef& def = e->def->particle_def;
-    p->position = TransformVector(i->transform, GetRandom(e->def->spawn));
-    p->size_start = GetRandom(def.size.start);
-    p->size_end = GetRandom(def.size.end);
-    p->opacity_curve = def.opacity.type;
-    p->opacity_start = GetRandom(def.opacity.start);
-    p->opacity_end = GetRandom(def.opacity.end);
-    p->size_curve = def.size.type;
-    p->speed_start = GetRandom(def.speed.start);
-    p->speed_end = GetRandom(def.speed.end);
-    p->speed_curve = def.speed.type;
-    p->velocity = dir * p->speed_start;
-    p->color_start = GetRandom(def.color.start);
-    p->color_end = GetRandom(def.color.end);
-    p->color_curve = def.color.type;
-    p->lifetime = GetRandom(def.duration);
-    p->elapsed = 0.0f;
-    p->gravity = GetRandom(def.gravity);
-    p->drag = GetRandom(def.drag);
-    p->rotation_curve = def.rotation.type;
-    p->rotation_start = Radians(GetRandom(def.rotation.start));
-    p->rotation_end = p->rotation_start + Radians(GetRandom(def.rotation.end));
-    p->rotation = p->rotation_start;
-    p->emitter_index = GetIndex(e);
-
-    p->mesh = def.mesh;
-    if (p->mesh == nullptr)
-        p->mesh = g_vfx.meshes[VFX_MESH_SQUARE];
-
-    g_vfx.particle_valid[GetIndex(p)] = true;
+    Vec2 position = TransformVector(i->transform, GetRandom(e->def->spawn));
+    Vec2 gravity = GetRandom(def.gravity);
+    float speed_start = GetRandom(def.speed.start);
+    float rotation_start = Radians(GetRandom(def.rotation.start));
+    Color color_start = GetRandom(def.color.start);
+    Color color_end = GetRandom(def.color.end);
+
+    int index = chunk->count++;
+    float (&s)[VFX_STREAM_COUNT][VFX_CHUNK_SIZE] = chunk->streams;
+    s[VFX_STREAM_POSITION_X][index] = position.x;
+    s[VFX_STREAM_POSITION_Y][index] = position.y;
+    s[VFX_STREAM_VELOCITY_X][index] = dir.x * speed_start;
+    s[VFX_STREAM_VELOCITY_Y][index] = dir.y * speed_start;
+    s[VFX_STREAM_GRAVITY_X][index] = gravity.x;
+    s[VFX_STREAM_GRAVITY_Y][index] = gravity.y;
+    s[VFX_STREAM_DRAG][index] = GetRandom(def.drag);
+    s[VFX_STREAM_ELAPSED][index] = 0.0f;
+    s[VFX_STREAM_LIFETIME][index] = GetRandom(def.duration);
+    s[VFX_STREAM_SPEED_START][index] = speed_start;
+    s[VFX_STREAM_SPEED_END][index] = GetRandom(def.speed.end);
+    s[VFX_STREAM_SIZE_START][index] = GetRandom(def.size.start);
+    s[VFX_STREAM_SIZE_END][index] = GetRandom(def.size.end);
+    s[VFX_STREAM_OPACITY_START][index] = GetRandom(def.opacity.start);
+    s[VFX_STREAM_OPACITY_END][index] = GetRandom(def.opacity.end);
+    s[VFX_STREAM_ROTATION_START][index] = rotation_start;
+    s[VFX_STREAM_ROTATION_END][index] = rotation_start + Radians(GetRandom(def.rotation.end));
+    s[VFX_STREAM_COLOR_START_R][index] = color_start.r;
+    s[VFX_STREAM_COLOR_START_G][index] = color_start.g;
+    s[VFX_STREAM_COLOR_START_B][index] = color_start.b;
+    s[VFX_STREAM_COLOR_END_R][index] = color_end.r;
+    s[VFX_STREAM_COLOR_END_G][index] = color_end.g;
+    s[VFX_STREAM_COLOR_END_B][index] = color_end.b;
+
     e->particle_count++;
+    g_vfx.particle_count++;
+    g_vfx.stats.emitted_count++;
+    return true;
+}
+
+// @budget
+// Emission is thinned for instances far outside the last camera view and as the live particle
+// count approaches the budget.  Low priority instances start thinning at half the budget and
+// normal ones at three quarters, high priority instances are only limited by capacity.
+static float GetEmissionScale(VfxInstance* instance) {
+    if (instance->priority == VFX_PRIORITY_HIGH)
+        return 1.0f;
+
+    float scale = 1.0f;
+    if (g_vfx.has_view) {
+        Vec2 position = TransformPoint(instance->transform);
+        Vec2 nearest = Max(g_vfx.view_bounds.min, Min(g_vfx.view_bounds.max, position));
+        Vec2 view_size = GetSize(g_vfx.view_bounds);
+        float fade_distance = Max(view_size.x, view_size.y) * 0.5f;
+        if (fade_distance > F32_EPSILON)
+            scale = Clamp01(1.0f - Distance(position, nearest) / fade_distance);
+    }
 
-    return p;
+    if (g_vfx.particle_budget > 0) {
+        float headroom = 1.0f - static_cast<float>(g_vfx.particle_count) / static_cast<float>(g_vfx.particle_budget);
+        float thin_start = instance->priority == VFX_PRIORITY_LOW ? 0.5f : 0.25f;
+        scale *= Clamp01(headroom / thin_start);
+    }
+
+    return scale;
 }
 
-static void UpdateParticles() {
-    if (IsEmpty(g_vfx.particle_pool))
-        return;
+// @update
+static void SimulateChunk(VfxChunk* chunk, VfxCurveType speed_curve, float dt) {
+    float (&s)[VFX_STREAM_COUNT][VFX_CHUNK_SIZE] = chunk->streams;
+    f32x4 zero = Set4(0.0f);
+    f32x4 one = Set4(1.0f);
+    f32x4 dt4 = Set4(dt);
+
+    for (int i=0; i<chunk->count; i+=4) {
+        f32x4 elapsed = Add4(Load4(s[VFX_STREAM_ELAPSED] + i), dt4);
+        Store4(s[VFX_STREAM_ELAPSED] + i, elapsed);
+
+        f32x4 t = Max4(zero, Min4(one, Div4(elapsed, Load4(s[VFX_STREAM_LIFETIME] + i))));
+        f32x4 speed = Mix4(
+            Load4(s[VFX_STREAM_SPEED_START] + i),
+            Load4(s[VFX_STREAM_SPEED_END] + i),
+            EvaluateCurve4(speed_curve, t));
+
+        // Keep the direction of the velocity but reset its length to the curve speed
+        f32x4 vx = Load4(s[VFX_STREAM_VELOCITY_X] + i);
+        f32x4 vy = Load4(s[VFX_STREAM_VELOCITY_Y] + i);
+        f32x4 length = Sqrt4(Add4(Mul4(vx, vx), Mul4(vy, vy)));
+        f32x4 scale = Select4(zero, Div4(speed, length), Greater4(length, zero));
+        f32x4 damping = Sub4(one, Mul4(Load4(s[VFX_STREAM_DRAG] + i), dt4));
+        vx = Mul4(Add4(Mul4(vx, scale), Mul4(Load4(s[VFX_STREAM_GRAVITY_X] + i), dt4)), damping);
+        vy = Mul4(Add4(Mul4(vy, scale), Mul4(Load4(s[VFX_STREAM_GRAVITY_Y] + i), dt4)), damping);
+
+        Store4(s[VFX_STREAM_VELOCITY_X] + i, vx);
+        Store4(s[VFX_STREAM_VELOCITY_Y] + i, vy);
+        Store4(s[VFX_STREAM_POSITION_X] + i, Add4(Load4(s[VFX_STREAM_POSITION_X] + i), Mul4(vx, dt4)));
+        Store4(s[VFX_STREAM_POSITION_Y] + i, Add4(Load4(s[VFX_STREAM_POSITION_Y] + i), Mul4(vy, dt4)));
+    }
+}
 
-    float dt = GetFrameTime();
+static void UpdateParticles(VfxEmitter* e, float dt) {
+    for (VfxChunk* chunk = e->first_chunk; chunk; chunk = chunk->next)
+        SimulateChunk(chunk, e->def->particle_def.speed.type, dt);
+
+    // Walk backwards so the particles moved into holes have already been checked
+    for (VfxChunk* chunk = e->last_chunk; chunk; ) {
+        VfxChunk* prev = chunk->prev;
+        for (int i=chunk->count - 1; i>=0; i--)
+            if (chunk->streams[VFX_STREAM_ELAPSED][i] >= chunk->streams[VFX_STREAM_LIFETIME][i])
+                RemoveParticle(e, chunk, i);
+        chunk = prev;
+    }
+}
 
-    for (u32 i = 0; i < MAX_PARTICLES; ++i) {
-        if (!g_vfx.particle_valid[i])
-            continue;
+// @draw
+static void FlushParticles(Mesh* mesh, int& count) {
+    if (count == 0)
+        return;
 
-        VfxParticle* p = GetParticle(i);
-        p->elapsed += dt;
+    DrawMeshInstanced(mesh, g_vfx.draw_instances, count);
+    count = 0;
+}
 
-        if (p->elapsed >= p->lifetime) {
-            Free(p);
-            continue;
+static void DrawParticles(VfxEmitter* e, VfxInstance* instance) {
+    const VfxParticleDef& def = e->def->particle_def;
+    Mesh* mesh = def.mesh ? def.mesh : g_vfx.meshes[VFX_MESH_SQUARE];
+
+    BindDepth(instance->depth);
+    BindMaterial(g_vfx.material);
+
+    f32x4 zero = Set4(0.0f);
+    f32x4 one = Set4(1.0f);
+    float size[VFX_CHUNK_SIZE];
+    float opacity[VFX_CHUNK_SIZE];
+    float rotation[VFX_CHUNK_SIZE];
+    float color[3][VFX_CHUNK_SIZE];
+
+    int draw_count = 0;
+    for (VfxChunk* chunk = e->first_chunk; chunk; chunk = chunk->next) {
+        float (&s)[VFX_STREAM_COUNT][VFX_CHUNK_SIZE] = chunk->streams;
+        for (int i=0; i<chunk->count; i+=4) {
+            f32x4 t = Max4(zero, Min4(one, Div4(Load4(s[VFX_STREAM_ELAPSED] + i), Load4(s[VFX_STREAM_LIFETIME] + i))));
+            Store4(size + i, Mix4(Load4(s[VFX_STREAM_SIZE_START] + i), Load4(s[VFX_STREAM_SIZE_END] + i), EvaluateCurve4(def.size.type, t)));
+            Store4(opacity + i, Mix4(Load4(s[VFX_STREAM_OPACITY_START] + i), Load4(s[VFX_STREAM_OPACITY_END] + i), EvaluateCurve4(def.opacity.type, t)));
+            Store4(rotation + i, Mix4(Load4(s[VFX_STREAM_ROTATION_START] + i), Load4(s[VFX_STREAM_ROTATION_END] + i), EvaluateCurve4(def.rotation.type, t)));
+
+            f32x4 color_t = EvaluateCurve4(def.color.type, t);
+            for (int c=0; c<3; c++)
+                Store4(color[c] + i, Mix4(Load4(s[VFX_STREAM_COLOR_START_R + c] + i), Load4(s[VFX_STREAM_COLOR_END_R + c] + i), color_t));
         }
 
-        f32 t = p->elapsed / p->lifetime;
-        f32 curve_t = EvaluateCurve(p->speed_curve, t);
-        f32 current_speed = Mix(p->speed_start, p->speed_end, curve_t);
-
-        Vec2 vel = Normalize(p->velocity) * current_speed;
-        vel += p->gravity * dt;
-        vel *= (1.0f - p->drag * dt);
+        for (int i=0; i<chunk->count; i++) {
+            Vec2 position = { s[VFX_STREAM_POSITION_X][i], s[VFX_STREAM_POSITION_Y][i] };
+            Vec2 direction = { Cos(rotation[i]), Sin(rotation[i]) };
+            g_vfx.draw_instances[draw_count++] = {
+                .transform = instance->transform * TRS(position, direction, {size[i], size[i]}),
+                .color = { color[0][i], color[1][i], color[2][i], opacity[i] },
+                .emission = COLOR_TRANSPARENT,
+                .color_offset = VEC2INT_ZERO,
+                .depth = instance->depth,
+            };
+        }
 
-        p->position += vel * dt;
-        p->velocity = vel;
-        p->rotation = Mix(p->rotation_start, p->rotation_end, EvaluateCurve(p->rotation_curve, t));
+        if (draw_count + VFX_CHUNK_SIZE > VFX_DRAW_BATCH_SIZE)
+            FlushParticles(mesh, draw_count);
     }
 
-    for (int particle_index=0; particle_index<MAX_PARTICLES; particle_index++) {
-        if (!g_vfx.particle_valid[particle_index])
+    FlushParticles(mesh, draw_count);
+}
+
+static void DrawParticles() {
+    // Particles keep simulating off screen, but instances whose bounds miss the camera skip
+    // building their draws entirely.
+    for (u32 i=0; i<g_vfx.max_instances; i++) {
+        if (!g_vfx.instance_valid[i])
             continue;
 
-        VfxParticle* p = GetParticle(particle_index);
-        assert(p);
+        VfxInstance* instance = GetInstance(i);
+        instance->visible = IsVisible(TransformBounds(instance->transform, static_cast<VfxImpl*>(instance->vfx)->bounds));
+    }
 
-        VfxEmitter* e = GetEmitter(p->emitter_index);
-        assert(e);
+    int culled_count = 0;
+    for (u32 i=0; i<g_vfx.max_emitters; i++) {
+        if (!g_vfx.emitter_valid[i])
+            continue;
 
-        VfxInstance* i = GetInstance(e);
-        assert(i);
+        VfxEmitter* e = GetEmitter(i);
+        if (e->particle_count == 0)
+            continue;
+
+        VfxInstance* instance = GetInstance(e);
+        assert(instance);
 
-        float t = p->elapsed / p->lifetime;
-        float size = Mix(p->size_start, p->size_end, EvaluateCurve(p->size_curve, t));
-        float opacity = Mix(p->opacity_start, p->opacity_end, EvaluateCurve(p->opacity_curve, t));
-        Color col = Mix(p->color_start, p->color_end, EvaluateCurve(p->color_curve, t));
+        if (!instance->visible) {
+            culled_count += e->particle_count;
+            continue;
+        }
 
-        BindDepth(i->depth);
-        BindTransform(i->transform * TRS(p->position, Degrees(p->rotation), {size, size}));
-        BindColor(SetAlpha(col, opacity));
-        BindMaterial(g_vfx.material);
-        DrawMesh(p->mesh);
+        DrawParticles(e, instance);
     }
+
+    AddCulledDraws(culled_count);
 }
 
 static void EmitterDestructor(void* ptr)
 {
     VfxEmitter* e = static_cast<VfxEmitter*>(ptr);
     assert(e);
-    assert(e->particle_count == 0);
+
+    while (e->last_chunk)
+        RemoveLastChunk(e);
+
+    g_vfx.particle_count -= e->particle_count;
+    e->particle_count = 0;
+
     VfxInstance* i = GetInstance(e);
     assert(i);
     i->emitter_count--;
@@ -318,6 +515,9 @@ static VfxEmitter* CreateEmitter(VfxInstance* instance, const VfxEmitterDef& def
     e->duration = GetRandom(def.duration);
     e->accumulator = 0.0f;
     e->instance_index = GetIndex(instance);
+    e->particle_count = 0;
+    e->first_chunk = nullptr;
+    e->last_chunk = nullptr;
 
     int rate = RandomInt(def.rate.min, def.rate.max);
     e->rate = rate > 0
@@ -335,24 +535,34 @@ static void UpdateEmitters() {
     if (IsEmpty(g_vfx.emitter_pool))
         return;
 
+    for (u32 i=0; i<g_vfx.max_instances; i++)
+        if (g_vfx.instance_valid[i])
+            GetInstance(i)->emission_scale = GetEmissionScale(GetInstance(i));
+
     float dt = GetFrameTime();
-    for (u32 i=0; i<MAX_EMITTERS; i++) {
+    for (u32 i=0; i<g_vfx.max_emitters; i++) {
         if (!g_vfx.emitter_valid[i])
             continue;
 
-        VfxEmitter* e = GetEmitter(i);;
-        if (e->rate <= 0.0000001f || e->elapsed >= e->duration) {
-            if (e->particle_count == 0)
-                Free(e);
+        VfxEmitter* e = GetEmitter(i);
+        bool emitting = e->rate > 0.0000001f && e->elapsed < e->duration;
+        if (!emitting && e->particle_count == 0) {
+            Free(e);
             continue;
         }
 
-        e->accumulator += dt;
+        if (emitting) {
+            float scale = GetInstance(e)->emission_scale;
+            e->accumulator += dt * scale;
+            g_vfx.thinned += dt * (1.0f - scale) / e->rate;
 
-        while (e->accumulator >= e->rate) {
-            EmitParticle(e);
-            e->accumulator -= e->rate;
+            while (e->accumulator >= e->rate) {
+                EmitParticle(e);
+                e->accumulator -= e->rate;
+            }
         }
+
+        UpdateParticles(e, dt);
     }
 }
 
@@ -362,7 +572,10 @@ void Stop(const VfxHandle& handle) {
         return;
 
     // Stop all the emitters but let existing particles live out their lifetime
-    for (u32 i = 0; i < MAX_EMITTERS; ++i) {
+    for (u32 i = 0; i < g_vfx.max_emitters; ++i) {
+        if (!g_vfx.emitter_valid[i])
+            continue;
+
         VfxEmitter* e = GetEmitter(i);
         if (e->instance_index == GetIndex(instance))
             e->rate = 0.0f;
@@ -378,25 +591,8 @@ void Destroy(VfxHandle& handle) {
 
     Stop(handle);
 
-    // Free any particles associated with the instance
-    for (u32 i = 0; i < MAX_PARTICLES; ++i) {
-        if (!g_vfx.particle_valid[i])
-            continue;
-
-        VfxParticle* p = GetParticle(i);
-        assert(p);
-
-        VfxEmitter* e = GetEmitter(i);
-        assert(e);
-
-        if (e->instance_index != index)
-            continue;
-
-        Free(p);
-    }
-
-    // Free any emitters associated with the instance
-    for (u32 i = 0; i < MAX_EMITTERS; ++i) {
+    // Free the emitters associated with the instance, which frees their particles
+    for (u32 i = 0; i < g_vfx.max_emitters; ++i) {
         if (!g_vfx.emitter_valid[i])
             continue;
 
@@ -413,11 +609,25 @@ void Destroy(VfxHandle& handle) {
 // @draw
 void DrawVfx()
 {
+    g_vfx.has_view = GetCullBounds(&g_vfx.view_bounds);
+
     UpdateEmitters();
-    UpdateParticles();
+    DrawParticles();
+
+    g_vfx.stats.particle_count = (int)g_vfx.particle_count;
+    g_vfx.stats.emitter_count = (int)GetCount(g_vfx.emitter_pool);
+    g_vfx.stats.instance_count = (int)GetCount(g_vfx.instance_pool);
+    g_vfx.stats.thinned_count += (int)g_vfx.thinned;
+    g_vfx.last_stats = g_vfx.stats;
+    g_vfx.stats = {};
+    g_vfx.thinned -= (int)g_vfx.thinned;
 }
 
-VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth) {
+const VfxStats& GetVfxStats() {
+    return g_vfx.last_stats;
+}
+
+VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth, VfxPriority priority) {
     VfxImpl* impl = static_cast<VfxImpl*>(vfx);
     assert(impl);
 
@@ -425,11 +635,16 @@ VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth) {
     if (!instance)
         return INVALID_VFX_HANDLE;
 
+    instance->priority = priority;
+    instance->emission_scale = GetEmissionScale(instance);
+
     for (u32 i=0, c=impl->emitter_count; i<c; i++) {
         VfxEmitter* e = CreateEmitter(instance, impl->emitters[i]);
         if (!e) break;
 
-        i32 burst_count = GetRandom(e->def->burst);
+        i32 burst_max = GetRandom(e->def->burst);
+        i32 burst_count = static_cast<i32>(static_cast<float>(burst_max) * instance->emission_scale + 0.5f);
+        g_vfx.stats.thinned_count += burst_max - burst_count;
         for (i32 b = 0; b < burst_count; ++b)
             EmitParticle(e);
     }
@@ -437,8 +652,8 @@ VfxHandle Play(Vfx* vfx, const Mat3& transform, float depth) {
     return GetHandle(instance);
 }
 
-VfxHandle Play(Vfx* vfx, const Vec2& position, float depth) {
-    return Play(vfx, Translate(position), depth);
+VfxHandle Play(Vfx* vfx, const Vec2& position, float depth, VfxPriority priority) {
+    return Play(vfx, Translate(position), depth, priority);
 }
 
 bool IsPlaying(const VfxHandle& handle)
@@ -449,15 +664,11 @@ bool IsPlaying(const VfxHandle& handle)
 
 void ClearVfx()
 {
-    for (u32 i=0; i<MAX_PARTICLES; i++)
-        if (g_vfx.particle_valid[i])
-            Free(GetAt(g_vfx.particle_pool, i));
-
-    for (u32 i=0; i<MAX_EMITTERS; i++)
+    for (u32 i=0; i<g_vfx.max_emitters; i++)
         if (g_vfx.emitter_valid[i])
             Free(GetAt(g_vfx.emitter_pool, i));
 
-    for (u32 i=0; i<MAX_INSTANCES; i++)
+    for (u32 i=0; i<g_vfx.max_instances; i++)
         if (g_vfx.instance_valid[i])
             Free(GetAt(g_vfx.instance_pool, i));
 }
@@ -467,18 +678,28 @@ void SetVfxPaletteTexture(Texture* texture) {
     SetTexture(g_vfx.material, texture);
 }
 
-void InitVfx() {
-    g_vfx.emitter_pool = CreatePoolAllocator(sizeof(VfxEmitter), MAX_EMITTERS);
-    g_vfx.instance_pool = CreatePoolAllocator(sizeof(VfxInstance), MAX_INSTANCES);
-    g_vfx.particle_pool = CreatePoolAllocator(sizeof(VfxParticle), MAX_PARTICLES);
+void InitVfx(const ApplicationTraits* traits) {
+    assert(traits->vfx.max_emitters <= U16_MAX && traits->vfx.max_instances <= U16_MAX);
+    g_vfx.max_particles = traits->vfx.max_particles;
+    g_vfx.max_emitters = traits->vfx.max_emitters;
+    g_vfx.max_instances = traits->vfx.max_instances;
+    g_vfx.particle_budget = traits->vfx.particle_budget;
+
+    g_vfx.emitter_valid = static_cast<bool*>(Alloc(ALLOCATOR_DEFAULT, sizeof(bool) * g_vfx.max_emitters));
+    g_vfx.instance_valid = static_cast<bool*>(Alloc(ALLOCATOR_DEFAULT, sizeof(bool) * g_vfx.max_instances));
+    g_vfx.emitter_pool = CreatePoolAllocator(sizeof(VfxEmitter), g_vfx.max_emitters);
+    g_vfx.instance_pool = CreatePoolAllocator(sizeof(VfxInstance), g_vfx.max_instances);
+
+    // Every emitter can hold one partially filled chunk on top of the full ones
+    u32 max_chunks = (g_vfx.max_particles + VFX_CHUNK_SIZE - 1) / VFX_CHUNK_SIZE + g_vfx.max_emitters;
+    g_vfx.chunk_pool = CreatePoolAllocator(sizeof(VfxChunk), max_chunks);
 
-    for (u32 i=0; i<MAX_PARTICLES; i++)
-        g_vfx.particle_valid[i] = false;
+    g_vfx.draw_instances = static_cast<InstanceData*>(Alloc(ALLOCATOR_DEFAULT, sizeof(InstanceData) * VFX_DRAW_BATCH_SIZE));
 
-    for (u32 i=0; i<MAX_EMITTERS; i++)
+    for (u32 i=0; i<g_vfx.max_emitters; i++)
         g_vfx.emitter_valid[i] = false;
 
-    for (u32 i=0; i<MAX_INSTANCES; i++)
+    for (u32 i=0; i<g_vfx.max_instances; i++)
         g_vfx.instance_valid[i] = false;
 
     g_vfx.material = CreateMaterial(ALLOCATOR_DEFAULT, SHADER_VFX);
@@ -495,7 +716,10 @@ void ShutdownVfx()
 {
     Destroy(g_vfx.emitter_pool);
     Destroy(g_vfx.instance_pool);
-    Destroy(g_vfx.particle_pool);
+    Destroy(g_vfx.chunk_pool);
+    Free(g_vfx.draw_instances);
+    Free(g_vfx.emitter_valid);
+    Free(g_vfx.instance_valid);
 
     g_vfx = {};
 }
@@ -503,7 +727,7 @@ void ShutdownVfx()
 #if !defined(NOZ_BUILTIN_ASSETS)
 void RestartVfx(Vfx* vfx)
 {
-    for (u32 i=0; i<MAX_EMITTERS; i++)
+    for (u32 i=0; i<g_vfx.max_emitters; i++)
     {
         if (!g_vfx.emitter_valid[i])
             continue;
@@ -529,9 +753,11 @@ void RestartVfx(Vfx* vfx)
             continue;
 
         Mat3 transform = instance->transform;
+        float depth = instance->depth;
+        VfxPriority priority = instance->priority;
         Stop(GetHandle(instance));
 
-        Play(vfx, transform);
+        Play(vfx, transform, depth, priority);
     }
 }
 #endif
\ No newline at end of file
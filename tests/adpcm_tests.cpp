@@ -0,0 +1,110 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+#include "../editor/src/utils/adpcm_encode.h"
+#include <vector>
+
+// Decodes a sound's worth of channel blocks back into interleaved frames, the same layout
+// LoadSound and the music stream read
+static std::vector<i16> DecodeFrames(const std::vector<u8>& encoded, u32 frame_count, u32 channels)
+{
+    std::vector<i16> frames(frame_count * channels);
+    for (u32 first = 0; first < frame_count; first += SOUND_ADPCM_BLOCK_FRAMES)
+    {
+        const u8* blocks = encoded.data() + first / SOUND_ADPCM_BLOCK_FRAMES * channels * SOUND_ADPCM_BLOCK_SIZE;
+        u32 count = Min(SOUND_ADPCM_BLOCK_FRAMES, frame_count - first);
+        for (u32 c = 0; c < channels; c++)
+            DecodeAdpcmBlock(blocks + c * SOUND_ADPCM_BLOCK_SIZE, count, frames.data() + first * channels + c, channels);
+    }
+
+    return frames;
+}
+
+static i16 Tone(u32 frame, float frequency, float amplitude)
+{
+    return static_cast<i16>(sinf(frame * frequency * noz::TWO_PI / 44100.0f) * amplitude);
+}
+
+static i32 GetMaxError(const std::vector<i16>& a, const std::vector<i16>& b)
+{
+    i32 max_error = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        max_error = Max(max_error, Abs(static_cast<i32>(a[i]) - static_cast<i32>(b[i])));
+    return max_error;
+}
+
+TEST(AdpcmEncodedSize)
+{
+    EXPECT(GetAdpcmEncodedSize(0) == 0);
+    EXPECT(GetAdpcmEncodedSize(1) == SOUND_ADPCM_BLOCK_SIZE);
+    EXPECT(GetAdpcmEncodedSize(SOUND_ADPCM_BLOCK_FRAMES) == SOUND_ADPCM_BLOCK_SIZE);
+    EXPECT(GetAdpcmEncodedSize(SOUND_ADPCM_BLOCK_FRAMES + 1) == SOUND_ADPCM_BLOCK_SIZE * 2);
+    EXPECT(GetAdpcmEncodedSize(SOUND_ADPCM_BLOCK_FRAMES + 1, 2) == SOUND_ADPCM_BLOCK_SIZE * 4);
+}
+
+// Several full blocks and a partial one, each block opens on its exact first sample
+TEST(AdpcmRoundTripMono)
+{
+    u32 frame_count = SOUND_ADPCM_BLOCK_FRAMES * 3 + 100;
+    std::vector<i16> samples(frame_count);
+    for (u32 i = 0; i < frame_count; i++)
+        samples[i] = Tone(i, 440.0f, 12000.0f);
+
+    std::vector<u8> encoded(GetAdpcmEncodedSize(frame_count));
+    EncodeAdpcm(samples.data(), frame_count, encoded.data());
+    std::vector<i16> decoded = DecodeFrames(encoded, frame_count, 1);
+
+    for (u32 first = 0; first < frame_count; first += SOUND_ADPCM_BLOCK_FRAMES)
+        EXPECT(decoded[first] == samples[first]);
+
+    EXPECT(GetMaxError(samples, decoded) < 512);
+}
+
+// Channels carrying unrelated signals must come back apart rather than folded together
+TEST(AdpcmRoundTripStereo)
+{
+    u32 frame_count = SOUND_ADPCM_BLOCK_FRAMES * 2 + 17;
+    std::vector<i16> samples(frame_count * 2);
+    std::vector<i16> left(frame_count);
+    std::vector<i16> right(frame_count);
+    for (u32 i = 0; i < frame_count; i++)
+    {
+        left[i] = samples[i * 2] = Tone(i, 220.0f, 16000.0f);
+        right[i] = samples[i * 2 + 1] = Tone(i, 330.0f, -8000.0f);
+    }
+
+    std::vector<u8> encoded(GetAdpcmEncodedSize(frame_count, 2));
+    EncodeAdpcm(samples.data(), frame_count, encoded.data(), 2);
+    std::vector<i16> decoded = DecodeFrames(encoded, frame_count, 2);
+
+    std::vector<i16> decoded_left(frame_count);
+    std::vector<i16> decoded_right(frame_count);
+    for (u32 i = 0; i < frame_count; i++)
+    {
+        decoded_left[i] = decoded[i * 2];
+        decoded_right[i] = decoded[i * 2 + 1];
+    }
+
+    EXPECT(GetMaxError(left, decoded_left) < 512);
+    EXPECT(GetMaxError(right, decoded_right) < 512);
+}
+
+// A full scale square wave pins the step index at its limits and must still clamp cleanly
+TEST(AdpcmRoundTripSquare)
+{
+    u32 frame_count = SOUND_ADPCM_BLOCK_FRAMES;
+    std::vector<i16> samples(frame_count);
+    for (u32 i = 0; i < frame_count; i++)
+        samples[i] = (i / 50) & 1 ? -32768 : 32767;
+
+    std::vector<u8> encoded(GetAdpcmEncodedSize(frame_count));
+    EncodeAdpcm(samples.data(), frame_count, encoded.data());
+    std::vector<i16> decoded = DecodeFrames(encoded, frame_count, 1);
+
+    // Allow the attack after each edge, the level it settles on must match
+    for (u32 i = 0; i < frame_count; i++)
+        if (i % 50 >= 20)
+            EXPECT(Abs(static_cast<i32>(samples[i]) - static_cast<i32>(decoded[i])) < 2048);
+}
@@ -0,0 +1,81 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+#include <random>
+#include <vector>
+
+static bool RoundTrip(const std::vector<u8>& src)
+{
+    u32 size = static_cast<u32>(src.size());
+    std::vector<u8> compressed(GetMaxCompressedSize(size));
+    u32 compressed_size = Compress(src.data(), size, compressed.data(), static_cast<u32>(compressed.size()));
+    if (compressed_size == COMPRESS_FAILED || compressed_size > compressed.size())
+        return false;
+
+    std::vector<u8> decompressed(size + 1);
+    return Decompress(compressed.data(), compressed_size, decompressed.data(), size) &&
+        memcmp(decompressed.data(), src.data(), size) == 0;
+}
+
+TEST(CompressEmptyInput)
+{
+    u8 dst[16];
+    EXPECT(Compress(nullptr, 0, dst, sizeof(dst)) == 0);
+    EXPECT(Decompress(dst, 0, nullptr, 0));
+    EXPECT(RoundTrip({}));
+}
+
+// Random bytes, short repeats, a tiny alphabet and overlapping back references, at sizes
+// around the token nibble and 255 byte length continuations
+TEST(CompressRoundTrip)
+{
+    std::mt19937 rng(1);
+    for (u32 size : {1u, 3u, 4u, 5u, 15u, 16u, 19u, 270u, 271u, 4096u, 65536u, 70000u, 200000u})
+    {
+        for (int mode=0; mode<4; mode++)
+        {
+            std::vector<u8> src(size);
+            for (u32 i=0; i<size; i++)
+            {
+                switch (mode)
+                {
+                case 0: src[i] = static_cast<u8>(rng()); break;
+                case 1: src[i] = static_cast<u8>(i % 7); break;
+                case 2: src[i] = static_cast<u8>(rng() % 4); break;
+                default: src[i] = i > 3 && rng() % 8 ? src[i - 1 - rng() % 3] : static_cast<u8>(rng()); break;
+                }
+            }
+
+            EXPECT(RoundTrip(src));
+        }
+    }
+}
+
+TEST(CompressFailsWhenOutputDoesNotFit)
+{
+    std::mt19937 rng(2);
+    std::vector<u8> src(1024);
+    for (u8& value : src)
+        value = static_cast<u8>(rng());
+
+    std::vector<u8> dst(src.size() / 2);
+    EXPECT(Compress(src.data(), static_cast<u32>(src.size()), dst.data(), static_cast<u32>(dst.size())) == COMPRESS_FAILED);
+}
+
+TEST(DecompressRejectsCorruptInput)
+{
+    std::vector<u8> src(4096);
+    for (u32 i=0; i<src.size(); i++)
+        src[i] = static_cast<u8>(i % 13);
+
+    std::vector<u8> compressed(GetMaxCompressedSize(static_cast<u32>(src.size())));
+    u32 compressed_size = Compress(src.data(), static_cast<u32>(src.size()), compressed.data(), static_cast<u32>(compressed.size()));
+    EXPECT(compressed_size != COMPRESS_FAILED);
+
+    // Wrong output size and truncated input must fail rather than overrun
+    std::vector<u8> decompressed(src.size());
+    EXPECT(!Decompress(compressed.data(), compressed_size, decompressed.data(), static_cast<u32>(src.size()) - 1));
+    EXPECT(!Decompress(compressed.data(), compressed_size - 1, decompressed.data(), static_cast<u32>(src.size())));
+}
@@ -0,0 +1,114 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+struct TestMap
+{
+    std::vector<u64> keys;
+    std::vector<int> values;
+    std::vector<u8> ctrl;
+    Map map;
+
+    explicit TestMap(size_t capacity) : keys(capacity), values(capacity), ctrl(GetMapCtrlSize(capacity))
+    {
+        Init(map, keys.data(), values.data(), ctrl.data(), capacity, sizeof(int));
+    }
+};
+
+// Random set, remove and get against std::unordered_map across capacities small enough to
+// wrap probe groups and hit the full table
+TEST(MapMatchesReferenceUnderChurn)
+{
+    for (size_t capacity : {1u, 2u, 4u, 8u, 16u, 32u, 64u, 1024u})
+    {
+        TestMap test(capacity);
+        std::unordered_map<u64, int> reference;
+        std::mt19937_64 rng(capacity);
+
+        for (int i=0; i<100000; i++)
+        {
+            u64 key = rng() % (capacity * 2 + 3);
+            int value = (int)rng();
+            switch (rng() % 3)
+            {
+            case 0:
+                if (SetValue(test.map, key, &value))
+                    reference[key] = value;
+                else
+                    EXPECT(reference.size() == capacity && !reference.contains(key));
+                break;
+
+            case 1:
+                EXPECT(RemoveKey(test.map, key) == (reference.erase(key) == 1));
+                break;
+
+            default:
+            {
+                int* found = (int*)GetValue(test.map, key);
+                auto it = reference.find(key);
+                EXPECT((found != nullptr) == (it != reference.end()));
+                EXPECT(!found || *found == it->second);
+                break;
+            }
+            }
+
+            EXPECT(test.map.count == reference.size());
+            EXPECT(test.map.count + test.map.deleted <= capacity);
+        }
+
+        for (auto& [key, value] : reference)
+        {
+            int* found = (int*)GetValue(test.map, key);
+            EXPECT(found && *found == value);
+        }
+    }
+}
+
+// Replacing every key of a three quarter full map with a fresh one, over and over, must keep
+// empty slots around so misses terminate early instead of scanning tombstones
+TEST(MapReclaimsTombstones)
+{
+    constexpr size_t capacity = 8192;
+    constexpr int live_count = 6144;
+
+    TestMap test(capacity);
+    std::vector<u64> live(live_count);
+    u64 next_key = 1;
+    for (int i=0; i<live_count; i++)
+    {
+        int value = (int)next_key;
+        SetValue(test.map, next_key, &value);
+        live[i] = next_key++;
+    }
+
+    size_t min_empty = capacity;
+    for (int round=0; round<64; round++)
+    {
+        for (int i=0; i<live_count; i++)
+        {
+            EXPECT(RemoveKey(test.map, live[i]));
+            int value = (int)next_key;
+            EXPECT(SetValue(test.map, next_key, &value) != nullptr);
+            live[i] = next_key++;
+
+            size_t empty = test.map.capacity - test.map.count - test.map.deleted;
+            min_empty = empty < min_empty ? empty : min_empty;
+        }
+
+        EXPECT(test.map.count == live_count);
+        EXPECT(!HasKey(test.map, next_key + 1000));
+    }
+
+    EXPECT(min_empty >= capacity / 16);
+
+    for (u64 key : live)
+    {
+        int* found = (int*)GetValue(test.map, key);
+        EXPECT(found && *found == (int)key);
+    }
+}
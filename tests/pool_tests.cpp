@@ -0,0 +1,103 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+#include <vector>
+
+struct PoolItem
+{
+    u32 id;
+};
+
+struct PoolEnumerateTest
+{
+    PoolAllocator* pool;
+    std::vector<PoolItem*> items;
+    std::vector<int> visits;
+};
+
+// Frees the visited item, the next one in the same occupancy word and one a word later
+static bool FreeDuringEnumerate(u32 index, void* item, void* user_data)
+{
+    PoolEnumerateTest* test = (PoolEnumerateTest*)user_data;
+    PoolItem* pool_item = (PoolItem*)item;
+
+    EXPECT(IsValid(test->pool, index));
+    EXPECT(GetAt(test->pool, index) == item);
+    EXPECT(test->items[pool_item->id] == pool_item);
+    test->visits[pool_item->id]++;
+
+    u32 id = pool_item->id;
+    if (id % 5 == 0)
+    {
+        for (u32 other : {id + 1, id + 65})
+        {
+            if (other < test->items.size() && test->items[other])
+            {
+                Free(test->items[other]);
+                test->items[other] = nullptr;
+            }
+        }
+    }
+
+    if (id % 3 == 0)
+    {
+        Free(pool_item);
+        test->items[id] = nullptr;
+    }
+
+    return true;
+}
+
+TEST(PoolEnumerateWithFree)
+{
+    for (bool grow : {false, true})
+    {
+        constexpr u32 item_count = 300;
+        PoolEnumerateTest test = {};
+        test.pool = CreatePoolAllocator(sizeof(PoolItem), grow ? 100 : item_count, grow);
+        test.items.resize(item_count);
+        test.visits.resize(item_count);
+
+        for (u32 i=0; i<item_count; i++)
+        {
+            test.items[i] = (PoolItem*)Alloc(test.pool, sizeof(PoolItem));
+            test.items[i]->id = i;
+        }
+
+        // Punch holes so enumeration starts from a fragmented free list
+        for (u32 i=7; i<item_count; i+=11)
+        {
+            Free(test.items[i]);
+            test.items[i] = nullptr;
+        }
+
+        std::vector<bool> live_before(item_count);
+        for (u32 i=0; i<item_count; i++)
+            live_before[i] = test.items[i] != nullptr;
+
+        Enumerate(test.pool, FreeDuringEnumerate, &test);
+
+        u32 live_count = 0;
+        for (u32 i=0; i<item_count; i++)
+        {
+            // Items freed by an earlier visit are skipped, everything else is visited once
+            bool freed_by_other = (i % 5 == 1 && live_before[i - 1]) || (i >= 65 && (i - 65) % 5 == 0 && live_before[i - 65]);
+            EXPECT(test.visits[i] <= 1);
+            EXPECT(!live_before[i] ? test.visits[i] == 0 : (test.visits[i] == 1 || freed_by_other));
+            if (test.items[i])
+                live_count++;
+        }
+        EXPECT(GetCount(test.pool) == live_count);
+
+        // Freed slots are reused before the pool grows
+        u32 capacity = GetCapacity(test.pool);
+        for (u32 i=live_count; i<capacity; i++)
+            EXPECT(Alloc(test.pool, sizeof(PoolItem)) != nullptr);
+        EXPECT(GetCapacity(test.pool) == capacity);
+        EXPECT(GetCount(test.pool) == capacity);
+
+        Destroy(test.pool);
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#pragma once
+
+#include <noz/noz.h>
+
+// @test
+// Tests register themselves at static init and run from the headless Main in test_main.cpp.
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+    TestCase* next;
+};
+
+extern void RegisterTest(TestCase* test);
+extern void FailTest(const char* file, int line, const char* expr);
+
+#define TEST(name) \
+    static void name(); \
+    static TestCase name##_test = { #name, name, nullptr }; \
+    static const bool name##_registered = (RegisterTest(&name##_test), true); \
+    static void name()
+
+#define EXPECT(expr) do { if (!(expr)) FailTest(__FILE__, __LINE__, #expr); } while (0)
@@ -0,0 +1,87 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+
+// Core assets normally come from the game's generated asset code
+Shader* SHADER_UI = nullptr;
+Shader* SHADER_UI_IMAGE = nullptr;
+Shader* SHADER_UI_IMAGE_TEXTURE = nullptr;
+Shader* SHADER_TEXT = nullptr;
+Shader* SHADER_VFX = nullptr;
+
+// The null renderer compiles nothing, so a shader with empty sources stands in for each one
+static Shader* LoadTestShader(Allocator* allocator, const char* name)
+{
+    Stream* stream = CreateStream(ALLOCATOR_DEFAULT, 16);
+    WriteU32(stream, 0);
+    WriteU32(stream, 0);
+    WriteU8(stream, 0);
+    SeekBegin(stream, 0);
+
+    AssetHeader header = {};
+    Shader* shader = static_cast<Shader*>(LoadShader(allocator, stream, &header, GetName(name), nullptr));
+    Free(stream);
+    return shader;
+}
+
+static bool LoadTestAssets(Allocator* allocator)
+{
+    SHADER_UI = LoadTestShader(allocator, "ui");
+    SHADER_UI_IMAGE = LoadTestShader(allocator, "ui_image");
+    SHADER_UI_IMAGE_TEXTURE = LoadTestShader(allocator, "ui_image_texture");
+    SHADER_TEXT = LoadTestShader(allocator, "text");
+    SHADER_VFX = LoadTestShader(allocator, "vfx");
+    return true;
+}
+
+static TestCase* g_tests = nullptr;
+static TestCase* g_tests_tail = nullptr;
+static u32 g_test_failures = 0;
+
+void RegisterTest(TestCase* test)
+{
+    if (g_tests_tail)
+        g_tests_tail->next = test;
+    else
+        g_tests = test;
+    g_tests_tail = test;
+}
+
+void FailTest(const char* file, int line, const char* expr)
+{
+    LogError("%s(%d): EXPECT(%s) failed", file, line, expr);
+    g_test_failures++;
+}
+
+void Main()
+{
+    ApplicationTraits traits;
+    Init(traits);
+    traits.title = "noz_tests";
+    traits.load_assets = LoadTestAssets;
+    InitApplication(&traits);
+    InitWindow();
+
+    u32 test_count = 0;
+    u32 failed_count = 0;
+    for (TestCase* test = g_tests; test; test = test->next)
+    {
+        u32 failures = g_test_failures;
+        test->run();
+        test_count++;
+        if (g_test_failures != failures)
+        {
+            LogError("FAILED %s", test->name);
+            failed_count++;
+        }
+        else
+            LogInfo("passed %s", test->name);
+    }
+
+    LogInfo("%u of %u tests passed", test_count - failed_count, test_count);
+
+    ShutdownApplication();
+    exit(failed_count == 0 ? 0 : 1);
+}
@@ -0,0 +1,38 @@
+//
+//  NoZ - Copyright(c) 2026 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr int UI_TEST_EXPANDED_ROWS = 32;
+
+// A row holding one element that changes every frame beside an Expanded subtree that never does.
+// The changing element keeps its width so the Expanded gets the same flex size every frame.
+static void BuildExpandedRow(int frame)
+{
+    BeginUI(1920, 1080);
+    BeginCanvas();
+    BeginRow();
+    Container({ .width = 10.0f, .height = 5.0f + static_cast<float>(frame % 2) });
+    BeginExpanded();
+    BeginColumn({ .id = 1 });
+    for (int i = 0; i < UI_TEST_EXPANDED_ROWS; i++)
+        Container({ .height = 10.0f });
+    EndColumn();
+    EndExpanded();
+    EndRow();
+    EndCanvas();
+    EndUI();
+}
+
+// Both measure passes of the Expanded are restored from the last frame, only the canvas, the
+// row and the changing container are measured again
+TEST(UIReusesExpandedMeasure)
+{
+    for (int frame = 0; frame < 4; frame++)
+        BuildExpandedRow(frame);
+
+    const UIStats& stats = GetUIStats();
+    EXPECT(stats.element_count == UI_TEST_EXPANDED_ROWS + 5);
+    EXPECT(stats.measured_count == 3);
+}